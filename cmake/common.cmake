@@ -193,6 +193,7 @@ MACRO(ADD_PLUGIN PLUGIN_NAME)
     SET(EXTERNAL_BINARY_DEPENDENCIES_DIR)
     SET(EXTERNAL_BINARY_DEPENDENCIES)
     SET(TESTS)
+    SET(TEST_SOURCES)
 
     # Analyse the extra parameters
 
@@ -243,6 +244,8 @@ MACRO(ADD_PLUGIN PLUGIN_NAME)
             SET(TYPE_OF_PARAMETER 11)
         ELSEIF(${PARAMETER} STREQUAL "TESTS")
             SET(TYPE_OF_PARAMETER 12)
+        ELSEIF(${PARAMETER} STREQUAL "TEST_SOURCES")
+            SET(TYPE_OF_PARAMETER 13)
         ELSE()
             # Not one of the headers, so add the parameter to the corresponding
             # set
@@ -271,6 +274,8 @@ MACRO(ADD_PLUGIN PLUGIN_NAME)
                 LIST(APPEND EXTERNAL_BINARY_DEPENDENCIES ${PARAMETER})
             ELSEIF(${TYPE_OF_PARAMETER} EQUAL 12)
                 LIST(APPEND TESTS ${PARAMETER})
+            ELSEIF(${TYPE_OF_PARAMETER} EQUAL 13)
+                LIST(APPEND TEST_SOURCES ${PARAMETER})
             ENDIF()
         ENDIF()
     ENDFOREACH()
@@ -510,13 +515,17 @@ MACRO(ADD_PLUGIN PLUGIN_NAME)
                     ../../../../test/testutils.cpp
 
                     ../../coreinterface.cpp
+                    ../../i18ninterface.cpp
                     ../../interface.cpp
                     ../../plugin.cpp
                     ../../plugininfo.cpp
                     ../../pluginmanager.cpp
+                    ../../solverinterface.cpp
 
                     ${CORE_SOURCES}
 
+                    ${TEST_SOURCES}
+
                     ${TEST_SOURCE_FILE}
                     ${TEST_SOURCES_MOC}
                 )
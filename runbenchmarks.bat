@@ -0,0 +1,18 @@
+@ECHO OFF
+
+TITLE Running OpenCOR's benchmarks...
+
+IF NOT EXIST build\tests\SingleCellSimulationView_benchmark.exe GOTO Information
+
+CD build
+tests\SingleCellSimulationView_benchmark %*
+CD ..
+
+GOTO End
+
+:Information
+
+ECHO OpenCOR's tests must first be built before its benchmarks can be run.
+ECHO.
+
+:End
@@ -4,6 +4,7 @@
 
 #include "common.h"
 #include "mainwindow.h"
+#include "startuptrace.h"
 
 //==============================================================================
 
@@ -66,6 +67,14 @@ int main(int pArgc, char *pArgv[])
     #error Unsupported platform
 #endif
 
+    // Enable our startup trace, if requested
+    // Note: the startup trace option is removed from our arguments since it
+    //       must not be handled as a file name...
+
+    QStringList appArguments = OpenCOR::StartupTrace::instance()->enable(app->arguments());
+
+    OpenCOR::StartupTrace::instance()->begin("Startup");
+
     // Send a message (containing the arguments that were passed to this
     // instance of OpenCOR minus the first argument since it corresponds to the
     // full path to the executable which we are not interested in) to the
@@ -73,20 +82,24 @@ int main(int pArgc, char *pArgv[])
     // 'official' instance of OpenCOR, then just carry on as normal, otherwise
     // exit since we only want one instance of OpenCOR at any given time
 
-    QStringList appArguments = app->arguments();
-
     appArguments.removeFirst();
 
     QString arguments = appArguments.join("|");
 
+    OpenCOR::StartupTrace::instance()->begin("QtSingleApplication messaging");
+
     if (app->isRunning()) {
         app->sendMessage(arguments);
 
+        OpenCOR::StartupTrace::instance()->finish();
+
         delete app;
 
         return 0;
     }
 
+    OpenCOR::StartupTrace::instance()->end();
+
     // Specify where to find non-OpenCOR plugins (only required on Windows)
 
 #ifdef Q_OS_WIN
@@ -102,7 +115,9 @@ int main(int pArgc, char *pArgv[])
 
     // Create the main window
 
-    OpenCOR::MainWindow *win = new OpenCOR::MainWindow(app);
+    OpenCOR::StartupTrace::instance()->begin("MainWindow construction");
+        OpenCOR::MainWindow *win = new OpenCOR::MainWindow(app);
+    OpenCOR::StartupTrace::instance()->end();
 
     // Keep track of the main window (required by QtSingleApplication so that it
     // can do what it's supposed to be doing)
@@ -111,11 +126,19 @@ int main(int pArgc, char *pArgv[])
 
     // Handle the arguments
 
-    win->handleArguments(arguments);
+    OpenCOR::StartupTrace::instance()->begin("Arguments handling");
+        win->handleArguments(arguments);
+    OpenCOR::StartupTrace::instance()->end();
 
     // Show the main window
 
-    win->show();
+    OpenCOR::StartupTrace::instance()->begin("MainWindow showing");
+        win->show();
+    OpenCOR::StartupTrace::instance()->end();
+
+    // We are done with our startup, so print/export its trace, if needed
+
+    OpenCOR::StartupTrace::instance()->finish();
 
     // Execute the application
 
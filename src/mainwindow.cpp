@@ -12,6 +12,7 @@
 #include "pluginmanager.h"
 #include "pluginswindow.h"
 #include "solverinterface.h"
+#include "startuptrace.h"
 #include "utils.h"
 
 //==============================================================================
@@ -86,7 +87,9 @@ MainWindow::MainWindow(SharedTools::QtSingleApplication *pApp) :
     // Create our plugin manager (which will automatically load our various
     // plugins)
 
-    mPluginManager = new PluginManager(PluginInfo::Gui);
+    StartupTrace::instance()->begin("PluginManager construction");
+        mPluginManager = new PluginManager(PluginInfo::Gui);
+    StartupTrace::instance()->end();
 
     // Specify some general docking settings
 
@@ -185,18 +188,24 @@ MainWindow::MainWindow(SharedTools::QtSingleApplication *pApp) :
 
         CoreInterface *coreInterface = qobject_cast<CoreInterface *>(plugin->instance());
 
-        if (coreInterface)
+        if (coreInterface) {
             // Initialise the plugin
 
-            coreInterface->initialize();
+            StartupTrace::instance()->begin(plugin->name()+"::initialize()", plugin->name());
+                coreInterface->initialize();
+            StartupTrace::instance()->end();
+        }
 
         // Back to the GUI interface
 
-        if (guiInterface)
+        if (guiInterface) {
             // Initialise the plugin further (i.e. do things which can only be
             // done by OpenCOR itself)
 
-            initializeGuiPlugin(plugin, guiInterface->guiSettings());
+            StartupTrace::instance()->begin(plugin->name()+" GUI initialisation", plugin->name());
+                initializeGuiPlugin(plugin, guiInterface->guiSettings());
+            StartupTrace::instance()->end();
+        }
     }
 
     // Let our various plugins know that all of them have been initialised
@@ -211,13 +220,18 @@ MainWindow::MainWindow(SharedTools::QtSingleApplication *pApp) :
     foreach (Plugin *plugin, loadedPlugins) {
         CoreInterface *coreInterface = qobject_cast<CoreInterface *>(plugin->instance());
 
-        if (coreInterface)
-            coreInterface->initializationsDone(loadedPlugins);
+        if (coreInterface) {
+            StartupTrace::instance()->begin(plugin->name()+"::initializationsDone()", plugin->name());
+                coreInterface->initializationsDone(loadedPlugins);
+            StartupTrace::instance()->end();
+        }
     }
 
     // Retrieve the user settings from the previous session, if any
 
-    loadSettings();
+    StartupTrace::instance()->begin("Settings loading");
+        loadSettings();
+    StartupTrace::instance()->end();
 
     // Initialise the checked state of our full screen action, since OpenCOR may
     // (re)start in full screen mode
@@ -674,11 +688,15 @@ void MainWindow::loadSettings()
         CoreInterface *coreInterface = qobject_cast<CoreInterface *>(plugin->instance());
 
         if (coreInterface) {
+            StartupTrace::instance()->begin(plugin->name()+"::loadSettings()", plugin->name());
+
             mSettings->beginGroup(SettingsPlugins);
                 mSettings->beginGroup(plugin->name());
                     coreInterface->loadSettings(mSettings);
                 mSettings->endGroup();
             mSettings->endGroup();
+
+            StartupTrace::instance()->end();
         }
     }
 
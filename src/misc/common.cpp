@@ -36,6 +36,10 @@ void usage(QCoreApplication *pApp)
     std::cout << " -h, --help      Display this help information" << std::endl;
     std::cout << " -v, --version   Display OpenCOR version information"
               << std::endl;
+    std::cout << " --startup-trace[=FILE]" << std::endl;
+    std::cout << "                 Print a trace of OpenCOR's startup and, if"
+              << " FILE is provided," << std::endl;
+    std::cout << "                 export it as a Chrome trace" << std::endl;
 }
 
 //==============================================================================
@@ -122,6 +126,14 @@ bool consoleApplication(QCoreApplication *pApp, int *pRes)
     cmdLineOptions.add("version");
     cmdLineOptions.alias("version", "v");
 
+    cmdLineOptions.add("startup-trace");
+    // Note: the startup trace option is registered as not accepting a value,
+    //       so that its value can only be given using the equals form (i.e.
+    //       --startup-trace=<file>). Otherwise, our parameter style means that
+    //       --startup-trace <file> would be accepted here while our GUI
+    //       version would handle <file> as a file to open (see
+    //       StartupTrace::enable())...
+
     // Parse the command line options
 
     cmdLineOptions.parse(pApp->arguments());
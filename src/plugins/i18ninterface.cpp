@@ -14,9 +14,20 @@ namespace OpenCOR {
 
 //==============================================================================
 
+QString I18nInterface::locale() const
+{
+    // Return the plugin's locale
+
+    return mLocale;
+}
+
+//==============================================================================
+
 void I18nInterface::setLocale(const QString &pLocale)
 {
-    // Update the plugin's translator
+    // Keep track of the plugin's locale and update the plugin's translator
+
+    mLocale = pLocale;
 
     qApp->removeTranslator(&mTranslator);
     mTranslator.load(QString(":%1_%2").arg(mPluginName, pLocale));
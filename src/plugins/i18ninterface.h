@@ -22,6 +22,7 @@ namespace OpenCOR {
 class I18nInterface : public Interface
 {
 public:
+    QString locale() const;
     void setLocale(const QString &pLocale);
     void setPluginName(const QString &pPluginName);
 
@@ -29,6 +30,7 @@ public:
 
 private:
     QString mPluginName;
+    QString mLocale;
 
     QTranslator mTranslator;
 };
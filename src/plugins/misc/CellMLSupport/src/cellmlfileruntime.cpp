@@ -9,6 +9,7 @@
 
 //==============================================================================
 
+#include <QCryptographicHash>
 #include <QRegularExpression>
 #include <QStringList>
 
@@ -103,8 +104,10 @@ CellmlFileRuntime::CellmlFileRuntime() :
     mOdeCodeInformation(0),
     mDaeCodeInformation(0),
     mCompilerEngine(0),
+    mCodeHash(QByteArray()),
     mVariableOfIntegration(0),
-    mModelParameters(CellmlFileRuntimeModelParameters())
+    mModelParameters(CellmlFileRuntimeModelParameters()),
+    mNamedModelParameters(QHash<QString, CellmlFileRuntimeModelParameter *>())
 {
     // Reset (initialise, here) our properties
 
@@ -311,6 +314,34 @@ CellmlFileRuntime::ComputeVariablesFunction CellmlFileRuntime::computeVariables(
 
 //==============================================================================
 
+CellmlFileRuntime::ComputeStepsFunction CellmlFileRuntime::computeSteps(const QString &pFunctionName) const
+{
+    // Return the requested computeSteps function, if any
+
+    return mComputeSteps.value(pFunctionName, 0);
+}
+
+//==============================================================================
+
+CellmlFileRuntime::ComputeRatesFunction CellmlFileRuntime::computeSensitivityRates() const
+{
+    // Return the computeSensitivityRates function
+
+    return mComputeSensitivityRates;
+}
+
+//==============================================================================
+
+QByteArray CellmlFileRuntime::codeHash() const
+{
+    // Return the hash of the code that was compiled for our model, or an empty
+    // byte array if no code was (successfully) compiled
+
+    return mCodeHash;
+}
+
+//==============================================================================
+
 CellmlFileIssues CellmlFileRuntime::issues() const
 {
     // Return the issue(s)
@@ -320,7 +351,7 @@ CellmlFileIssues CellmlFileRuntime::issues() const
 
 //==============================================================================
 
-CellmlFileRuntimeModelParameters CellmlFileRuntime::modelParameters() const
+const CellmlFileRuntimeModelParameters & CellmlFileRuntime::modelParameters() const
 {
     // Return the model parameter(s)
 
@@ -329,6 +360,67 @@ CellmlFileRuntimeModelParameters CellmlFileRuntime::modelParameters() const
 
 //==============================================================================
 
+const CellmlFileRuntimeModelParameters & CellmlFileRuntime::modelParameters(const CellmlFileRuntimeModelParameter::ModelParameterType &pType) const
+{
+    // Return the model parameter(s) of the given type, sorted in the same way
+    // as all our model parameters
+
+    static const CellmlFileRuntimeModelParameters NoModelParameters = CellmlFileRuntimeModelParameters();
+
+    if ((pType < CellmlFileRuntimeModelParameter::Voi) || (pType >= CellmlFileRuntimeModelParameter::Undefined))
+        return NoModelParameters;
+    else
+        return mTypedModelParameters[pType];
+}
+
+//==============================================================================
+
+static QString modelParameterKey(const QString &pComponent,
+                                 const QString &pName, const int &pDegree)
+{
+    // Return the key used to look up a model parameter by name
+
+    return pComponent+"|"+pName+"|"+QString::number(pDegree);
+}
+
+//==============================================================================
+
+CellmlFileRuntimeModelParameter * CellmlFileRuntime::modelParameter(const QString &pComponent,
+                                                                    const QString &pName,
+                                                                    const int &pDegree) const
+{
+    // Return the model parameter with the given component, name and degree,
+    // if any
+
+    return mNamedModelParameters.value(modelParameterKey(pComponent, pName, pDegree));
+}
+
+//==============================================================================
+
+void CellmlFileRuntime::indexModelParameters()
+{
+    // Index our (sorted) model parameters by type and by name, so that they
+    // can be looked up in constant time, rather than by going through all of
+    // them and comparing strings
+
+    for (int i = CellmlFileRuntimeModelParameter::Voi; i < CellmlFileRuntimeModelParameter::Undefined; ++i)
+        mTypedModelParameters[i].clear();
+
+    mNamedModelParameters.clear();
+    mNamedModelParameters.reserve(mModelParameters.count());
+
+    foreach (CellmlFileRuntimeModelParameter *modelParameter, mModelParameters) {
+        mTypedModelParameters[modelParameter->type()] << modelParameter;
+
+        mNamedModelParameters.insert(modelParameterKey(modelParameter->component(),
+                                                       modelParameter->name(),
+                                                       modelParameter->degree()),
+                                     modelParameter);
+    }
+}
+
+//==============================================================================
+
 void CellmlFileRuntime::resetOdeCodeInformation()
 {
     // Reset the ODE code information
@@ -364,6 +456,10 @@ void CellmlFileRuntime::resetFunctions()
     mComputeRootInformation = 0;
     mComputeStateInformation = 0;
     mComputeVariables = 0;
+
+    mComputeSteps.clear();
+
+    mComputeSensitivityRates = 0;
 }
 
 //==============================================================================
@@ -386,6 +482,8 @@ void CellmlFileRuntime::reset(const bool &pRecreateCompilerEngine,
     else
         mCompilerEngine = 0;
 
+    mCodeHash = QByteArray();
+
     resetFunctions();
 
     if (pResetIssues)
@@ -399,6 +497,8 @@ void CellmlFileRuntime::reset(const bool &pRecreateCompilerEngine,
         delete modelParameter;
 
     mModelParameters.clear();
+
+    indexModelParameters();
 }
 
 //==============================================================================
@@ -557,6 +657,74 @@ QString CellmlFileRuntime::functionCode(const QString &pFunctionSignature,
 
 //==============================================================================
 
+QString CellmlFileRuntime::computeStepsFunctionCode(const QString &pFunctionName,
+                                                    const QStringList &pArrays,
+                                                    const QString &pStepBody,
+                                                    const bool &pNeedHalfStep)
+{
+    // Generate the code of a function which computes, in one go, all the steps
+    // of a fixed-step ODE solver between VOI and VOIEND
+    // Note #1: the algorithm is the same as the one used by our fixed-step ODE
+    //          solvers, except that it is specialised for the model. Indeed,
+    //          computeRates() is defined in the same module, so it can be
+    //          inlined by the compiler, and the number of states is known, so
+    //          our work arrays can be allocated on the stack and the loops
+    //          over them unrolled and/or vectorised...
+    // Note #2: the 'pointer' to VOI is updated upon return, so that the caller
+    //          knows where we are at, and we return the number of steps we
+    //          took, so that the caller doesn't have to guess it...
+
+    QString res = QString("int %1(double *VOI, double VOIEND, double STEP, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC)\n"
+                          "{\n"
+                          "    double voiStart = *VOI;\n"
+                          "    double voi = voiStart;\n"
+                          "\n"
+                          "    int stepNumber = 0;\n"
+                          "    int stepsCount = 0;\n"
+                          "    double realStep = STEP;\n").arg(pFunctionName);
+
+    if (pNeedHalfStep)
+        res += "    double realHalfStep = 0.5*realStep;\n";
+
+    res += "\n"
+           "    int i;\n";
+
+    foreach (const QString &array, pArrays)
+        res += QString("    double %1[%2];\n").arg(array).arg(statesCount());
+
+    res += "\n"
+           "    while (voi != VOIEND) {\n";
+
+    if (pNeedHalfStep)
+        res += "        if (voi+realStep > VOIEND) {\n"
+               "            realStep = VOIEND-voi;\n"
+               "            realHalfStep = 0.5*realStep;\n"
+               "        }\n";
+    else
+        res += "        if (voi+realStep > VOIEND)\n"
+               "            realStep = VOIEND-voi;\n";
+
+    res += "\n";
+    res += QString(pStepBody).replace("%STATES_COUNT%", QString::number(statesCount()));
+    res += "\n"
+           "        ++stepsCount;\n"
+           "\n"
+           "        if (realStep != STEP)\n"
+           "            voi = VOIEND;\n"
+           "        else\n"
+           "            voi = voiStart+(++stepNumber)*STEP;\n"
+           "    }\n"
+           "\n"
+           "    *VOI = voi;\n"
+           "\n"
+           "    return stepsCount;\n"
+           "}\n";
+
+    return res;
+}
+
+//==============================================================================
+
 bool sortModelParameters(CellmlFileRuntimeModelParameter *pModelParameter1,
                          CellmlFileRuntimeModelParameter *pModelParameter2)
 {
@@ -585,6 +753,24 @@ bool sortModelParameters(CellmlFileRuntimeModelParameter *pModelParameter1,
 
 //==============================================================================
 
+static QString internedString(QHash<QString, QString> &pStrings,
+                              const QString &pString)
+{
+    // Return the interned version of the given string, i.e. the first string
+    // equal to it that we came across
+
+    QHash<QString, QString>::const_iterator iter = pStrings.constFind(pString);
+
+    if (iter != pStrings.constEnd())
+        return iter.value();
+
+    pStrings.insert(pString, pString);
+
+    return pString;
+}
+
+//==============================================================================
+
 CellmlFileRuntime * CellmlFileRuntime::update(CellmlFile *pCellmlFile)
 {
     // Reset the runtime's properties
@@ -640,8 +826,12 @@ CellmlFileRuntime * CellmlFileRuntime::update(CellmlFile *pCellmlFile)
 
     // Retrieve all the model parameters and sort them by component/variable
     // name
+    // Note: component and unit names are shared by many model parameters, so
+    //       we intern them, i.e. all the model parameters that have the same
+    //       component/unit name share the same (implicitly shared) string...
 
     ObjRef<iface::cellml_services::ComputationTargetIterator> computationTargetIterator = genericCodeInformation->iterateTargets();
+    QHash<QString, QString> internedStrings = QHash<QString, QString>();
 
     forever {
         ObjRef<iface::cellml_services::ComputationTarget> computationTarget = computationTargetIterator->nextComputationTarget();
@@ -762,9 +952,14 @@ CellmlFileRuntime * CellmlFileRuntime::update(CellmlFile *pCellmlFile)
 
             // Keep track of the model parameter
 
+            QString unitName = QString::fromStdWString(variable->unitsName());
+
+            componentName = internedString(internedStrings, componentName);
+            unitName = internedString(internedStrings, unitName);
+
             CellmlFileRuntimeModelParameter *modelParameter = new CellmlFileRuntimeModelParameter(QString::fromStdWString(variable->name()),
                                                                                                   computationTarget->degree(),
-                                                                                                  QString::fromStdWString(variable->unitsName()),
+                                                                                                  unitName,
                                                                                                   componentName,
                                                                                                   modelParameterType,
                                                                                                   computationTarget->assignedIndex());
@@ -778,6 +973,8 @@ CellmlFileRuntime * CellmlFileRuntime::update(CellmlFile *pCellmlFile)
 
     qSort(mModelParameters.begin(), mModelParameters.end(), sortModelParameters);
 
+    indexModelParameters();
+
     // Generate the model code, after having prepended to it all the external
     // functions which may, or not, be needed
     // Note: indeed, we cannot include header files since we don't (and don't
@@ -900,6 +1097,171 @@ CellmlFileRuntime * CellmlFileRuntime::update(CellmlFile *pCellmlFile)
     modelCode += functionCode("int computeVariables(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC)",
                               QString::fromStdWString(genericCodeInformation->variablesString()));
 
+    // Generate the functions which compute several steps of our fixed-step ODE
+    // solvers in one go, but only if we have at least one state (since we
+    // can't have zero-sized arrays in C)
+
+    static const QString ForwardEulerSteps = "computeForwardEulerSteps";
+    static const QString HeunSteps = "computeHeunSteps";
+    static const QString MidpointSteps = "computeMidpointSteps";
+    static const QString SecondOrderRungeKuttaSteps = "computeSecondOrderRungeKuttaSteps";
+    static const QString FourthOrderRungeKuttaSteps = "computeFourthOrderRungeKuttaSteps";
+
+    bool hasComputeStepsFunctions = (mModelType == Ode) && statesCount();
+
+    if (hasComputeStepsFunctions) {
+        modelCode += "\n";
+        modelCode += computeStepsFunctionCode(ForwardEulerSteps, QStringList(),
+                                              "        computeRates(voi, CONSTANTS, RATES, STATES, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i)\n"
+                                              "            STATES[i] += realStep*RATES[i];\n",
+                                              false);
+        modelCode += "\n";
+        modelCode += computeStepsFunctionCode(HeunSteps, QStringList() << "K" << "YK",
+                                              "        computeRates(voi, CONSTANTS, RATES, STATES, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i) {\n"
+                                              "            K[i]  = RATES[i];\n"
+                                              "            YK[i] = STATES[i]+realStep*RATES[i];\n"
+                                              "        }\n"
+                                              "\n"
+                                              "        computeRates(voi+realStep, CONSTANTS, RATES, YK, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i)\n"
+                                              "            STATES[i] += realHalfStep*(K[i]+RATES[i]);\n");
+        modelCode += "\n";
+        modelCode += computeStepsFunctionCode(MidpointSteps, QStringList() << "YK",
+                                              "        computeRates(voi, CONSTANTS, RATES, STATES, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i)\n"
+                                              "            YK[i] = STATES[i]+realHalfStep*RATES[i];\n"
+                                              "\n"
+                                              "        computeRates(voi+realHalfStep, CONSTANTS, RATES, YK, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i)\n"
+                                              "            STATES[i] += realStep*RATES[i];\n");
+        modelCode += "\n";
+        modelCode += computeStepsFunctionCode(SecondOrderRungeKuttaSteps, QStringList() << "YK1",
+                                              "        computeRates(voi, CONSTANTS, RATES, STATES, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i)\n"
+                                              "            YK1[i] = STATES[i]+realHalfStep*RATES[i];\n"
+                                              "\n"
+                                              "        computeRates(voi+realHalfStep, CONSTANTS, RATES, YK1, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i)\n"
+                                              "            STATES[i] += realStep*RATES[i];\n");
+        modelCode += "\n";
+        modelCode += computeStepsFunctionCode(FourthOrderRungeKuttaSteps, QStringList() << "K1" << "K23" << "YK123",
+                                              "        computeRates(voi, CONSTANTS, RATES, STATES, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i) {\n"
+                                              "            K1[i]    = RATES[i];\n"
+                                              "            YK123[i] = STATES[i]+realHalfStep*RATES[i];\n"
+                                              "        }\n"
+                                              "\n"
+                                              "        computeRates(voi+realHalfStep, CONSTANTS, RATES, YK123, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i) {\n"
+                                              "            K23[i]   = RATES[i];\n"
+                                              "            YK123[i] = STATES[i]+realHalfStep*RATES[i];\n"
+                                              "        }\n"
+                                              "\n"
+                                              "        computeRates(voi+realHalfStep, CONSTANTS, RATES, YK123, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i) {\n"
+                                              "            K23[i]   += RATES[i];\n"
+                                              "            YK123[i]  = STATES[i]+realStep*RATES[i];\n"
+                                              "        }\n"
+                                              "\n"
+                                              "        computeRates(voi+realStep, CONSTANTS, RATES, YK123, ALGEBRAIC);\n"
+                                              "\n"
+                                              "        for (i = 0; i < %STATES_COUNT%; ++i)\n"
+                                              "            STATES[i] += realStep*((1.0/6.0)*(K1[i]+RATES[i])+(1.0/3.0)*K23[i]);\n");
+    }
+
+    // Generate the functions needed to compute the sensitivity of our states
+    // with respect to some of our constants
+    // Note #1: STATES and RATES are expected to be of size N*(1+M), with N the
+    //          number of states and M the number of constants of interest. The
+    //          first N entries are our 'normal' states and rates while the
+    //          remaining ones are the sensitivities and their rates, one block
+    //          of N entries per constant of interest...
+    // Note #2: the CellML API doesn't give us access to the partial derivatives
+    //          of our model, so we compute the right-hand side of the forward
+    //          sensitivity equations (i.e. J*s_j+df/dp_j) using compiled
+    //          directional finite differences. This requires one additional
+    //          call to computeRates() per constant of interest...
+    // Note #3: the constants of interest are passed through CONSTANTS, which
+    //          is therefore expected to be of size 2*C+1, with C the number of
+    //          constants. CONSTANTS[C] holds the number of constants of
+    //          interest and CONSTANTS[C+1+j] the index of the jth one. This
+    //          means that computeSensitivityRates() has the same signature as
+    //          computeRates() and can therefore be used with any of our ODE
+    //          solvers, and that several simulations of the same model can
+    //          compute different sensitivities at the same time...
+    // Note #4: our perturbed rates are computed using our own algebraic array,
+    //          so that the algebraic variables of our unperturbed solution
+    //          don't get overwritten (an array of size zero is not valid C,
+    //          hence it always has at least one element)...
+
+    bool hasSensitivityFunctions = (mModelType == Ode) && statesCount() && constantsCount();
+
+    if (hasSensitivityFunctions) {
+        modelCode += "\n";
+        modelCode += QString("int computeSensitivityRates(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC)\n"
+                             "{\n"
+                             "    double initialConstants[%1];\n"
+                             "    double perturbedStates[%2];\n"
+                             "    double perturbedRates[%2];\n"
+                             "    double perturbedAlgebraic[%3];\n"
+                             "    double *sensitivities;\n"
+                             "    double *sensitivityRates;\n"
+                             "    double norm;\n"
+                             "    double delta;\n"
+                             "    int sensitivityParametersCount = (int) CONSTANTS[%1];\n"
+                             "    int i, j, k;\n"
+                             "\n"
+                             "    computeRates(VOI, CONSTANTS, RATES, STATES, ALGEBRAIC);\n"
+                             "\n"
+                             "    for (i = 0; i < %1; ++i)\n"
+                             "        initialConstants[i] = CONSTANTS[i];\n"
+                             "\n"
+                             "    for (j = 0; j < sensitivityParametersCount; ++j) {\n"
+                             "        sensitivities = STATES+(j+1)*%2;\n"
+                             "        sensitivityRates = RATES+(j+1)*%2;\n"
+                             "        k = (int) CONSTANTS[%1+1+j];\n"
+                             "\n"
+                             "        norm = 1.0;\n"
+                             "\n"
+                             "        for (i = 0; i < %2; ++i)\n"
+                             "            if (fabs(sensitivities[i]) > norm)\n"
+                             "                norm = fabs(sensitivities[i]);\n"
+                             "\n"
+                             "        delta = 1.0e-7*((fabs(CONSTANTS[k]) > 1.0)?fabs(CONSTANTS[k]):1.0)/norm;\n"
+                             "\n"
+                             "        for (i = 0; i < %2; ++i)\n"
+                             "            perturbedStates[i] = STATES[i]+delta*sensitivities[i];\n"
+                             "\n"
+                             "        CONSTANTS[k] += delta;\n"
+                             "\n"
+                             "        computeComputedConstants(CONSTANTS, perturbedRates, perturbedStates);\n"
+                             "        computeRates(VOI, CONSTANTS, perturbedRates, perturbedStates, perturbedAlgebraic);\n"
+                             "\n"
+                             "        for (i = 0; i < %2; ++i)\n"
+                             "            sensitivityRates[i] = (perturbedRates[i]-RATES[i])/delta;\n"
+                             "\n"
+                             "        for (i = 0; i < %1; ++i)\n"
+                             "            CONSTANTS[i] = initialConstants[i];\n"
+                             "    }\n"
+                             "\n"
+                             "    return 0;\n"
+                             "}\n").arg(QString::number(constantsCount()),
+                                        QString::number(statesCount()),
+                                        QString::number(qMax(1, algebraicCount())));
+    }
+
     if (mModelType == Dae) {
         modelCode += "\n";
         modelCode += functionCode("int computeEssentialVariables(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC, double *CONDVAR)",
@@ -922,7 +1284,12 @@ CellmlFileRuntime * CellmlFileRuntime::update(CellmlFile *pCellmlFile)
 
     // Compile the model code and check that everything went fine
 
-    if (!mCompilerEngine->compileCode(modelCode))
+    if (mCompilerEngine->compileCode(modelCode))
+        // Everything went fine, so keep track of a hash of our model code,
+        // so that people can tell whether two runtimes compute the same thing
+
+        mCodeHash = QCryptographicHash::hash(modelCode.toUtf8(), QCryptographicHash::Sha1);
+    else
         // Something went wrong, so output the error that was found
 
         mIssues << CellmlFileIssue(CellmlFileIssue::Error,
@@ -949,6 +1316,17 @@ CellmlFileRuntime * CellmlFileRuntime::update(CellmlFile *pCellmlFile)
             mComputeComputedConstants = (ComputeComputedConstantsFunction) (intptr_t) mCompilerEngine->getFunction("computeComputedConstants");
             mComputeRates             = (ComputeRatesFunction) (intptr_t) mCompilerEngine->getFunction("computeRates");
             mComputeVariables         = (ComputeVariablesFunction) (intptr_t) mCompilerEngine->getFunction("computeVariables");
+
+            if (hasComputeStepsFunctions)
+                foreach (const QString &computeStepsFunctionName,
+                         QStringList() << ForwardEulerSteps << HeunSteps
+                                       << MidpointSteps << SecondOrderRungeKuttaSteps
+                                       << FourthOrderRungeKuttaSteps)
+                    mComputeSteps.insert(computeStepsFunctionName,
+                                         (ComputeStepsFunction) (intptr_t) mCompilerEngine->getFunction(computeStepsFunctionName));
+
+            if (hasSensitivityFunctions)
+                mComputeSensitivityRates = (ComputeRatesFunction) (intptr_t) mCompilerEngine->getFunction("computeSensitivityRates");
         } else {
             mInitializeConstants = (InitializeConstantsFunction) (intptr_t) mCompilerEngine->getFunction("initializeConstants");
 
@@ -12,8 +12,11 @@
 
 //==============================================================================
 
+#include <QHash>
 #include <QList>
+#include <QMap>
 #include <QObject>
+#include <QStringList>
 
 //==============================================================================
 
@@ -101,6 +104,7 @@ public:
     typedef int (*ComputeResidualsFunction)(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC, double *CONDVAR, double *resid);
     typedef int (*ComputeRootInformationFunction)(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC, double *CONDVAR);
     typedef int (*ComputeStateInformationFunction)(double *SI);
+    typedef int (*ComputeStepsFunction)(double *VOI, double VOIEND, double STEP, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC);
     typedef int (*ComputeVariablesFunction)(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC);
 
     explicit CellmlFileRuntime();
@@ -132,9 +136,20 @@ public:
     ComputeStateInformationFunction computeStateInformation() const;
     ComputeVariablesFunction computeVariables() const;
 
+    ComputeStepsFunction computeSteps(const QString &pFunctionName) const;
+
+    ComputeRatesFunction computeSensitivityRates() const;
+
+    QByteArray codeHash() const;
+
     CellmlFileIssues issues() const;
 
-    CellmlFileRuntimeModelParameters modelParameters() const;
+    const CellmlFileRuntimeModelParameters & modelParameters() const;
+    const CellmlFileRuntimeModelParameters & modelParameters(const CellmlFileRuntimeModelParameter::ModelParameterType &pType) const;
+
+    CellmlFileRuntimeModelParameter * modelParameter(const QString &pComponent,
+                                                     const QString &pName,
+                                                     const int &pDegree = 0) const;
 
     CellmlFileRuntime * update(CellmlFile *pCellmlFile);
 
@@ -149,11 +164,18 @@ private:
 
     Compiler::CompilerEngine *mCompilerEngine;
 
+    QByteArray mCodeHash;
+
     CellmlFileIssues mIssues;
 
     CellmlFileRuntimeModelParameter *mVariableOfIntegration;
     CellmlFileRuntimeModelParameters mModelParameters;
 
+    CellmlFileRuntimeModelParameters mTypedModelParameters[CellmlFileRuntimeModelParameter::Undefined];
+    QHash<QString, CellmlFileRuntimeModelParameter *> mNamedModelParameters;
+
+    void indexModelParameters();
+
     InitializeConstantsFunction mInitializeConstants;
 
     ComputeComputedConstantsFunction mComputeComputedConstants;
@@ -164,6 +186,10 @@ private:
     ComputeStateInformationFunction mComputeStateInformation;
     ComputeVariablesFunction mComputeVariables;
 
+    QMap<QString, ComputeStepsFunction> mComputeSteps;
+
+    ComputeRatesFunction mComputeSensitivityRates;
+
     void resetOdeCodeInformation();
     void resetDaeCodeInformation();
 
@@ -182,6 +208,10 @@ private:
     QString functionCode(const QString &pFunctionSignature,
                          const QString &pFunctionBody,
                          const bool &pHasDefines = false);
+    QString computeStepsFunctionCode(const QString &pFunctionName,
+                                     const QStringList &pArrays,
+                                     const QString &pStepBody,
+                                     const bool &pNeedHalfStep = true);
 };
 
 //==============================================================================
@@ -7,9 +7,8 @@
 
 //==============================================================================
 
-#include <QCryptographicHash>
+#include <QFile>
 #include <QFileInfo>
-#include <QTextStream>
 
 //==============================================================================
 
@@ -18,11 +17,27 @@ namespace Core {
 
 //==============================================================================
 
+// Resolution, in milliseconds, of the last modified time of a file
+// Note: it is as coarse as one second on some file systems (and with some
+//       versions of Qt), and even two seconds on FAT file systems...
+
+static const qint64 LastModifiedResolution = 2000;
+
+//==============================================================================
+
 File::File(const QString &pFileName) :
     mFileName(nativeCanonicalFileName(pFileName)),
-    mSha1(sha1()),
+    mExists(false),
+    mLastModified(QDateTime()),
+    mSize(0),
+    mHash(0),
     mModified(false)
 {
+    // Retrieve the metadata and hash of the file
+
+    updateMetadata();
+
+    mHash = hash();
 }
 
 //==============================================================================
@@ -47,28 +62,48 @@ void File::setFileName(const QString &pFileName)
 
 File::Status File::check()
 {
-    // Get the current SHA1 value for the file and compare it to its currently
-    // stored value
+    // Check whether the file still exists and whether its metadata (i.e. last
+    // modified time and size) has changed
+    // Note #1: most of the time, the file won't have changed, in which case all
+    //          it costs us is a stat() call...
+    // Note #2: a file that gets rewritten with the same size within the
+    //          resolution of its last modified time has the same metadata, so
+    //          we can only rely on its metadata once its last modified time is
+    //          old enough, i.e. no rewrite can go unnoticed anymore...
 
-    QString crtSha1 = sha1();
+    bool metadataChanged = updateMetadata();
 
-    if (crtSha1.isEmpty()) {
-        // The current SHA1 value is empty, meaning that the file has been
-        // deleted, so update our currently stored value and let the caller know
+    if (!mExists) {
+        // The file doesn't exist (anymore), so reset our stored hash value and
+        // let the caller know
 
-        mSha1 = crtSha1;
+        mHash = 0;
 
         return File::Deleted;
-    } else if (!crtSha1.compare(mSha1)) {
-        // The current SHA1 value is the same as our currently stored value,
-        // so...
+    } else if (   !metadataChanged
+               && (qAbs(mLastModified.msecsTo(QDateTime::currentDateTime())) > LastModifiedResolution)) {
+        // The file's metadata is unchanged and its last modified time is old
+        // enough for it to be trusted, so...
+
+        return File::Unchanged;
+    }
+
+    // The file's metadata has changed (or cannot be trusted yet), so check
+    // whether its contents has actually changed by comparing its current hash
+    // value with its currently stored one (e.g. the file may have just been
+    // touched)
+
+    quint64 crtHash = hash();
+
+    if (crtHash == mHash) {
+        // The file's contents is the same, so...
 
         return File::Unchanged;
     } else {
-        // The current SHA1 value is different from our currently stored value,
-        // so update the latter and make the caller aware of the change
+        // The file's contents is different, so update our stored hash value
+        // and make the caller aware of the change
 
-        mSha1 = crtSha1;
+        mHash = crtHash;
 
         return File::Changed;
     }
@@ -76,28 +111,65 @@ File::Status File::check()
 
 //==============================================================================
 
-QString File::sha1() const
+bool File::updateMetadata()
 {
-    // Compute the SHA1 value for the file, if it still exists
+    // Retrieve the current metadata of the file and return whether it is
+    // different from our currently stored one
 
-    if (QFileInfo(mFileName).exists()) {
-        // The file still exists, so we can go ahead and compute its SHA1 value
+    QFileInfo fileInfo(mFileName);
+    bool crtExists = fileInfo.exists();
+    QDateTime crtLastModified = crtExists?fileInfo.lastModified():QDateTime();
+    qint64 crtSize = crtExists?fileInfo.size():0;
 
-        QFile file(mFileName);
+    if (   (crtExists == mExists) && (crtLastModified == mLastModified)
+        && (crtSize == mSize))
+        return false;
 
-        file.open(QIODevice::ReadOnly);
+    mExists = crtExists;
+    mLastModified = crtLastModified;
+    mSize = crtSize;
 
-        QString res = QCryptographicHash::hash(QTextStream(&file).readAll().toUtf8(),
-                                               QCryptographicHash::Sha1).toHex();
+    return true;
+}
 
-        file.close();
+//==============================================================================
+
+quint64 File::hash() const
+{
+    // Compute a (64-bit FNV-1a) hash value for the contents of the file, if it
+    // still exists
+    // Note: we don't need a cryptographic hash function, just a fast one, and
+    //       we map the file into memory rather than read it...
 
+    static const quint64 FnvOffsetBasis = Q_UINT64_C(14695981039346656037);
+    static const quint64 FnvPrime       = Q_UINT64_C(1099511628211);
+
+    quint64 res = FnvOffsetBasis;
+    QFile file(mFileName);
+
+    if (!file.open(QIODevice::ReadOnly))
         return res;
-    } else {
-        // The file doesn't exist anymore, so...
 
-        return QString();
+    qint64 fileSize = file.size();
+    uchar *data = fileSize?file.map(0, fileSize):0;
+
+    if (data) {
+        for (const uchar *byte = data, *lastByte = data+fileSize; byte != lastByte; ++byte)
+            res = (res^*byte)*FnvPrime;
+
+        file.unmap(data);
+    } else if (fileSize) {
+        // The file couldn't be mapped into memory, so read it instead
+
+        QByteArray fileContents = file.readAll();
+
+        for (int i = 0, iMax = fileContents.size(); i < iMax; ++i)
+            res = (res^uchar(fileContents[i]))*FnvPrime;
     }
+
+    file.close();
+
+    return res;
 }
 
 //==============================================================================
@@ -7,6 +7,7 @@
 
 //==============================================================================
 
+#include <QDateTime>
 #include <QString>
 
 //==============================================================================
@@ -37,11 +38,16 @@ public:
 
 private:
     QString mFileName;
-    QString mSha1;
+
+    bool mExists;
+    QDateTime mLastModified;
+    qint64 mSize;
+    quint64 mHash;
 
     bool mModified;
 
-    QString sha1() const;
+    bool updateMetadata();
+    quint64 hash() const;
 };
 
 //==============================================================================
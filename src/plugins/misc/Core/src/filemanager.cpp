@@ -8,6 +8,7 @@
 //==============================================================================
 
 #include <QDir>
+#include <QFileSystemWatcher>
 #include <QTimer>
 
 //==============================================================================
@@ -19,7 +20,21 @@ namespace Core {
 
 FileManager::FileManager(const int &pTimerInterval)
 {
+    // Create our file system watcher, which relies on the operating system to
+    // let us know when one of our files has changed (e.g. using inotify on
+    // Linux)
+
+    mFileSystemWatcher = new QFileSystemWatcher(this);
+
+    connect(mFileSystemWatcher, SIGNAL(fileChanged(const QString &)),
+            this, SLOT(fileChanged(const QString &)));
+
     // Create our timer
+    // Note: our file system watcher may not be able to watch some files (e.g.
+    //       on some network file systems) and it stops watching a file that
+    //       gets deleted, so we still check our files every now and then. This
+    //       is cheap since a file's contents is only looked at if its metadata
+    //       has changed...
 
     mTimer = new QTimer(this);
 
@@ -40,6 +55,7 @@ FileManager::~FileManager()
     // Delete some internal objects
 
     delete mTimer;
+    delete mFileSystemWatcher;
 
     // Remove all the managed files
 
@@ -76,6 +92,8 @@ FileManager::Status FileManager::manage(const QString &pFileName)
 
             mFiles << new File(nativeFileName);
 
+            mFileSystemWatcher->addPath(nativeFileName);
+
             emit fileManaged(nativeFileName);
 
             return Added;
@@ -101,6 +119,8 @@ FileManager::Status FileManager::unmanage(const QString &pFileName)
 
             mFiles.removeAt(mFiles.indexOf(file));
 
+            mFileSystemWatcher->removePath(nativeFileName);
+
             delete file;
 
             emit fileUnmanaged(nativeFileName);
@@ -192,6 +212,9 @@ FileManager::Status FileManager::rename(const QString &pOldFileName,
 
         file->setFileName(newFileName);
 
+        mFileSystemWatcher->removePath(oldFileName);
+        mFileSystemWatcher->addPath(newFileName);
+
         emit fileRenamed(oldFileName, newFileName);
 
         return Renamed;
@@ -209,30 +232,60 @@ int FileManager::count() const
 
 //==============================================================================
 
+void FileManager::checkFile(File *pFile)
+{
+    // Check the given file
+
+    switch (pFile->check()) {
+    case File::Changed:
+        // The contents of the file has changed, so...
+
+        emit fileContentsChanged(pFile->fileName());
+
+        break;
+    case File::Deleted:
+        // The file has been deleted, so...
+
+        emit fileDeleted(pFile->fileName());
+
+        break;
+    default:
+        // The file is unchanged, so do nothing...
+
+        ;
+    }
+
+    // Make sure that the file is (still) being watched, if it exists
+    // Note: a file that gets saved by writing a new file and renaming it (as
+    //       many editors do) or that gets deleted and then recreated is not
+    //       watched anymore...
+
+    if (   QFileInfo(pFile->fileName()).exists()
+        && !mFileSystemWatcher->files().contains(pFile->fileName()))
+        mFileSystemWatcher->addPath(pFile->fileName());
+}
+
+//==============================================================================
+
 void FileManager::checkFiles()
 {
     // Check our various files
 
     foreach (File *file, mFiles)
-        switch (file->check())
-        {
-            case File::Changed:
-                // The contents of the file has changed, so...
-
-                emit fileContentsChanged(file->fileName());
+        checkFile(file);
+}
 
-                break;
-            case File::Deleted:
-                // The file has been deleted, so...
+//==============================================================================
 
-                emit fileDeleted(file->fileName());
+void FileManager::fileChanged(const QString &pFileName)
+{
+    // Our file system watcher has let us know that one of our files has
+    // changed, so check it
 
-                break;
-            default:
-                // The file is unchanged, so do nothing...
+    File *file = isManaged(pFileName);
 
-                ;
-        }
+    if (file)
+        checkFile(file);
 }
 
 //==============================================================================
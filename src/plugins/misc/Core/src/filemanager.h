@@ -16,6 +16,7 @@
 
 //==============================================================================
 
+class QFileSystemWatcher;
 class QTimer;
 
 //==============================================================================
@@ -69,8 +70,11 @@ public:
 
 private:
     QTimer *mTimer;
+    QFileSystemWatcher *mFileSystemWatcher;
     QList<File *> mFiles;
 
+    void checkFile(File *pFile);
+
 Q_SIGNALS:
     void fileManaged(const QString &pFileName);
     void fileUnmanaged(const QString &pFileName);
@@ -87,6 +91,7 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void checkFiles();
+    void fileChanged(const QString &pFileName);
 };
 
 //==============================================================================
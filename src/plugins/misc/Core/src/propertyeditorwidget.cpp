@@ -567,8 +567,13 @@ void PropertyEditorWidget::constructor(const bool &pShowUnits,
     mPropertiesChecked = QMap<Property *, bool>();
 
     // Customise ourselves
+    // Note: all our rows have the same height, so let our tree view know about
+    //       it, so that it doesn't have to query every single row when laying
+    //       itself out, something that is costly when we have thousands of
+    //       properties...
 
     setRootIsDecorated(false);
+    setUniformRowHeights(true);
 
     // Create and set our data model
 
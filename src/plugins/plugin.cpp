@@ -2,13 +2,20 @@
 // Plugin
 //==============================================================================
 
+#include "coreinterface.h"
+#include "fileinterface.h"
+#include "guiinterface.h"
 #include "plugin.h"
 #include "pluginmanager.h"
 
 //==============================================================================
 
+#include <QApplication>
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
+#include <QMetaObject>
+#include <QMutexLocker>
 #include <QPluginLoader>
 #include <QSettings>
 
@@ -96,18 +103,37 @@ Plugin::Plugin(const QString &pFileName,
             // Check whether all of the plugin's dependencies, if any, were
             // loaded, and if so then try to load the plugin itself
 
-            if (pluginDependenciesLoaded) {
+            Solver::Type solverType;
+            QString solverName;
+            Solver::Properties solverProperties;
+
+            if (   pluginDependenciesLoaded
+                && cachedSolverInfo(pFileName, solverType, solverName, solverProperties)) {
+                // All the plugin's dependencies, if any, were loaded and we
+                // know that the plugin only provides a solver, which we know
+                // about, so let a proxy stand for the plugin, which will only
+                // get loaded when its solver is first used
+
+                mInstance = new SolverPluginProxy(pFileName, solverType,
+                                                  solverName, solverProperties,
+                                                  this);
+
+                mStatus = Loaded;
+            } else if (pluginDependenciesLoaded) {
                 // All the plugin's dependencies, if any, were loaded, so try to
                 // load the plugin itself
 
                 QPluginLoader pluginLoader(pFileName);
 
                 if (pluginLoader.load()) {
-                    // The plugin has been properly loaded, so...
+                    // The plugin has been properly loaded, so keep track of it
+                    // and of the solver it provides, if that's all it does
 
                     mInstance = pluginLoader.instance();
 
                     mStatus = Loaded;
+
+                    cacheSolverInfo(pFileName, mInstance);
                 } else {
                     // The plugin couldn't be loaded for some reason (surely,
                     // this should never happen...?!), so...
@@ -238,9 +264,203 @@ QString Plugin::fileName(const QString &pPluginsDir, const QString &pName)
 
 //==============================================================================
 
+static const QString SettingsPluginsCache = "PluginsCache";
+static const QString SettingsCacheKey = "CacheKey";
+static const QString SettingsPlugin = "Plugin";
+static const QString SettingsInterfaceVersion = "InterfaceVersion";
+static const QString SettingsType = "Type";
+static const QString SettingsCategory = "Category";
+static const QString SettingsManageable = "Manageable";
+static const QString SettingsDependencies = "Dependencies";
+static const QString SettingsDescriptions = "Descriptions";
+static const QString SettingsSolver = "Solver";
+static const QString SettingsSolverType = "SolverType";
+static const QString SettingsSolverName = "SolverName";
+static const QString SettingsSolverProperties = "SolverProperties";
+static const QString SettingsSolverPropertyType = "Type";
+static const QString SettingsSolverPropertyName = "Name";
+static const QString SettingsSolverPropertyDefaultValue = "DefaultValue";
+static const QString SettingsSolverPropertyHasVoiUnit = "HasVoiUnit";
+
+//==============================================================================
+
+QString Plugin::cacheKey(const QString &pFileName)
+{
+    // Return the key which we use to determine whether the cached information
+    // of a plugin is still valid, i.e. the plugin's last modified time and
+    // size
+
+    QFileInfo fileInfo(pFileName);
+
+    return  QString::number(fileInfo.lastModified().toMSecsSinceEpoch())
+           +"|"+QString::number(fileInfo.size());
+}
+
+//==============================================================================
+
+bool Plugin::cachedInfo(const QString &pFileName, PluginInfo *&pInfo)
+{
+    // Retrieve the plugin's cached information, if it is still valid
+    // Note: a file which is not a plugin is cached as such, in which case we
+    //       return true and set pInfo to zero...
+
+    QSettings settings(SettingsOrganization, SettingsApplication);
+    bool res = false;
+
+    settings.beginGroup(SettingsPluginsCache);
+        settings.beginGroup(name(pFileName));
+            if (!settings.value(SettingsCacheKey).toString().compare(cacheKey(pFileName))) {
+                if (settings.value(SettingsPlugin).toBool()) {
+                    Descriptions descriptions = Descriptions();
+                    QVariantMap cachedDescriptions = settings.value(SettingsDescriptions).toMap();
+
+                    foreach (const QString &locale, cachedDescriptions.keys())
+                        descriptions.insert(locale, cachedDescriptions.value(locale).toString());
+
+                    pInfo = new PluginInfo(PluginInfo::InterfaceVersion(settings.value(SettingsInterfaceVersion).toInt()),
+                                           PluginInfo::Type(settings.value(SettingsType).toInt()),
+                                           PluginInfo::Category(settings.value(SettingsCategory).toInt()),
+                                           settings.value(SettingsManageable).toBool(),
+                                           settings.value(SettingsDependencies).toStringList(),
+                                           descriptions);
+                } else {
+                    pInfo = 0;
+                }
+
+                res = true;
+            }
+        settings.endGroup();
+    settings.endGroup();
+
+    return res;
+}
+
+//==============================================================================
+
+void Plugin::cacheInfo(const QString &pFileName, PluginInfo *pInfo)
+{
+    // Cache the plugin's information, so that we don't have to load the plugin
+    // to retrieve it next time (unless the plugin has changed in between)
+
+    QSettings settings(SettingsOrganization, SettingsApplication);
+
+    settings.beginGroup(SettingsPluginsCache);
+        settings.beginGroup(name(pFileName));
+            settings.remove("");
+
+            settings.setValue(SettingsCacheKey, cacheKey(pFileName));
+            settings.setValue(SettingsPlugin, pInfo != 0);
+
+            if (pInfo) {
+                QVariantMap descriptions = QVariantMap();
+
+                foreach (const QString &locale, pInfo->descriptions().keys())
+                    descriptions.insert(locale, pInfo->descriptions().value(locale));
+
+                settings.setValue(SettingsInterfaceVersion, pInfo->interfaceVersion());
+                settings.setValue(SettingsType, pInfo->type());
+                settings.setValue(SettingsCategory, pInfo->category());
+                settings.setValue(SettingsManageable, pInfo->manageable());
+                settings.setValue(SettingsDependencies, pInfo->dependencies());
+                settings.setValue(SettingsDescriptions, descriptions);
+            }
+        settings.endGroup();
+    settings.endGroup();
+}
+
+//==============================================================================
+
+bool Plugin::cachedSolverInfo(const QString &pFileName, Solver::Type &pType,
+                              QString &pName, Solver::Properties &pProperties)
+{
+    // Retrieve the cached information about the solver which the plugin
+    // provides, but only if it is still valid and the plugin doesn't provide
+    // anything else (see cacheSolverInfo())
+
+    QSettings settings(SettingsOrganization, SettingsApplication);
+    bool res = false;
+
+    settings.beginGroup(SettingsPluginsCache);
+        settings.beginGroup(name(pFileName));
+            if (   !settings.value(SettingsCacheKey).toString().compare(cacheKey(pFileName))
+                && settings.value(SettingsSolver).toBool()) {
+                pType = Solver::Type(settings.value(SettingsSolverType).toInt());
+                pName = settings.value(SettingsSolverName).toString();
+                pProperties = Solver::Properties();
+
+                foreach (const QVariant &property, settings.value(SettingsSolverProperties).toList()) {
+                    QVariantMap propertyMap = property.toMap();
+
+                    pProperties << Solver::Property(Solver::PropertyType(propertyMap.value(SettingsSolverPropertyType).toInt()),
+                                                    propertyMap.value(SettingsSolverPropertyName).toString(),
+                                                    propertyMap.value(SettingsSolverPropertyDefaultValue),
+                                                    propertyMap.value(SettingsSolverPropertyHasVoiUnit).toBool());
+                }
+
+                res = true;
+            }
+        settings.endGroup();
+    settings.endGroup();
+
+    return res;
+}
+
+//==============================================================================
+
+void Plugin::cacheSolverInfo(const QString &pFileName, QObject *pInstance)
+{
+    // Cache the information about the solver which the plugin provides, so
+    // that the plugin doesn't have to be loaded next time until its solver is
+    // actually used (see SolverPluginProxy)
+    // Note: this only makes sense if the plugin doesn't provide anything else
+    //       that is needed at startup (e.g. a view or some file support)...
+
+    SolverInterface *solverInterface = qobject_cast<SolverInterface *>(pInstance);
+    bool solverOnly =    solverInterface
+                      && !qobject_cast<CoreInterface *>(pInstance)
+                      && !qobject_cast<FileInterface *>(pInstance)
+                      && !qobject_cast<GuiInterface *>(pInstance);
+
+    QSettings settings(SettingsOrganization, SettingsApplication);
+
+    settings.beginGroup(SettingsPluginsCache);
+        settings.beginGroup(name(pFileName));
+            settings.setValue(SettingsSolver, solverOnly);
+
+            if (solverOnly) {
+                QVariantList properties = QVariantList();
+
+                foreach (const Solver::Property &property, solverInterface->properties()) {
+                    QVariantMap propertyMap = QVariantMap();
+
+                    propertyMap.insert(SettingsSolverPropertyType, property.type());
+                    propertyMap.insert(SettingsSolverPropertyName, property.name());
+                    propertyMap.insert(SettingsSolverPropertyDefaultValue, property.defaultValue());
+                    propertyMap.insert(SettingsSolverPropertyHasVoiUnit, property.hasVoiUnit());
+
+                    properties << propertyMap;
+                }
+
+                settings.setValue(SettingsSolverType, solverInterface->type());
+                settings.setValue(SettingsSolverName, solverInterface->name());
+                settings.setValue(SettingsSolverProperties, properties);
+            }
+        settings.endGroup();
+    settings.endGroup();
+}
+
+//==============================================================================
+
 PluginInfo * Plugin::info(const QString &pFileName)
 {
-    // Return the plugin's information
+    // Return the plugin's cached information, if valid
+
+    PluginInfo *res;
+
+    if (cachedInfo(pFileName, res))
+        return res;
+
+    // Retrieve the plugin's information from the plugin itself
     // Note: to retrieve a plugin's information, we must, on both Windows and
     //       Linux, be able to load any plugin on which a plugin depends. On
     //       Windows, we do this (by keeping track of the current directory
@@ -269,11 +489,17 @@ PluginInfo * Plugin::info(const QString &pFileName)
         // The plugin information function was found, so we can extract the
         // information we are after
 
-        return static_cast<PluginInfo *>(pluginInfoFunc());
+        res = static_cast<PluginInfo *>(pluginInfoFunc());
     else
         // The plugin information couldn't be found, so...
 
-        return 0;
+        res = 0;
+
+    // Cache the plugin's information before returning it
+
+    cacheInfo(pFileName, res);
+
+    return res;
 }
 
 //==============================================================================
@@ -356,6 +582,94 @@ QStringList Plugin::requiredPlugins(const QString &pPluginsDir,
 
 //==============================================================================
 
+SolverPluginProxy::SolverPluginProxy(const QString &pFileName,
+                                     const Solver::Type &pType,
+                                     const QString &pName,
+                                     const Solver::Properties &pProperties,
+                                     QObject *pParent) :
+    QObject(pParent),
+    mFileName(pFileName),
+    mType(pType),
+    mName(pName),
+    mProperties(pProperties),
+    mSolverInterface(0)
+{
+}
+
+//==============================================================================
+
+Solver::Type SolverPluginProxy::type() const
+{
+    // Return the type of our solver
+
+    return mType;
+}
+
+//==============================================================================
+
+QString SolverPluginProxy::name() const
+{
+    // Return the name of our solver
+
+    return mName;
+}
+
+//==============================================================================
+
+Solver::Properties SolverPluginProxy::properties() const
+{
+    // Return the properties supported by our solver
+
+    return mProperties;
+}
+
+//==============================================================================
+
+void * SolverPluginProxy::instance() const
+{
+    // Load our plugin, if it hasn't already been loaded, and have it create
+    // and return an instance of its solver
+    // Note #1: we may be called from a simulation worker, hence our mutex...
+    // Note #2: our plugin's translations only become available once it has
+    //          been loaded, so we then update our translator, but from the GUI
+    //          thread...
+
+    QMutexLocker locker(&mMutex);
+
+    if (!mSolverInterface) {
+        QPluginLoader pluginLoader(mFileName);
+
+        if (!pluginLoader.load())
+            return 0;
+
+        QObject *pluginInstance = pluginLoader.instance();
+
+        pluginInstance->moveToThread(qApp->thread());
+
+        mSolverInterface = qobject_cast<SolverInterface *>(pluginInstance);
+
+        if (!mSolverInterface)
+            return 0;
+
+        QMetaObject::invokeMethod(const_cast<SolverPluginProxy *>(this),
+                                  "updateTranslator", Qt::QueuedConnection);
+    }
+
+    return mSolverInterface->instance();
+}
+
+//==============================================================================
+
+void SolverPluginProxy::updateTranslator()
+{
+    // Reload our translator now that our plugin's translations are available
+
+    if (!locale().isEmpty())
+        setLocale(locale());
+}
+
+//==============================================================================
+
 }   // namespace OpenCOR
 
 //==============================================================================
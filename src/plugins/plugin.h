@@ -7,10 +7,13 @@
 
 //==============================================================================
 
+#include "i18ninterface.h"
 #include "plugininfo.h"
+#include "solverinterface.h"
 
 //==============================================================================
 
+#include <QMutex>
 #include <QObject>
 
 //==============================================================================
@@ -98,6 +101,53 @@ private:
     QObject *mInstance;
     Status mStatus;
     QString mStatusErrors;
+
+    static QString cacheKey(const QString &pFileName);
+
+    static bool cachedInfo(const QString &pFileName, PluginInfo *&pInfo);
+    static void cacheInfo(const QString &pFileName, PluginInfo *pInfo);
+
+    static bool cachedSolverInfo(const QString &pFileName,
+                                 Solver::Type &pType, QString &pName,
+                                 Solver::Properties &pProperties);
+    static void cacheSolverInfo(const QString &pFileName, QObject *pInstance);
+};
+
+//==============================================================================
+
+class SolverPluginProxy : public QObject, public SolverInterface,
+                          public I18nInterface
+{
+    Q_OBJECT
+
+    Q_INTERFACES(OpenCOR::I18nInterface)
+    Q_INTERFACES(OpenCOR::SolverInterface)
+
+public:
+    explicit SolverPluginProxy(const QString &pFileName,
+                               const Solver::Type &pType, const QString &pName,
+                               const Solver::Properties &pProperties,
+                               QObject *pParent);
+
+    virtual Solver::Type type() const;
+    virtual QString name() const;
+    virtual Solver::Properties properties() const;
+
+    virtual void * instance() const;
+
+private:
+    QString mFileName;
+
+    Solver::Type mType;
+    QString mName;
+    Solver::Properties mProperties;
+
+    mutable QMutex mMutex;
+
+    mutable SolverInterface *mSolverInterface;
+
+private Q_SLOTS:
+    void updateTranslator();
 };
 
 //==============================================================================
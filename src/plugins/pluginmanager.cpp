@@ -6,6 +6,10 @@
 #include "coreinterface.h"
 #include "pluginmanager.h"
 
+#ifdef OpenCOR_MAIN
+    #include "startuptrace.h"
+#endif
+
 //==============================================================================
 
 #include <QApplication>
@@ -66,9 +70,16 @@ PluginManager::PluginManager(const PluginInfo::Type &pGuiOrConsoleType) :
     // QtMmlWidget plugin), in which case the unmanageable plugin must be
     // loaded. So, we must here determine which of those plugins must be
     // loaded...
+    // Note: our startup trace is only built into our main executable, since
+    //       each plugin would otherwise get its own copy of it, hence we only
+    //       trace things when we are part of our main executable...
 
     QStringList plugins;
 
+#ifdef OpenCOR_MAIN
+    StartupTrace::instance()->begin("Plugins information retrieval");
+#endif
+
     foreach (const QString &fileName, fileNames) {
         PluginInfo *pluginInfo = Plugin::info(fileName);
 
@@ -84,6 +95,10 @@ PluginManager::PluginManager(const PluginInfo::Type &pGuiOrConsoleType) :
 
     plugins.removeDuplicates();
 
+#ifdef OpenCOR_MAIN
+    StartupTrace::instance()->end();
+#endif
+
     // Knowing which plugins are required, we must now ensure that these are
     // loaded first. Note that this is not required on Windows (even though it
     // clearly doesn't harm having them loaded first!), but on Linux and OS X it
@@ -101,11 +116,26 @@ PluginManager::PluginManager(const PluginInfo::Type &pGuiOrConsoleType) :
     orderedFileNames.removeDuplicates();
 
     // Deal with all the plugins we found
+    // Note: plugins that only provide a solver are, after their first load,
+    //       represented by a proxy and only loaded when their solver is first
+    //       used (see SolverPluginProxy). Other plugins, including those that
+    //       provide views, are loaded now since the GUI (e.g. our main window
+    //       or our central widget) needs their interfaces at startup...
+
+    foreach (const QString &fileName, orderedFileNames) {
+#ifdef OpenCOR_MAIN
+        StartupTrace::instance()->begin(Plugin::name(fileName)+" loading",
+                                        Plugin::name(fileName));
+#endif
 
-    foreach (const QString &fileName, orderedFileNames)
         mPlugins << new Plugin(fileName, mGuiOrConsoleType,
                                plugins.contains(Plugin::name(fileName)),
                                interfaceVersion(), pluginsDir(), this);
+
+#ifdef OpenCOR_MAIN
+        StartupTrace::instance()->end();
+#endif
+    }
 }
 
 //==============================================================================
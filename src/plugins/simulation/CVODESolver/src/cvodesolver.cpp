@@ -8,6 +8,7 @@
 
 #include "cvode/cvode.h"
 #include "cvode/cvode_dense.h"
+#include "cvode/cvode_direct.h"
 
 //==============================================================================
 
@@ -22,10 +23,12 @@ int rhsFunction(double pVoi, N_Vector pStates, N_Vector pRates, void *pUserData)
 
     CvodeSolverUserData *userData = static_cast<CvodeSolverUserData *>(pUserData);
 
-    userData->computeRates()(pVoi, userData->constants(),
-                             N_VGetArrayPointer_Serial(pRates),
-                             N_VGetArrayPointer_Serial(pStates),
-                             userData->algebraic());
+    userData->solver()->startModelTimer();
+        userData->computeRates()(pVoi, userData->constants(),
+                                 N_VGetArrayPointer_Serial(pRates),
+                                 N_VGetArrayPointer_Serial(pStates),
+                                 userData->algebraic());
+    userData->solver()->stopModelTimer();
 
     // Everything went fine, so...
 
@@ -48,8 +51,10 @@ void errorHandler(int pErrorCode, const char *pModule, const char *pFunction,
 
 //==============================================================================
 
-CvodeSolverUserData::CvodeSolverUserData(double *pConstants, double *pAlgebraic,
+CvodeSolverUserData::CvodeSolverUserData(CvodeSolver *pSolver,
+                                         double *pConstants, double *pAlgebraic,
                                          CoreSolver::CoreOdeSolver::ComputeRatesFunction pComputeRates) :
+    mSolver(pSolver),
     mConstants(pConstants),
     mAlgebraic(pAlgebraic),
     mComputeRates(pComputeRates)
@@ -58,6 +63,15 @@ CvodeSolverUserData::CvodeSolverUserData(double *pConstants, double *pAlgebraic,
 
 //==============================================================================
 
+CvodeSolver * CvodeSolverUserData::solver() const
+{
+    // Return our solver
+
+    return mSolver;
+}
+
+//==============================================================================
+
 double * CvodeSolverUserData::constants() const
 {
     // Return our constants array
@@ -92,7 +106,8 @@ CvodeSolver::CvodeSolver() :
     mMaximumStep(DefaultMaximumStep),
     mMaximumNumberOfSteps(DefaultMaximumNumberOfSteps),
     mRelativeTolerance(DefaultRelativeTolerance),
-    mAbsoluteTolerance(DefaultAbsoluteTolerance)
+    mAbsoluteTolerance(DefaultAbsoluteTolerance),
+    mPreviousStatistics(OpenCOR::CoreSolver::Statistics())
 {
 }
 
@@ -183,7 +198,7 @@ void CvodeSolver::initialize(const double &pVoiStart, const int &pStatesCount,
 
         delete mUserData;   // Just in case the solver got initialised before
 
-        mUserData = new CvodeSolverUserData(pConstants, pAlgebraic,
+        mUserData = new CvodeSolverUserData(this, pConstants, pAlgebraic,
                                             pComputeRates);
 
         CVodeSetUserData(mSolver, mUserData);
@@ -204,7 +219,10 @@ void CvodeSolver::initialize(const double &pVoiStart, const int &pStatesCount,
 
         CVodeSStolerances(mSolver, mRelativeTolerance, mAbsoluteTolerance);
     } else {
-        // Reinitialise the CVODE object
+        // Reinitialise the CVODE object, after keeping track of its statistics
+        // since they are about to be reset
+
+        addStatistics(mPreviousStatistics, cvodeStatistics());
 
         CVodeReInit(mSolver, pVoiStart, mStatesVector);
     }
@@ -226,8 +244,105 @@ void CvodeSolver::solve(double &pVoi, const double &pVoiEnd) const
     //       transfers while here we 'only' compute the rates one more time,
     //       so...
 
-    mComputeRates(pVoiEnd, mConstants, mRates,
-                  N_VGetArrayPointer_Serial(mStatesVector), mAlgebraic);
+    startModelTimer();
+        mComputeRates(pVoiEnd, mConstants, mRates,
+                      N_VGetArrayPointer_Serial(mStatesVector), mAlgebraic);
+    stopModelTimer();
+}
+
+//==============================================================================
+
+CoreSolver::Properties CvodeSolver::internalState() const
+{
+    // Return the step size and order that CVODE is to use next
+    // Note: CVODE doesn't give access to its history (i.e. its Nordsieck
+    //       array), so we cannot return it...
+
+    OpenCOR::CoreSolver::Properties res = OpenCOR::CoreSolver::Properties();
+
+    if (mSolver) {
+        double step;
+        int order;
+
+        if (CVodeGetCurrentStep(mSolver, &step) == CV_SUCCESS)
+            res.insert(StepInternalState, step);
+
+        if (CVodeGetCurrentOrder(mSolver, &order) == CV_SUCCESS)
+            res.insert(OrderInternalState, order);
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+void CvodeSolver::setInternalState(const OpenCOR::CoreSolver::Properties &pInternalState)
+{
+    // Use the given step size as the initial step size of CVODE, which must
+    // have been (re)initialised beforehand
+    // Note: CVODE always restarts at order 1 and it doesn't allow its history
+    //       to be set, so this is the best we can do to carry on from where a
+    //       previous solver was...
+
+    if (!mSolver || !pInternalState.contains(StepInternalState))
+        return;
+
+    double step = pInternalState.value(StepInternalState).toDouble();
+
+    if (step != 0.0)
+        CVodeSetInitStep(mSolver, step);
+}
+
+//==============================================================================
+
+CoreSolver::Statistics CvodeSolver::cvodeStatistics() const
+{
+    // Return the statistics that CVODE has kept track of since it was last
+    // (re)initialised
+    // Note #1: we use a Newton iteration, so each of its iterations involves
+    //          one linear solve...
+    // Note #2: we keep track of the number of RHS evaluations ourselves (see
+    //          rhsFunction()), so we don't need CVODE's...
+
+    OpenCOR::CoreSolver::Statistics res = OpenCOR::CoreSolver::Statistics();
+
+    if (!mSolver)
+        return res;
+
+    long int stepsCount;
+    long int jacobianEvaluationsCount;
+    long int linearSolvesCount;
+    long int errorTestFailuresCount;
+    long int convergenceFailuresCount;
+
+    CVodeGetNumSteps(mSolver, &stepsCount);
+    CVDlsGetNumJacEvals(mSolver, &jacobianEvaluationsCount);
+    CVodeGetNumNonlinSolvIters(mSolver, &linearSolvesCount);
+    CVodeGetNumErrTestFails(mSolver, &errorTestFailuresCount);
+    CVodeGetNumNonlinSolvConvFails(mSolver, &convergenceFailuresCount);
+
+    res.insert(OpenCOR::CoreSolver::StepsStatistic, qulonglong(stepsCount));
+    res.insert(OpenCOR::CoreSolver::JacobianEvaluationsStatistic, qulonglong(jacobianEvaluationsCount));
+    res.insert(OpenCOR::CoreSolver::LinearSolvesStatistic, qulonglong(linearSolvesCount));
+    res.insert(OpenCOR::CoreSolver::ErrorTestFailuresStatistic, qulonglong(errorTestFailuresCount));
+    res.insert(OpenCOR::CoreSolver::ConvergenceFailuresStatistic, qulonglong(convergenceFailuresCount));
+
+    return res;
+}
+
+//==============================================================================
+
+CoreSolver::Statistics CvodeSolver::statistics() const
+{
+    // Return our statistics, i.e. the ones we keep track of ourselves and the
+    // ones CVODE has kept track of, including before it was last reinitialised
+
+    OpenCOR::CoreSolver::Statistics res = OpenCOR::CoreSolver::CoreOdeSolver::statistics();
+
+    addStatistics(res, mPreviousStatistics);
+    addStatistics(res, cvodeStatistics());
+
+    return res;
 }
 
 //==============================================================================
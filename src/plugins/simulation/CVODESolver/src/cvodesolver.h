@@ -27,6 +27,11 @@ static const QString AbsoluteToleranceProperty = "Absolute tolerance";
 
 //==============================================================================
 
+static const QString StepInternalState = "Step";
+static const QString OrderInternalState = "Order";
+
+//==============================================================================
+
 // Default CVODE parameter values
 // Note #1: a maximum step of 0 means that there is no maximum step as such and
 //          that CVODE can use whatever step it sees fit...
@@ -44,18 +49,27 @@ static const double DefaultAbsoluteTolerance = 1.0e-7;
 
 //==============================================================================
 
+class CvodeSolver;
+
+//==============================================================================
+
 class CvodeSolverUserData
 {
 public:
-    explicit CvodeSolverUserData(double *pConstants, double *pAlgebraic,
+    explicit CvodeSolverUserData(CvodeSolver *pSolver,
+                                 double *pConstants, double *pAlgebraic,
                                  CoreSolver::CoreOdeSolver::ComputeRatesFunction pComputeRates);
 
+    CvodeSolver * solver() const;
+
     double * constants() const;
     double * algebraic() const;
 
     CoreSolver::CoreOdeSolver::ComputeRatesFunction computeRates() const;
 
 private:
+    CvodeSolver *mSolver;
+
     double *mConstants;
     double *mAlgebraic;
 
@@ -76,6 +90,11 @@ public:
 
     virtual void solve(double &pVoi, const double &pVoiEnd) const;
 
+    virtual OpenCOR::CoreSolver::Properties internalState() const;
+    virtual void setInternalState(const OpenCOR::CoreSolver::Properties &pInternalState);
+
+    virtual OpenCOR::CoreSolver::Statistics statistics() const;
+
 private:
     void *mSolver;
     N_Vector mStatesVector;
@@ -85,6 +104,10 @@ private:
     int mMaximumNumberOfSteps;
     double mRelativeTolerance;
     double mAbsoluteTolerance;
+
+    OpenCOR::CoreSolver::Statistics mPreviousStatistics;
+
+    OpenCOR::CoreSolver::Statistics cvodeStatistics() const;
 };
 
 //==============================================================================
@@ -13,7 +13,9 @@ namespace CoreSolver {
 
 CoreOdeSolver::CoreOdeSolver() :
     CoreVoiSolver(),
-    mComputeRates(0)
+    mComputeRates(0),
+    mComputeSteps(0),
+    mStepsCount(0)
 {
 }
 
@@ -40,6 +42,44 @@ void CoreOdeSolver::initialize(const double &pVoiStart, const int &pStatesCount,
 
 //==============================================================================
 
+QString CoreOdeSolver::computeStepsFunctionName() const
+{
+    // Return the name of the model function which can compute several steps of
+    // our ODE solver in one go
+    // Note: by default, an ODE solver doesn't have such a function, but a
+    //       fixed-step ODE solver may have one generated for it by the CellML
+    //       file runtime...
+
+    return QString();
+}
+
+//==============================================================================
+
+void CoreOdeSolver::setComputeSteps(ComputeStepsFunction pComputeSteps)
+{
+    // Keep track of the model function which computes several steps of our ODE
+    // solver in one go, if any
+
+    mComputeSteps = pComputeSteps;
+}
+
+//==============================================================================
+
+Statistics CoreOdeSolver::statistics() const
+{
+    // Return our statistics, including the number of steps that we have taken
+    // Note: ODE solvers which don't keep track of their number of steps
+    //       themselves are expected to update mStepsCount as they go...
+
+    Statistics res = CoreVoiSolver::statistics();
+
+    res.insert(StepsStatistic, mStepsCount);
+
+    return res;
+}
+
+//==============================================================================
+
 }   // namespace CoreSolver
 }   // namespace OpenCOR
 
@@ -20,6 +20,7 @@ class CORESOLVER_EXPORT CoreOdeSolver : public CoreVoiSolver
 {
 public:
     typedef int (*ComputeRatesFunction)(double VOI, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC);
+    typedef int (*ComputeStepsFunction)(double *VOI, double VOIEND, double STEP, double *CONSTANTS, double *RATES, double *STATES, double *ALGEBRAIC);
 
     explicit CoreOdeSolver();
 
@@ -27,8 +28,17 @@ public:
                             double *pConstants, double *pStates, double *pRates,
                             double *pAlgebraic, ComputeRatesFunction pComputeRates);
 
+    virtual QString computeStepsFunctionName() const;
+
+    void setComputeSteps(ComputeStepsFunction pComputeSteps);
+
+    virtual Statistics statistics() const;
+
 protected:
     ComputeRatesFunction mComputeRates;
+    ComputeStepsFunction mComputeSteps;
+
+    mutable qulonglong mStepsCount;
 };
 
 //==============================================================================
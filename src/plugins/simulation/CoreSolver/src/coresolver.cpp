@@ -11,8 +11,16 @@ namespace CoreSolver {
 
 //==============================================================================
 
+static bool coreSolverModelTiming = false;
+
+//==============================================================================
+
 CoreSolver::CoreSolver() :
-    mProperties(Properties())
+    mProperties(Properties()),
+    mModelTiming(coreSolverModelTiming),
+    mModelTimer(QElapsedTimer()),
+    mModelTime(0),
+    mFunctionEvaluations(0)
 {
 }
 
@@ -44,6 +52,92 @@ void CoreSolver::emitError(const QString &pErrorMsg)
 
 //==============================================================================
 
+Statistics CoreSolver::statistics() const
+{
+    // Return the statistics that we keep track of ourselves, i.e. the number
+    // of times our model code was evaluated and, if model timing was enabled
+    // when we were created, the time spent evaluating it
+    // Note: solvers that know more about themselves are expected to complete
+    //       those statistics...
+
+    Statistics res = Statistics();
+
+    res.insert(FunctionEvaluationsStatistic, mFunctionEvaluations);
+
+    if (mModelTiming)
+        res.insert(ModelTimeStatistic, 0.000001*mModelTime);
+
+    return res;
+}
+
+//==============================================================================
+
+bool CoreSolver::modelTiming()
+{
+    // Return whether the solvers to be created are to time the evaluations of
+    // their model code
+
+    return coreSolverModelTiming;
+}
+
+//==============================================================================
+
+void CoreSolver::setModelTiming(const bool &pModelTiming)
+{
+    // Set whether the solvers to be created are to time the evaluations of
+    // their model code
+    // Note: model timing is disabled by default since our model code may be
+    //       evaluated millions of times during a simulation and reading our
+    //       clock twice each time is far from free, especially for small
+    //       models...
+
+    coreSolverModelTiming = pModelTiming;
+}
+
+//==============================================================================
+
+void CoreSolver::startModelTimer() const
+{
+    // Start timing an evaluation of our model code, if requested
+
+    if (mModelTiming)
+        mModelTimer.start();
+}
+
+//==============================================================================
+
+void CoreSolver::stopModelTimer(const qulonglong &pFunctionEvaluations) const
+{
+    // Keep track of the time spent evaluating our model code, if requested,
+    // and of the number of evaluations that this represents
+
+    if (mModelTiming)
+        mModelTime += mModelTimer.nsecsElapsed();
+
+    mFunctionEvaluations += pFunctionEvaluations;
+}
+
+//==============================================================================
+
+void CoreSolver::addStatistics(Statistics &pStatistics,
+                               const Statistics &pOtherStatistics)
+{
+    // Add some statistics to some others, e.g. to keep track of the statistics
+    // of a solver that gets reinitialised, and therefore loses its statistics,
+    // while being used
+
+    foreach (const QString &statistic, pOtherStatistics.keys()) {
+        QVariant value = pOtherStatistics.value(statistic);
+
+        if (value.type() == QVariant::Double)
+            pStatistics.insert(statistic, pStatistics.value(statistic).toDouble()+value.toDouble());
+        else
+            pStatistics.insert(statistic, pStatistics.value(statistic).toULongLong()+value.toULongLong());
+    }
+}
+
+//==============================================================================
+
 }   // namespace CoreSolver
 }   // namespace OpenCOR
 
@@ -11,6 +11,7 @@
 
 //==============================================================================
 
+#include <QElapsedTimer>
 #include <QMap>
 #include <QVariant>
 
@@ -22,6 +23,26 @@ namespace CoreSolver {
 //==============================================================================
 
 typedef QMap<QString, QVariant> Properties;
+typedef QMap<QString, QVariant> Statistics;
+
+//==============================================================================
+
+// Statistics that solvers may report about their use
+// Note #1: a function evaluation is an evaluation of whatever our model code
+//          computes for a given solver, i.e. its rates (ODE solvers), its
+//          residuals (DAE solvers) or its system (NLA solvers)...
+// Note #2: times are in milliseconds...
+// Note #3: the time spent in our model is only reported if model timing is
+//          enabled (see CoreSolver::setModelTiming())...
+
+static const QString StepsStatistic = "Steps";
+static const QString FunctionEvaluationsStatistic = "Function evaluations";
+static const QString JacobianEvaluationsStatistic = "Jacobian evaluations";
+static const QString LinearSolvesStatistic = "Linear solves";
+static const QString ErrorTestFailuresStatistic = "Error test failures";
+static const QString ConvergenceFailuresStatistic = "Convergence failures";
+static const QString ModelTimeStatistic = "Model time";
+static const QString SolverTimeStatistic = "Solver time";
 
 //==============================================================================
 
@@ -36,9 +57,26 @@ public:
 
     void emitError(const QString &pErrorMsg);
 
+    virtual Statistics statistics() const;
+
+    static bool modelTiming();
+    static void setModelTiming(const bool &pModelTiming);
+
+    void startModelTimer() const;
+    void stopModelTimer(const qulonglong &pFunctionEvaluations = 1) const;
+
+    static void addStatistics(Statistics &pStatistics,
+                              const Statistics &pOtherStatistics);
+
 protected:
     Properties mProperties;
 
+    bool mModelTiming;
+
+    mutable QElapsedTimer mModelTimer;
+    mutable qint64 mModelTime;
+    mutable qulonglong mFunctionEvaluations;
+
 Q_SIGNALS:
     void error(const QString &pErrorMsg);
 };
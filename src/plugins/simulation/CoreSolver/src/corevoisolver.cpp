@@ -23,6 +23,28 @@ CoreVoiSolver::CoreVoiSolver() :
 
 //==============================================================================
 
+Properties CoreVoiSolver::internalState() const
+{
+    // Return our internal state, i.e. whatever we need, besides our states, to
+    // carry on solving our model from where we currently are
+    // Note: by default, we don't have any internal state...
+
+    return Properties();
+}
+
+//==============================================================================
+
+void CoreVoiSolver::setInternalState(const Properties &pInternalState)
+{
+    Q_UNUSED(pInternalState);
+
+    // Set our internal state (see internalState())
+    // Note: by default, we don't have any internal state, so there is nothing
+    //       to do...
+}
+
+//==============================================================================
+
 }   // namespace CoreSolver
 }   // namespace OpenCOR
 
@@ -23,6 +23,9 @@ public:
 
     virtual void solve(double &pVoi, const double &pVoiEnd) const = 0;
 
+    virtual Properties internalState() const;
+    virtual void setInternalState(const Properties &pInternalState);
+
 protected:
     int mStatesCount;
 
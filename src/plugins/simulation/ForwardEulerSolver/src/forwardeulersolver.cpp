@@ -44,10 +44,34 @@ void ForwardEulerSolver::initialize(const double &pVoiStart,
 
 //==============================================================================
 
+QString ForwardEulerSolver::computeStepsFunctionName() const
+{
+    // Return the name of the model function which computes several steps of
+    // our solver in one go
+
+    return "computeForwardEulerSteps";
+}
+
+//==============================================================================
+
 void ForwardEulerSolver::solve(double &pVoi, const double &pVoiEnd) const
 {
     // Y_n+1 = Y_n + h * f(t_n, Y_n)
 
+    // Compute all of our steps in one go, if our model has a function to do so
+
+    if (mComputeSteps) {
+        // Note: our model function returns the number of steps it took...
+
+        startModelTimer();
+            qulonglong stepsCount = mComputeSteps(&pVoi, pVoiEnd, mStep, mConstants, mRates, mStates, mAlgebraic);
+        stopModelTimer(stepsCount);
+
+        mStepsCount += stepsCount;
+
+        return;
+    }
+
     double voiStart = pVoi;
 
     int stepNumber = 0;
@@ -61,14 +85,18 @@ void ForwardEulerSolver::solve(double &pVoi, const double &pVoiEnd) const
 
         // Compute f(t_n, Y_n)
 
-        mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+        stopModelTimer();
 
         // Compute Y_n+1
 
         for (int i = 0; i < mStatesCount; ++i)
             mStates[i] += realStep*mRates[i];
 
-        // Advance through time
+        // Keep track of our number of steps and advance through time
+
+        ++mStepsCount;
 
         if (realStep != mStep)
             pVoi = pVoiEnd;
@@ -33,6 +33,8 @@ public:
                             double *pConstants, double *pStates, double *pRates,
                             double *pAlgebraic, ComputeRatesFunction pComputeRates);
 
+    virtual QString computeStepsFunctionName() const;
+
     virtual void solve(double &pVoi, const double &pVoiEnd) const;
 
 private:
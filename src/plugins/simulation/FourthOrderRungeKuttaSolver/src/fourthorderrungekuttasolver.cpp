@@ -74,6 +74,16 @@ void FourthOrderRungeKuttaSolver::initialize(const double &pVoiStart,
 
 //==============================================================================
 
+QString FourthOrderRungeKuttaSolver::computeStepsFunctionName() const
+{
+    // Return the name of the model function which computes several steps of
+    // our solver in one go
+
+    return "computeFourthOrderRungeKuttaSteps";
+}
+
+//==============================================================================
+
 void FourthOrderRungeKuttaSolver::solve(double &pVoi,
                                         const double &pVoiEnd) const
 {
@@ -89,6 +99,20 @@ void FourthOrderRungeKuttaSolver::solve(double &pVoi,
     static const double OneOverThree = 1.0/3.0;
     static const double OneOverSix   = 1.0/6.0;
 
+    // Compute all of our steps in one go, if our model has a function to do so
+
+    if (mComputeSteps) {
+        // Note: our model function returns the number of steps it took...
+
+        startModelTimer();
+            qulonglong stepsCount = mComputeSteps(&pVoi, pVoiEnd, mStep, mConstants, mRates, mStates, mAlgebraic);
+        stopModelTimer(4*stepsCount);
+
+        mStepsCount += stepsCount;
+
+        return;
+    }
+
     double voiStart = pVoi;
 
     int stepNumber = 0;
@@ -105,7 +129,9 @@ void FourthOrderRungeKuttaSolver::solve(double &pVoi,
 
         // Compute f(t_n, Y_n)
 
-        mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+        stopModelTimer();
 
         // Compute k1 and Yk1
 
@@ -116,7 +142,9 @@ void FourthOrderRungeKuttaSolver::solve(double &pVoi,
 
         // Compute f(t_n + h / 2, Y_n + k1 / 2)
 
-        mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk123, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk123, mAlgebraic);
+        stopModelTimer();
 
         // Compute k2 and Yk2
 
@@ -127,7 +155,9 @@ void FourthOrderRungeKuttaSolver::solve(double &pVoi,
 
         // Compute f(t_n + h / 2, Y_n + k2 / 2)
 
-        mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk123, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk123, mAlgebraic);
+        stopModelTimer();
 
         // Compute k3 and Yk3
 
@@ -138,14 +168,18 @@ void FourthOrderRungeKuttaSolver::solve(double &pVoi,
 
         // Compute f(t_n + h, Y_n + k3)
 
-        mComputeRates(pVoi+realStep, mConstants, mRates, mYk123, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi+realStep, mConstants, mRates, mYk123, mAlgebraic);
+        stopModelTimer();
 
         // Compute k4 and therefore Y_n+1
 
         for (int i = 0; i < mStatesCount; ++i)
             mStates[i] += realStep*(OneOverSix*(mK1[i]+mRates[i])+OneOverThree*mK23[i]);
 
-        // Advance through time
+        // Keep track of our number of steps and advance through time
+
+        ++mStepsCount;
 
         if (realStep != mStep)
             pVoi = pVoiEnd;
@@ -63,11 +63,35 @@ void HeunSolver::initialize(const double &pVoiStart, const int &pStatesCount,
 
 //==============================================================================
 
+QString HeunSolver::computeStepsFunctionName() const
+{
+    // Return the name of the model function which computes several steps of
+    // our solver in one go
+
+    return "computeHeunSteps";
+}
+
+//==============================================================================
+
 void HeunSolver::solve(double &pVoi, const double &pVoiEnd) const
 {
     // k = h * f(t_n, Y_n)
     // Y_n+1 = Y_n + h / 2 * ( f(t_n, Y_n) + f(t_n + h, Y_n + k) )
 
+    // Compute all of our steps in one go, if our model has a function to do so
+
+    if (mComputeSteps) {
+        // Note: our model function returns the number of steps it took...
+
+        startModelTimer();
+            qulonglong stepsCount = mComputeSteps(&pVoi, pVoiEnd, mStep, mConstants, mRates, mStates, mAlgebraic);
+        stopModelTimer(2*stepsCount);
+
+        mStepsCount += stepsCount;
+
+        return;
+    }
+
     double voiStart = pVoi;
 
     int stepNumber = 0;
@@ -84,7 +108,9 @@ void HeunSolver::solve(double &pVoi, const double &pVoiEnd) const
 
         // Compute f(t_n, Y_n)
 
-        mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+        stopModelTimer();
 
         // Compute k and Yk
 
@@ -95,14 +121,18 @@ void HeunSolver::solve(double &pVoi, const double &pVoiEnd) const
 
         // Compute f(t_n + h, Y_n + k)
 
-        mComputeRates(pVoi+realStep, mConstants, mRates, mYk, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi+realStep, mConstants, mRates, mYk, mAlgebraic);
+        stopModelTimer();
 
         // Compute Y_n+1
 
         for (int i = 0; i < mStatesCount; ++i)
             mStates[i] += realHalfStep*(mK[i]+mRates[i]);
 
-        // Advance through time
+        // Keep track of our number of steps and advance through time
+
+        ++mStepsCount;
 
         if (realStep != mStep)
             pVoi = pVoiEnd;
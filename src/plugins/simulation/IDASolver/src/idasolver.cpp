@@ -8,6 +8,7 @@
 
 #include "ida/ida.h"
 #include "ida/ida_dense.h"
+#include "ida/ida_direct.h"
 #include "ida/ida_impl.h"
 
 //==============================================================================
@@ -32,13 +33,15 @@ int residualFunction(double pVoi, N_Vector pStates, N_Vector pRates,
     double *rates     = N_VGetArrayPointer(pRates);
     double *residuals = N_VGetArrayPointer(pResiduals);
 
-    userData->computeEssentialVariables()(pVoi, userData->constants(), rates,
-                                          states, userData->algebraic(),
-                                          userData->condVar());
+    userData->solver()->startModelTimer();
+        userData->computeEssentialVariables()(pVoi, userData->constants(), rates,
+                                              states, userData->algebraic(),
+                                              userData->condVar());
 
-    userData->computeResiduals()(pVoi, userData->constants(), rates, states,
-                                 userData->algebraic(), userData->condVar(),
-                                 residuals);
+        userData->computeResiduals()(pVoi, userData->constants(), rates, states,
+                                     userData->algebraic(), userData->condVar(),
+                                     residuals);
+    userData->solver()->stopModelTimer();
 
     // Everything went fine, so...
 
@@ -54,10 +57,12 @@ int rootFindingFunction(double pVoi, N_Vector pStates, N_Vector pRates,
 
     IdaSolverUserData *userData = static_cast<IdaSolverUserData *>(pUserData);
 
-    userData->computeRootInformation()(pVoi, userData->constants(),
-                                       N_VGetArrayPointer(pRates),
-                                       N_VGetArrayPointer(pStates),
-                                       userData->algebraic(), pRoots);
+    userData->solver()->startModelTimer();
+        userData->computeRootInformation()(pVoi, userData->constants(),
+                                           N_VGetArrayPointer(pRates),
+                                           N_VGetArrayPointer(pStates),
+                                           userData->algebraic(), pRoots);
+    userData->solver()->stopModelTimer();
 
     // Everything went fine, so...
 
@@ -80,10 +85,12 @@ void errorHandler(int pErrorCode, const char *pModule, const char *pFunction,
 
 //==============================================================================
 
-IdaSolverUserData::IdaSolverUserData(double *pConstants, double *pAlgebraic, double *pCondVar,
+IdaSolverUserData::IdaSolverUserData(IdaSolver *pSolver,
+                                     double *pConstants, double *pAlgebraic, double *pCondVar,
                                      CoreSolver::CoreDaeSolver::ComputeEssentialVariablesFunction pComputeEssentialVariables,
                                      CoreSolver::CoreDaeSolver::ComputeResidualsFunction pComputeResiduals,
                                      CoreSolver::CoreDaeSolver::ComputeRootInformationFunction pComputeRootInformation) :
+    mSolver(pSolver),
     mConstants(pConstants),
     mAlgebraic(pAlgebraic),
     mCondVar(pCondVar),
@@ -95,6 +102,15 @@ IdaSolverUserData::IdaSolverUserData(double *pConstants, double *pAlgebraic, dou
 
 //==============================================================================
 
+IdaSolver * IdaSolverUserData::solver() const
+{
+    // Return our solver
+
+    return mSolver;
+}
+
+//==============================================================================
+
 double * IdaSolverUserData::constants() const
 {
     // Return our constants array
@@ -157,7 +173,8 @@ IdaSolver::IdaSolver() :
     mMaximumStep(DefaultMaximumStep),
     mMaximumNumberOfSteps(DefaultMaximumNumberOfSteps),
     mRelativeTolerance(DefaultRelativeTolerance),
-    mAbsoluteTolerance(DefaultAbsoluteTolerance)
+    mAbsoluteTolerance(DefaultAbsoluteTolerance),
+    mPreviousStatistics(OpenCOR::CoreSolver::Statistics())
 {
 }
 
@@ -268,7 +285,7 @@ void IdaSolver::initialize(const double &pVoiStart, const double &pVoiEnd,
 
         delete mUserData;   // Just in case the solver got initialised before
 
-        mUserData = new IdaSolverUserData(pConstants, pAlgebraic, pCondVar,
+        mUserData = new IdaSolverUserData(this, pConstants, pAlgebraic, pCondVar,
                                           pComputeEssentialVariables,
                                           pComputeResiduals,
                                           pComputeRootInformation);
@@ -309,7 +326,10 @@ void IdaSolver::initialize(const double &pVoiStart, const double &pVoiEnd,
 
         delete[] id;
     } else {
-        // Reinitialise the IDA object
+        // Reinitialise the IDA object, after keeping track of its statistics
+        // since they are about to be reset
+
+        addStatistics(mPreviousStatistics, idaStatistics());
 
         IDAReInit(mSolver, pVoiStart, mStatesVector, mRatesVector);
 
@@ -331,6 +351,58 @@ void IdaSolver::solve(double &pVoi, const double &pVoiEnd) const
 
 //==============================================================================
 
+CoreSolver::Statistics IdaSolver::idaStatistics() const
+{
+    // Return the statistics that IDA has kept track of since it was last
+    // (re)initialised
+    // Note #1: we use a Newton iteration, so each of its iterations involves
+    //          one linear solve...
+    // Note #2: we keep track of the number of residual evaluations ourselves
+    //          (see residualFunction()), so we don't need IDA's...
+
+    OpenCOR::CoreSolver::Statistics res = OpenCOR::CoreSolver::Statistics();
+
+    if (!mSolver)
+        return res;
+
+    long int stepsCount;
+    long int jacobianEvaluationsCount;
+    long int linearSolvesCount;
+    long int errorTestFailuresCount;
+    long int convergenceFailuresCount;
+
+    IDAGetNumSteps(mSolver, &stepsCount);
+    IDADlsGetNumJacEvals(mSolver, &jacobianEvaluationsCount);
+    IDAGetNumNonlinSolvIters(mSolver, &linearSolvesCount);
+    IDAGetNumErrTestFails(mSolver, &errorTestFailuresCount);
+    IDAGetNumNonlinSolvConvFails(mSolver, &convergenceFailuresCount);
+
+    res.insert(OpenCOR::CoreSolver::StepsStatistic, qulonglong(stepsCount));
+    res.insert(OpenCOR::CoreSolver::JacobianEvaluationsStatistic, qulonglong(jacobianEvaluationsCount));
+    res.insert(OpenCOR::CoreSolver::LinearSolvesStatistic, qulonglong(linearSolvesCount));
+    res.insert(OpenCOR::CoreSolver::ErrorTestFailuresStatistic, qulonglong(errorTestFailuresCount));
+    res.insert(OpenCOR::CoreSolver::ConvergenceFailuresStatistic, qulonglong(convergenceFailuresCount));
+
+    return res;
+}
+
+//==============================================================================
+
+CoreSolver::Statistics IdaSolver::statistics() const
+{
+    // Return our statistics, i.e. the ones we keep track of ourselves and the
+    // ones IDA has kept track of, including before it was last reinitialised
+
+    OpenCOR::CoreSolver::Statistics res = OpenCOR::CoreSolver::CoreDaeSolver::statistics();
+
+    addStatistics(res, mPreviousStatistics);
+    addStatistics(res, idaStatistics());
+
+    return res;
+}
+
+//==============================================================================
+
 }   // namespace IDASolver
 }   // namespace OpenCOR
 
@@ -44,14 +44,21 @@ static const double DefaultAbsoluteTolerance = 1.0e-7;
 
 //==============================================================================
 
+class IdaSolver;
+
+//==============================================================================
+
 class IdaSolverUserData
 {
 public:
-    explicit IdaSolverUserData(double *pConstants, double *pAlgebraic, double *pCondVar,
+    explicit IdaSolverUserData(IdaSolver *pSolver,
+                               double *pConstants, double *pAlgebraic, double *pCondVar,
                                CoreSolver::CoreDaeSolver::ComputeEssentialVariablesFunction pComputeEssentialVariables,
                                CoreSolver::CoreDaeSolver::ComputeResidualsFunction pComputeResiduals,
                                CoreSolver::CoreDaeSolver::ComputeRootInformationFunction pComputeRootInformation);
 
+    IdaSolver * solver() const;
+
     double * constants() const;
     double * algebraic() const;
     double * condVar() const;
@@ -61,6 +68,8 @@ public:
     CoreSolver::CoreDaeSolver::ComputeRootInformationFunction computeRootInformation() const;
 
 private:
+    IdaSolver *mSolver;
+
     double *mConstants;
     double *mAlgebraic;
     double *mCondVar;
@@ -89,6 +98,8 @@ public:
 
     virtual void solve(double &pVoi, const double &pVoiEnd) const;
 
+    virtual OpenCOR::CoreSolver::Statistics statistics() const;
+
 private:
     void *mSolver;
     N_Vector mStatesVector;
@@ -99,6 +110,10 @@ private:
     int mMaximumNumberOfSteps;
     double mRelativeTolerance;
     double mAbsoluteTolerance;
+
+    OpenCOR::CoreSolver::Statistics mPreviousStatistics;
+
+    OpenCOR::CoreSolver::Statistics idaStatistics() const;
 };
 
 //==============================================================================
@@ -8,6 +8,7 @@
 
 #include "kinsol/kinsol.h"
 #include "kinsol/kinsol_dense.h"
+#include "kinsol/kinsol_direct.h"
 
 //==============================================================================
 
@@ -22,9 +23,11 @@ int systemFunction(N_Vector pY, N_Vector pF, void *pUserData)
 
     KinsolSolverUserData *userData = static_cast<KinsolSolverUserData *>(pUserData);
 
-    userData->computeSystem()(N_VGetArrayPointer_Serial(pY),
-                              N_VGetArrayPointer_Serial(pF),
-                              userData->userData());
+    userData->solver()->startModelTimer();
+        userData->computeSystem()(N_VGetArrayPointer_Serial(pY),
+                                  N_VGetArrayPointer_Serial(pF),
+                                  userData->userData());
+    userData->solver()->stopModelTimer();
 
     // Everything went fine, so...
 
@@ -47,8 +50,10 @@ void errorHandler(int pErrorCode, const char *pModule, const char *pFunction,
 
 //==============================================================================
 
-KinsolSolverUserData::KinsolSolverUserData(void *pUserData,
+KinsolSolverUserData::KinsolSolverUserData(KinsolSolver *pSolver,
+                                           void *pUserData,
                                            CoreSolver::CoreNlaSolver::ComputeSystemFunction pComputeSystem) :
+    mSolver(pSolver),
     mUserData(pUserData),
     mComputeSystem(pComputeSystem)
 {
@@ -56,6 +61,15 @@ KinsolSolverUserData::KinsolSolverUserData(void *pUserData,
 
 //==============================================================================
 
+KinsolSolver * KinsolSolverUserData::solver() const
+{
+    // Return our solver
+
+    return mSolver;
+}
+
+//==============================================================================
+
 void * KinsolSolverUserData::userData() const
 {
     // Return our user data
@@ -78,7 +92,9 @@ KinsolSolver::KinsolSolver() :
     mSolver(0),
     mParametersVector(0),
     mOnesVector(0),
-    mUserData(0)
+    mUserData(0),
+    mConvergenceFailuresCount(0),
+    mPreviousStatistics(OpenCOR::CoreSolver::Statistics())
 {
 }
 
@@ -100,12 +116,19 @@ void KinsolSolver::reset()
 
         return;
 
+    // Keep track of our statistics since we are about to lose them
+
+    addStatistics(mPreviousStatistics, kinsolStatistics());
+
     N_VDestroy_Serial(mParametersVector);
     N_VDestroy_Serial(mOnesVector);
 
     KINFree(&mSolver);
 
     delete mUserData;
+
+    mSolver = 0;
+    mUserData = 0;
 }
 
 //==============================================================================
@@ -143,7 +166,7 @@ void KinsolSolver::initialize(ComputeSystemFunction pComputeSystem,
 
     // Set some user data
 
-    mUserData = new KinsolSolverUserData(pUserData, pComputeSystem);
+    mUserData = new KinsolSolverUserData(this, pUserData, pComputeSystem);
 
     KINSetUserData(mSolver, mUserData);
 
@@ -156,9 +179,56 @@ void KinsolSolver::initialize(ComputeSystemFunction pComputeSystem,
 
 void KinsolSolver::solve() const
 {
-    // Solve the linear system
+    // Solve the linear system and keep track of whether it failed to converge
+
+    if (KINSol(mSolver, mParametersVector, KIN_LINESEARCH, mOnesVector, mOnesVector) < 0)
+        ++mConvergenceFailuresCount;
+}
+
+//==============================================================================
+
+CoreSolver::Statistics KinsolSolver::kinsolStatistics() const
+{
+    // Return the statistics that KINSOL has kept track of since it was last
+    // initialised
+    // Note #1: we use a Newton iteration, so each of its iterations involves
+    //          one linear solve...
+    // Note #2: we keep track of the number of system evaluations ourselves (see
+    //          systemFunction()), so we don't need KINSOL's...
+
+    OpenCOR::CoreSolver::Statistics res = OpenCOR::CoreSolver::Statistics();
+
+    if (!mSolver)
+        return res;
+
+    long int jacobianEvaluationsCount;
+    long int linearSolvesCount;
+
+    KINDlsGetNumJacEvals(mSolver, &jacobianEvaluationsCount);
+    KINGetNumNonlinSolvIters(mSolver, &linearSolvesCount);
+
+    res.insert(OpenCOR::CoreSolver::JacobianEvaluationsStatistic, qulonglong(jacobianEvaluationsCount));
+    res.insert(OpenCOR::CoreSolver::LinearSolvesStatistic, qulonglong(linearSolvesCount));
+
+    return res;
+}
+
+//==============================================================================
+
+CoreSolver::Statistics KinsolSolver::statistics() const
+{
+    // Return our statistics, i.e. the ones we keep track of ourselves and the
+    // ones KINSOL has kept track of, including for the systems it solved before
+    // the current one (we get reinitialised for every system we have to solve)
+
+    OpenCOR::CoreSolver::Statistics res = OpenCOR::CoreSolver::CoreNlaSolver::statistics();
+
+    addStatistics(res, mPreviousStatistics);
+    addStatistics(res, kinsolStatistics());
+
+    res.insert(OpenCOR::CoreSolver::ConvergenceFailuresStatistic, mConvergenceFailuresCount);
 
-    KINSol(mSolver, mParametersVector, KIN_LINESEARCH, mOnesVector, mOnesVector);
+    return res;
 }
 
 //==============================================================================
@@ -20,17 +20,25 @@ namespace KINSOLSolver {
 
 //==============================================================================
 
+class KinsolSolver;
+
+//==============================================================================
+
 class KinsolSolverUserData
 {
 public:
-    explicit KinsolSolverUserData(void *pUserData,
+    explicit KinsolSolverUserData(KinsolSolver *pSolver, void *pUserData,
                                   CoreSolver::CoreNlaSolver::ComputeSystemFunction pComputeSystem);
 
+    KinsolSolver * solver() const;
+
     void * userData() const;
 
     CoreSolver::CoreNlaSolver::ComputeSystemFunction computeSystem() const;
 
 private:
+    KinsolSolver *mSolver;
+
     void *mUserData;
 
     CoreSolver::CoreNlaSolver::ComputeSystemFunction mComputeSystem;
@@ -49,13 +57,21 @@ public:
 
     virtual void solve() const;
 
+    virtual OpenCOR::CoreSolver::Statistics statistics() const;
+
 private:
     void *mSolver;
     N_Vector mParametersVector;
     N_Vector mOnesVector;
     KinsolSolverUserData *mUserData;
 
+    mutable qulonglong mConvergenceFailuresCount;
+
+    OpenCOR::CoreSolver::Statistics mPreviousStatistics;
+
     void reset();
+
+    OpenCOR::CoreSolver::Statistics kinsolStatistics() const;
 };
 
 //==============================================================================
@@ -60,11 +60,35 @@ void MidpointSolver::initialize(const double &pVoiStart,
 
 //==============================================================================
 
+QString MidpointSolver::computeStepsFunctionName() const
+{
+    // Return the name of the model function which computes several steps of
+    // our solver in one go
+
+    return "computeMidpointSteps";
+}
+
+//==============================================================================
+
 void MidpointSolver::solve(double &pVoi, const double &pVoiEnd) const
 {
     // k = h / 2 * f(t_n, Y_n)
     // Y_n+1 = Y_n + h * f(t_n + h / 2, Y_n + k))
 
+    // Compute all of our steps in one go, if our model has a function to do so
+
+    if (mComputeSteps) {
+        // Note: our model function returns the number of steps it took...
+
+        startModelTimer();
+            qulonglong stepsCount = mComputeSteps(&pVoi, pVoiEnd, mStep, mConstants, mRates, mStates, mAlgebraic);
+        stopModelTimer(2*stepsCount);
+
+        mStepsCount += stepsCount;
+
+        return;
+    }
+
     double voiStart = pVoi;
 
     int stepNumber = 0;
@@ -81,7 +105,9 @@ void MidpointSolver::solve(double &pVoi, const double &pVoiEnd) const
 
         // Compute f(t_n, Y_n)
 
-        mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+        stopModelTimer();
 
         // Compute Yk
 
@@ -90,14 +116,18 @@ void MidpointSolver::solve(double &pVoi, const double &pVoiEnd) const
 
         // Compute f(t_n + h / 2, Y_n + k)
 
-        mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk, mAlgebraic);
+        stopModelTimer();
 
         // Compute Y_n+1
 
         for (int i = 0; i < mStatesCount; ++i)
             mStates[i] += realStep*(mRates[i]);
 
-        // Advance through time
+        // Keep track of our number of steps and advance through time
+
+        ++mStepsCount;
 
         if (realStep != mStep)
             pVoi = pVoiEnd;
@@ -66,6 +66,16 @@ void SecondOrderRungeKuttaSolver::initialize(const double &pVoiStart,
 
 //==============================================================================
 
+QString SecondOrderRungeKuttaSolver::computeStepsFunctionName() const
+{
+    // Return the name of the model function which computes several steps of
+    // our solver in one go
+
+    return "computeSecondOrderRungeKuttaSteps";
+}
+
+//==============================================================================
+
 void SecondOrderRungeKuttaSolver::solve(double &pVoi,
                                         const double &pVoiEnd) const
 {
@@ -76,6 +86,20 @@ void SecondOrderRungeKuttaSolver::solve(double &pVoi,
     // Note: the algorithm hereafter doesn't compute k1 and k2 as such and this
     //       simply for performance reasons...
 
+    // Compute all of our steps in one go, if our model has a function to do so
+
+    if (mComputeSteps) {
+        // Note: our model function returns the number of steps it took...
+
+        startModelTimer();
+            qulonglong stepsCount = mComputeSteps(&pVoi, pVoiEnd, mStep, mConstants, mRates, mStates, mAlgebraic);
+        stopModelTimer(2*stepsCount);
+
+        mStepsCount += stepsCount;
+
+        return;
+    }
+
     double voiStart = pVoi;
 
     int stepNumber = 0;
@@ -92,7 +116,9 @@ void SecondOrderRungeKuttaSolver::solve(double &pVoi,
 
         // Compute f(t_n, Y_n)
 
-        mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi, mConstants, mRates, mStates, mAlgebraic);
+        stopModelTimer();
 
         // Compute k1 and therefore Yk1
 
@@ -101,14 +127,18 @@ void SecondOrderRungeKuttaSolver::solve(double &pVoi,
 
         // Compute f(t_n + h / 2, Y_n + k1 / 2)
 
-        mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk1, mAlgebraic);
+        startModelTimer();
+            mComputeRates(pVoi+realHalfStep, mConstants, mRates, mYk1, mAlgebraic);
+        stopModelTimer();
 
         // Compute Y_n+1
 
         for (int i = 0; i < mStatesCount; ++i)
             mStates[i] += realStep*mRates[i];
 
-        // Advance through time
+        // Keep track of our number of steps and advance through time
+
+        ++mStepsCount;
 
         if (realStep != mStep)
             pVoi = pVoiEnd;
@@ -0,0 +1,274 @@
+//==============================================================================
+// Single cell simulation view CSV exporter
+//==============================================================================
+
+#include "singlecellsimulationviewcsvexporter.h"
+
+//==============================================================================
+
+#include <QFile>
+#include <QRunnable>
+#include <QTextCodec>
+#include <QThread>
+#include <QThreadPool>
+
+//==============================================================================
+
+#include <qnumeric.h>
+
+//==============================================================================
+
+#include <clocale>
+#include <cstdio>
+#include <cstring>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+class SingleCellSimulationViewCsvExporterRows : public QRunnable
+{
+public:
+    explicit SingleCellSimulationViewCsvExporterRows(const QVector<const double *> &pColumns,
+                                                     const qulonglong &pMaximumRowsCount);
+    ~SingleCellSimulationViewCsvExporterRows();
+
+    void setRows(const qulonglong &pFrom, const qulonglong &pTo);
+
+    virtual void run();
+
+    const char * buffer() const;
+    qint64 bufferSize() const;
+
+private:
+    const QVector<const double *> &mColumns;
+
+    qulonglong mFrom;
+    qulonglong mTo;
+
+    char *mBuffer;
+    qint64 mBufferSize;
+};
+
+//==============================================================================
+
+SingleCellSimulationViewCsvExporterRows::SingleCellSimulationViewCsvExporterRows(const QVector<const double *> &pColumns,
+                                                                                 const qulonglong &pMaximumRowsCount) :
+    mColumns(pColumns),
+    mFrom(0),
+    mTo(0),
+    mBufferSize(0)
+{
+    // We are to be run several times, so we shouldn't be deleted by our thread
+    // pool
+
+    setAutoDelete(false);
+
+    // Create our buffer, which is big enough for our maximum number of rows
+    // (i.e. each value followed by either a comma or a new line)
+
+    mBuffer = new char[pMaximumRowsCount*pColumns.count()*(SingleCellSimulationViewCsvExporter::MaximumValueSize+1)];
+}
+
+//==============================================================================
+
+SingleCellSimulationViewCsvExporterRows::~SingleCellSimulationViewCsvExporterRows()
+{
+    // Delete some internal objects
+
+    delete[] mBuffer;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewCsvExporterRows::setRows(const qulonglong &pFrom,
+                                                      const qulonglong &pTo)
+{
+    // Set the rows that we are to format
+
+    mFrom = pFrom;
+    mTo = pTo;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewCsvExporterRows::run()
+{
+    // Format our rows into our buffer
+
+    char *buffer = mBuffer;
+
+    for (qulonglong i = mFrom; i < mTo; ++i) {
+        for (int j = 0, jMax = mColumns.count(); j < jMax; ++j) {
+            if (j)
+                *buffer++ = ',';
+
+            buffer += SingleCellSimulationViewCsvExporter::formatValue(mColumns[j][i], buffer);
+        }
+
+        *buffer++ = '\n';
+    }
+
+    mBufferSize = buffer-mBuffer;
+}
+
+//==============================================================================
+
+const char * SingleCellSimulationViewCsvExporterRows::buffer() const
+{
+    // Return our buffer
+
+    return mBuffer;
+}
+
+//==============================================================================
+
+qint64 SingleCellSimulationViewCsvExporterRows::bufferSize() const
+{
+    // Return the size of our formatted rows
+
+    return mBufferSize;
+}
+
+//==============================================================================
+
+SingleCellSimulationViewCsvExporter::SingleCellSimulationViewCsvExporter(const QString &pHeader,
+                                                                         const QVector<const double *> &pColumns,
+                                                                         const qulonglong &pSize) :
+    mHeader(pHeader),
+    mColumns(pColumns),
+    mSize(pSize)
+{
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewCsvExporter::formatValue(const double &pValue,
+                                                     char *pBuffer)
+{
+    // Format the given value the way QTextStream does by default (i.e. using
+    // the C locale, 'g' notation and a precision of 6), returning the number
+    // of characters that were written to the given buffer
+    // Note: snprintf() uses the current C locale for its decimal point, which
+    //       Qt sets from the environment, so we may need to replace it...
+
+    if (qIsNaN(pValue)) {
+        memcpy(pBuffer, "nan", 3);
+
+        return 3;
+    }
+
+    int res = snprintf(pBuffer, MaximumValueSize, "%g", pValue);
+
+    const char *decimalPoint = localeconv()->decimal_point;
+
+    if ((decimalPoint[0] != '.') || decimalPoint[1]) {
+        int decimalPointSize = strlen(decimalPoint);
+        char *decimalPointPosition = strstr(pBuffer, decimalPoint);
+
+        if (decimalPointPosition) {
+            *decimalPointPosition = '.';
+
+            memmove(decimalPointPosition+1,
+                    decimalPointPosition+decimalPointSize,
+                    res-(decimalPointPosition-pBuffer)-decimalPointSize+1);
+
+            res -= decimalPointSize-1;
+        }
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewCsvExporter::exportTo(const QString &pFileName) const
+{
+    // Export our data to the given file
+
+    QFile file(pFileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        // The file can't be opened, so...
+
+        file.remove();
+
+        return false;
+    }
+
+    bool res = exportTo(&file);
+
+    file.close();
+
+    return res;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewCsvExporter::exportTo(QIODevice *pDevice) const
+{
+    // Export our data to the given device, starting with our header, which we
+    // encode the way QTextStream would
+
+    QByteArray header = QTextCodec::codecForLocale()->fromUnicode(mHeader+"\n");
+
+    if (pDevice->write(header) != header.size())
+        return false;
+
+    // Format our data, a block of rows at a time, using as many threads as we
+    // have cores, and write it out in order
+    // Note: the number of rows in a block is such that its formatted rows
+    //       never need more than BlockSize bytes, whatever our number of
+    //       columns...
+
+    static const qulonglong BlockSize = 1048576;
+
+    qulonglong maximumRowsCount = qMax(qulonglong(1), BlockSize/(qMax(1, mColumns.count())*(MaximumValueSize+1)));
+    int threadsCount = qMax(1, QThread::idealThreadCount());
+    QVector<SingleCellSimulationViewCsvExporterRows *> rows = QVector<SingleCellSimulationViewCsvExporterRows *>();
+
+    for (int i = 0; i < threadsCount; ++i)
+        rows << new SingleCellSimulationViewCsvExporterRows(mColumns, maximumRowsCount);
+
+    QThreadPool threadPool;
+
+    threadPool.setMaxThreadCount(threadsCount);
+
+    bool res = true;
+
+    for (qulonglong i = 0; res && (i < mSize);) {
+        int rowsCount = 0;
+
+        for (; (rowsCount < threadsCount) && (i < mSize); ++rowsCount) {
+            qulonglong to = qMin(mSize, i+maximumRowsCount);
+
+            rows[rowsCount]->setRows(i, to);
+
+            threadPool.start(rows[rowsCount]);
+
+            i = to;
+        }
+
+        threadPool.waitForDone();
+
+        for (int j = 0; res && (j < rowsCount); ++j)
+            res = pDevice->write(rows[j]->buffer(), rows[j]->bufferSize()) == rows[j]->bufferSize();
+    }
+
+    foreach (SingleCellSimulationViewCsvExporterRows *row, rows)
+        delete row;
+
+    return res;
+}
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,61 @@
+//==============================================================================
+// Single cell simulation view CSV exporter
+//==============================================================================
+
+#ifndef SINGLECELLSIMULATIONVIEWCSVEXPORTER_H
+#define SINGLECELLSIMULATIONVIEWCSVEXPORTER_H
+
+//==============================================================================
+
+#include "singlecellsimulationviewglobal.h"
+
+//==============================================================================
+
+#include <QString>
+#include <QVector>
+
+//==============================================================================
+
+class QIODevice;
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+class SINGLECELLSIMULATIONVIEW_EXPORT SingleCellSimulationViewCsvExporter
+{
+public:
+    explicit SingleCellSimulationViewCsvExporter(const QString &pHeader,
+                                                 const QVector<const double *> &pColumns,
+                                                 const qulonglong &pSize);
+
+    bool exportTo(const QString &pFileName) const;
+    bool exportTo(QIODevice *pDevice) const;
+
+    static int formatValue(const double &pValue, char *pBuffer);
+
+    static const int MaximumValueSize = 32;
+
+private:
+    QString mHeader;
+
+    QVector<const double *> mColumns;
+
+    qulonglong mSize;
+};
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+
+#endif
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,14 @@
+#ifndef SINGLECELLSIMULATIONVIEWGLOBAL_H
+#define SINGLECELLSIMULATIONVIEWGLOBAL_H
+
+#ifdef _WIN32
+    #ifdef SingleCellSimulationView_PLUGIN
+        #define SINGLECELLSIMULATIONVIEW_EXPORT __declspec(dllexport)
+    #else
+        #define SINGLECELLSIMULATIONVIEW_EXPORT __declspec(dllimport)
+    #endif
+#else
+    #define SINGLECELLSIMULATIONVIEW_EXPORT
+#endif
+
+#endif
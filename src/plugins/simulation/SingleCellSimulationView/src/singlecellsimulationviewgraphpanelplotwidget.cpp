@@ -10,6 +10,9 @@
 #include <QClipboard>
 #include <QDesktopWidget>
 #include <QMouseEvent>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QRunnable>
 
 //==============================================================================
 
@@ -17,6 +20,10 @@
 
 //==============================================================================
 
+#include <algorithm>
+
+//==============================================================================
+
 #include <float.h>
 
 //==============================================================================
@@ -37,8 +44,20 @@ namespace SingleCellSimulationView {
 
 //==============================================================================
 
+static const qulonglong PyramidFactor = 8;
+
+//==============================================================================
+
 SingleCellSimulationViewGraphPanelPlotCurve::SingleCellSimulationViewGraphPanelPlotCurve() :
-    QwtPlotCurve()
+    QwtPlotCurve(),
+    mXData(0),
+    mYData(0),
+    mSize(0),
+    mMinX(0.0),
+    mMaxX(0.0),
+    mMinY(0.0),
+    mMaxY(0.0),
+    mPyramid(QList<QVector<qulonglong> >())
 {
     // Customise it a bit
 
@@ -48,11 +67,349 @@ SingleCellSimulationViewGraphPanelPlotCurve::SingleCellSimulationViewGraphPanelP
 
 //==============================================================================
 
+void SingleCellSimulationViewGraphPanelPlotCurve::addToBucket(QVector<qulonglong> &pLevel,
+                                                              const qulonglong &pBucket,
+                                                              const qulonglong &pIndex)
+{
+    // Add the given sample to the given bucket of the given level of our
+    // pyramid, i.e. keep track of the index of the sample, if it is either the
+    // minimum or the maximum Y value of the bucket
+
+    if (qulonglong(pLevel.size()) == 2*pBucket) {
+        pLevel << pIndex << pIndex;
+    } else {
+        if (mYData[pIndex] < mYData[pLevel[2*pBucket]])
+            pLevel[2*pBucket] = pIndex;
+
+        if (mYData[pIndex] > mYData[pLevel[2*pBucket+1]])
+            pLevel[2*pBucket+1] = pIndex;
+    }
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewGraphPanelPlotCurve::setRawSamples(const double *pXData,
+                                                                const double *pYData,
+                                                                int pSize)
+{
+    // Make sure that we are not being rasterised if our data is about to
+    // change, since our rasteriser would otherwise access it (and our
+    // min/max decimation pyramid) while we update it
+
+    SingleCellSimulationViewGraphPanelPlotWidget *plotWidget = static_cast<SingleCellSimulationViewGraphPanelPlotWidget *>(plot());
+
+    if (   plotWidget
+        && ((pXData != mXData) || (pYData != mYData) || (qulonglong(pSize) != mSize)))
+        plotWidget->cancelRasterising();
+
+    // Set our raw samples
+
+    QwtPlotCurve::setRawSamples(pXData, pYData, pSize);
+
+    // Update our min/max decimation pyramid, which level l consists of buckets
+    // of PyramidFactor^(l+1) samples, each of which keeps track of the index of
+    // its minimum and maximum Y values
+    // Note #1: if our data has changed (e.g. we are running a new simulation),
+    //          then we need to start from scratch, otherwise we only need to
+    //          account for our new samples...
+    // Note #2: a level is only created once its first bucket is full, at which
+    //          point we build it from our raw samples. After that, each new
+    //          sample is simply added to the last bucket of each level...
+
+    if ((pXData != mXData) || (pYData != mYData) || (qulonglong(pSize) < mSize)) {
+        mPyramid.clear();
+
+        mSize = 0;
+    }
+
+    mXData = pXData;
+    mYData = pYData;
+
+    if (!mXData || !mYData)
+        return;
+
+    // Update our bounding rectangle, so that it can be retrieved in constant
+    // time
+
+    if ((qulonglong(pSize) > mSize) && !mSize) {
+        mMinX = mMaxX = mXData[0];
+        mMinY = mMaxY = mYData[0];
+    }
+
+    for (qulonglong i = mSize, iMax = pSize; i < iMax; ++i) {
+        mMinX = qMin(mMinX, mXData[i]);
+        mMaxX = qMax(mMaxX, mXData[i]);
+        mMinY = qMin(mMinY, mYData[i]);
+        mMaxY = qMax(mMaxY, mYData[i]);
+    }
+
+    for (qulonglong i = mSize, iMax = pSize; i < iMax; ++i) {
+        qulonglong bucketSize = PyramidFactor;
+
+        for (int j = 0; ; ++j, bucketSize *= PyramidFactor)
+            if (j == mPyramid.count()) {
+                if (i+1 < bucketSize)
+                    break;
+
+                mPyramid << QVector<qulonglong>();
+
+                for (qulonglong k = 0; k <= i; ++k)
+                    addToBucket(mPyramid[j], k/bucketSize, k);
+            } else {
+                addToBucket(mPyramid[j], i/bucketSize, i);
+            }
+    }
+
+    mSize = pSize;
+}
+
+//==============================================================================
+
+QRectF SingleCellSimulationViewGraphPanelPlotCurve::boundingRect() const
+{
+    // Return our bounding rectangle, which we keep track of as samples get
+    // added to us
+
+    if (!mSize)
+        return QRectF(1.0, 1.0, -2.0, -2.0);
+        // Note: this is what QwtPlotCurve returns for no data...
+
+    return QRectF(mMinX, mMinY, mMaxX-mMinX, mMaxY-mMinY);
+}
+
+//==============================================================================
+
+QRectF SingleCellSimulationViewGraphPanelPlotCurve::boundingRect(const qulonglong &pFrom,
+                                                                 const qulonglong &pTo) const
+{
+    // Return the bounding rectangle of the given range of samples, scanning
+    // our X and Y arrays directly rather than through our (virtual) sample()
+    // method
+
+    if (!mXData || !mYData || (pFrom > pTo) || (pTo >= mSize))
+        return QRectF(1.0, 1.0, -2.0, -2.0);
+
+    double minX = mXData[pFrom];
+    double maxX = minX;
+    double minY = mYData[pFrom];
+    double maxY = minY;
+
+    for (qulonglong i = pFrom+1; i <= pTo; ++i) {
+        minX = qMin(minX, mXData[i]);
+        maxX = qMax(maxX, mXData[i]);
+    }
+
+    for (qulonglong i = pFrom+1; i <= pTo; ++i) {
+        minY = qMin(minY, mYData[i]);
+        maxY = qMax(maxY, mYData[i]);
+    }
+
+    return QRectF(minX, minY, maxX-minX, maxY-minY);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewGraphPanelPlotCurve::drawSeries(QPainter *pPainter,
+                                                             const QwtScaleMap &pXMap,
+                                                             const QwtScaleMap &pYMap,
+                                                             const QRectF &pCanvasRect,
+                                                             int pFrom, int pTo) const
+{
+    // Draw our series using the level of our min/max decimation pyramid that
+    // best matches the current zoom level, i.e. with a bucket covering no more
+    // than a pixel, so that the cost of drawing our series depends on the
+    // width of our canvas rather than on the number of samples to draw
+    // Note: each bucket contributes both its minimum and maximum Y values (in
+    //       the order in which they occurred), so spikes are still drawn
+    //       faithfully...
+
+    if (pTo < 0)
+        pTo = dataSize()-1;
+
+    if (mPyramid.isEmpty() || (pFrom >= pTo) || (qulonglong(pTo) >= mSize)) {
+        QwtPlotCurve::drawSeries(pPainter, pXMap, pYMap, pCanvasRect, pFrom, pTo);
+
+        return;
+    }
+
+    // Only consider the samples which are visible, assuming that our X values
+    // are increasing, as is the case with our simulation results
+
+    qulonglong from = pFrom;
+    qulonglong to = pTo;
+
+    if (mXData[to] > mXData[from]) {
+        double xMin = qMin(pXMap.s1(), pXMap.s2());
+        double xMax = qMax(pXMap.s1(), pXMap.s2());
+
+        from = qMax(qulonglong(pFrom), qulonglong(std::lower_bound(mXData+from, mXData+to+1, xMin)-mXData));
+        to   = qMin(qulonglong(pTo),   qulonglong(std::upper_bound(mXData+from, mXData+to+1, xMax)-mXData));
+
+        if (from)
+            --from;
+
+        if (from >= to) {
+            QwtPlotCurve::drawSeries(pPainter, pXMap, pYMap, pCanvasRect, from, to);
+
+            return;
+        }
+    }
+
+    // Determine the level of our pyramid that we should use, if any
+
+    double pixels = qAbs(pXMap.transform(mXData[to])-pXMap.transform(mXData[from]));
+    double samplesPerPixel = (to-from)/qMax(1.0, pixels);
+    int level = -1;
+    qulonglong bucketSize = PyramidFactor;
+
+    while ((level+1 < mPyramid.count()) && (bucketSize <= samplesPerPixel)) {
+        ++level;
+
+        bucketSize *= PyramidFactor;
+    }
+
+    bucketSize /= PyramidFactor;
+
+    qulonglong firstBucket = (from+bucketSize-1)/bucketSize;
+    qulonglong lastBucket = (to+1)/bucketSize;
+
+    if ((level == -1) || (firstBucket >= lastBucket)) {
+        QwtPlotCurve::drawSeries(pPainter, pXMap, pYMap, pCanvasRect, from, to);
+
+        return;
+    }
+
+    // Build our decimated polyline, using our raw samples before our first
+    // bucket and after our last one
+
+    const QVector<qulonglong> &buckets = mPyramid.at(level);
+    QPolygonF polyline;
+
+    for (qulonglong i = from, iMax = firstBucket*bucketSize; i < iMax; ++i)
+        polyline << QPointF(pXMap.transform(mXData[i]), pYMap.transform(mYData[i]));
+
+    for (qulonglong i = firstBucket; i < lastBucket; ++i) {
+        qulonglong minIndex = buckets.at(2*i);
+        qulonglong maxIndex = buckets.at(2*i+1);
+        qulonglong firstIndex = qMin(minIndex, maxIndex);
+        qulonglong lastIndex = qMax(minIndex, maxIndex);
+
+        polyline << QPointF(pXMap.transform(mXData[firstIndex]), pYMap.transform(mYData[firstIndex]));
+
+        if (lastIndex != firstIndex)
+            polyline << QPointF(pXMap.transform(mXData[lastIndex]), pYMap.transform(mYData[lastIndex]));
+    }
+
+    for (qulonglong i = lastBucket*bucketSize; i <= to; ++i)
+        polyline << QPointF(pXMap.transform(mXData[i]), pYMap.transform(mYData[i]));
+
+    // Draw our decimated polyline
+
+    pPainter->save();
+    pPainter->setPen(pen());
+
+    QwtPainter::drawPolyline(pPainter, polyline);
+
+    pPainter->restore();
+}
+
+//==============================================================================
+
 static const double MinZoomFactor =    1.0;
 static const double MaxZoomFactor = 1024.0;
 
 //==============================================================================
 
+static const qulonglong MinRasterisingSamplesCount = 65536;
+
+//==============================================================================
+
+class SingleCellSimulationViewGraphPanelPlotCurveRasteriser : public QRunnable
+{
+public:
+    explicit SingleCellSimulationViewGraphPanelPlotCurveRasteriser(SingleCellSimulationViewGraphPanelPlotWidget *pPlot,
+                                                                   SingleCellSimulationViewGraphPanelPlotCurve *pCurve,
+                                                                   const int &pGeneration,
+                                                                   const int &pIndex,
+                                                                   const QwtScaleMap &pXMap,
+                                                                   const QwtScaleMap &pYMap,
+                                                                   const QRectF &pCanvasRect);
+
+    virtual void run();
+
+private:
+    SingleCellSimulationViewGraphPanelPlotWidget *mPlot;
+    SingleCellSimulationViewGraphPanelPlotCurve *mCurve;
+
+    int mGeneration;
+    int mIndex;
+
+    QwtScaleMap mXMap;
+    QwtScaleMap mYMap;
+
+    QRectF mCanvasRect;
+};
+
+//==============================================================================
+
+SingleCellSimulationViewGraphPanelPlotCurveRasteriser::SingleCellSimulationViewGraphPanelPlotCurveRasteriser(SingleCellSimulationViewGraphPanelPlotWidget *pPlot,
+                                                                                                             SingleCellSimulationViewGraphPanelPlotCurve *pCurve,
+                                                                                                             const int &pGeneration,
+                                                                                                             const int &pIndex,
+                                                                                                             const QwtScaleMap &pXMap,
+                                                                                                             const QwtScaleMap &pYMap,
+                                                                                                             const QRectF &pCanvasRect) :
+    mPlot(pPlot),
+    mCurve(pCurve),
+    mGeneration(pGeneration),
+    mIndex(pIndex),
+    mXMap(pXMap),
+    mYMap(pYMap),
+    mCanvasRect(pCanvasRect)
+{
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewGraphPanelPlotCurveRasteriser::run()
+{
+    // Make sure that our frame is still current, i.e. that our plot hasn't
+    // been panned, zoomed, resized, etc. since we were queued
+
+    mPlot->mRasterisingMutex.lock();
+
+    bool staleFrame = mGeneration != mPlot->mRasterisingGeneration;
+
+    mPlot->mRasterisingMutex.unlock();
+
+    if (staleFrame)
+        return;
+
+    // Rasterise our curve into a transparent off-screen image, which our plot
+    // will then composite on top of its grid
+
+    QImage image(mCanvasRect.size().toSize(), QImage::Format_ARGB32_Premultiplied);
+
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+
+    painter.translate(-mCanvasRect.topLeft());
+
+    if (mCurve->testRenderHint(QwtPlotItem::RenderAntialiased))
+        painter.setRenderHint(QPainter::Antialiasing, true);
+
+    mCurve->draw(&painter, mXMap, mYMap, mCanvasRect);
+
+    painter.end();
+
+    // Let our plot know that our curve has been rasterised
+
+    mPlot->curveRasterised(mGeneration, mIndex, image);
+}
+
+//==============================================================================
+
 SingleCellSimulationViewGraphPanelPlotWidget::SingleCellSimulationViewGraphPanelPlotWidget(QWidget *pParent) :
     QwtPlot(pParent),
     mCurves(QList<SingleCellSimulationViewGraphPanelPlotCurve *>()),
@@ -68,7 +425,19 @@ SingleCellSimulationViewGraphPanelPlotWidget::SingleCellSimulationViewGraphPanel
     mFixedAxisY(false),
     mCanvasPixmap(QPixmap()),
     mCanvasMapX(QwtScaleMap()),
-    mCanvasMapY(QwtScaleMap())
+    mCanvasMapY(QwtScaleMap()),
+    mRasterisingGeneration(0),
+    mRasterisingKey(QString()),
+    mRasterisingMapX(QwtScaleMap()),
+    mRasterisingMapY(QwtScaleMap()),
+    mRasterisingCanvasRect(QRectF()),
+    mRasterisedCurves(QVector<QImage>()),
+    mRasterisedCurvesCount(0),
+    mRasterisedKey(QString()),
+    mRasterisedMapX(QwtScaleMap()),
+    mRasterisedMapY(QwtScaleMap()),
+    mRasterisedCanvasRect(QRectF()),
+    mRasterisedImage(QImage())
 {
     // Get ourselves a direct painter
 
@@ -108,6 +477,10 @@ SingleCellSimulationViewGraphPanelPlotWidget::SingleCellSimulationViewGraphPanel
 
 SingleCellSimulationViewGraphPanelPlotWidget::~SingleCellSimulationViewGraphPanelPlotWidget()
 {
+    // Make sure that none of our curves is still being rasterised
+
+    cancelRasterising();
+
     // Delete some internal objects
 
     delete mDirectPainter;
@@ -409,8 +782,14 @@ void SingleCellSimulationViewGraphPanelPlotWidget::setFixedAxisY(const bool &pFi
 void SingleCellSimulationViewGraphPanelPlotWidget::setInteractive(const bool &pInteractive)
 {
     // Specify whether interaction is allowed
+    // Note: interaction is not allowed while a simulation is running, in which
+    //       case our curves' data is going to change, so any rasterising of
+    //       them must be cancelled...
 
     mInteractive = pInteractive;
+
+    if (!mInteractive)
+        cancelRasterising();
 }
 
 //==============================================================================
@@ -1124,7 +1503,23 @@ void SingleCellSimulationViewGraphPanelPlotWidget::drawCanvas(QPainter *pPainter
         break;
     }
     default:
-        // We aren't doing anything special, so just draw our canvas normally
+        // We aren't doing anything special, so just draw our canvas normally,
+        // unless our curves are static and big enough for them to be worth
+        // rasterising in the background
+
+        if (mInteractive) {
+            qulonglong samplesCount = 0;
+
+            foreach (SingleCellSimulationViewGraphPanelPlotCurve *curve, mCurves)
+                if (curve->isVisible())
+                    samplesCount += curve->dataSize();
+
+            if (samplesCount >= MinRasterisingSamplesCount) {
+                drawItemsInBackground(pPainter);
+
+                break;
+            }
+        }
 
         QwtPlot::drawCanvas(pPainter);
     }
@@ -1132,6 +1527,206 @@ void SingleCellSimulationViewGraphPanelPlotWidget::drawCanvas(QPainter *pPainter
 
 //==============================================================================
 
+void SingleCellSimulationViewGraphPanelPlotWidget::drawItemsInBackground(QPainter *pPainter)
+{
+    // Retrieve our canvas maps and rectangle
+
+    QwtScaleMap maps[axisCnt];
+
+    for (int axisId = 0; axisId < axisCnt; ++axisId)
+        maps[axisId] = canvasMap(axisId);
+
+    QRectF canvasRect = canvas()->contentsRect();
+
+    // Draw all our items, except our curves, i.e. our grid
+
+    foreach (QwtPlotItem *item, itemList())
+        if (   item->isVisible()
+            && (item->rtti() != QwtPlotItem::Rtti_PlotCurve)) {
+            pPainter->save();
+
+            pPainter->setRenderHint(QPainter::Antialiasing,
+                                    item->testRenderHint(QwtPlotItem::RenderAntialiased));
+
+            item->draw(pPainter, maps[item->xAxis()], maps[item->yAxis()],
+                       canvasRect);
+
+            pPainter->restore();
+        }
+
+    // Determine the key of our current frame, i.e. what our rasterised curves
+    // depend on
+
+    QString rasterisingKey = QString("%1|%2|%3|%4|%5|%6").arg(QString::number(canvasRect.width()),
+                                                                QString::number(canvasRect.height()),
+                                                                QString::number(maps[QwtPlot::xBottom].s1(), 'g', 17),
+                                                                QString::number(maps[QwtPlot::xBottom].s2(), 'g', 17),
+                                                                QString::number(maps[QwtPlot::yLeft].s1(), 'g', 17),
+                                                                QString::number(maps[QwtPlot::yLeft].s2(), 'g', 17));
+
+    QList<SingleCellSimulationViewGraphPanelPlotCurve *> visibleCurves = QList<SingleCellSimulationViewGraphPanelPlotCurve *>();
+
+    foreach (SingleCellSimulationViewGraphPanelPlotCurve *curve, mCurves)
+        if (curve->isVisible()) {
+            rasterisingKey += QString("|%1:%2:%3").arg(QString::number(quintptr(curve)),
+                                                       QString::number(curve->dataSize()),
+                                                       curve->pen().color().name());
+
+            visibleCurves << curve;
+        }
+
+    // Start rasterising our curves, if our current frame is a new one
+    // Note: if our current frame is the one being rasterised, then we just
+    //       wait for rasterisingFinished() to replot us...
+
+    if (rasterisingKey != mRasterisingKey) {
+        mRasterisingMutex.lock();
+
+        ++mRasterisingGeneration;
+
+        mRasterisingKey = rasterisingKey;
+        mRasterisingMapX = maps[QwtPlot::xBottom];
+        mRasterisingMapY = maps[QwtPlot::yLeft];
+        mRasterisingCanvasRect = canvasRect;
+        mRasterisedCurves = QVector<QImage>(visibleCurves.count());
+        mRasterisedCurvesCount = 0;
+
+        int rasterisingGeneration = mRasterisingGeneration;
+
+        mRasterisingMutex.unlock();
+
+        for (int i = 0, iMax = visibleCurves.count(); i < iMax; ++i) {
+            SingleCellSimulationViewGraphPanelPlotCurve *curve = visibleCurves[i];
+            SingleCellSimulationViewGraphPanelPlotCurveRasteriser *rasteriser = new SingleCellSimulationViewGraphPanelPlotCurveRasteriser(this, curve,
+                                                                                                                                         rasterisingGeneration, i,
+                                                                                                                                         maps[curve->xAxis()],
+                                                                                                                                         maps[curve->yAxis()],
+                                                                                                                                         canvasRect);
+
+            mRasterisingThreadPool.start(rasteriser);
+        }
+    }
+
+    // Draw our last rasterised curves, if any, mapping them to our current
+    // axes if they were rasterised for another frame (e.g. we are being
+    // panned or zoomed, and our current frame is still being rasterised), so
+    // that our curves don't disappear in the meantime
+
+    if (mRasterisedImage.isNull())
+        return;
+
+    if (rasterisingKey == mRasterisedKey) {
+        pPainter->drawImage(canvasRect.topLeft(), mRasterisedImage);
+    } else {
+        QwtScaleMap mapX = maps[QwtPlot::xBottom];
+        QwtScaleMap mapY = maps[QwtPlot::yLeft];
+        QRectF targetRect = QRectF(QPointF(mapX.transform(mRasterisedMapX.invTransform(mRasterisedCanvasRect.left())),
+                                           mapY.transform(mRasterisedMapY.invTransform(mRasterisedCanvasRect.top()))),
+                                   QPointF(mapX.transform(mRasterisedMapX.invTransform(mRasterisedCanvasRect.right())),
+                                           mapY.transform(mRasterisedMapY.invTransform(mRasterisedCanvasRect.bottom()))));
+
+        pPainter->save();
+
+        pPainter->setClipRect(canvasRect);
+        pPainter->drawImage(targetRect.normalized(), mRasterisedImage);
+
+        pPainter->restore();
+    }
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewGraphPanelPlotWidget::cancelRasterising()
+{
+    // Cancel any rasterising of our curves, i.e. make any frame being
+    // rasterised stale, and wait for our rasterisers to be done
+    // Note: we must wait since our rasterisers access our curves and their
+    //       data, which may be about to change or be deleted...
+
+    mRasterisingMutex.lock();
+
+    ++mRasterisingGeneration;
+
+    mRasterisingKey = QString();
+    mRasterisedCurves.clear();
+    mRasterisedCurvesCount = 0;
+
+    mRasterisedKey = QString();
+    mRasterisedImage = QImage();
+
+    mRasterisingMutex.unlock();
+
+    mRasterisingThreadPool.waitForDone();
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewGraphPanelPlotWidget::curveRasterised(const int &pGeneration,
+                                                                   const int &pIndex,
+                                                                   const QImage &pImage)
+{
+    // Keep track of the given rasterised curve, if it is for our current frame
+    // Note: this method is called from one of our rasterisers' thread...
+
+    QMutexLocker locker(&mRasterisingMutex);
+
+    if (pGeneration != mRasterisingGeneration)
+        return;
+
+    mRasterisedCurves[pIndex] = pImage;
+
+    // Let ourselves know, in our own thread, if all our curves have been
+    // rasterised
+
+    if (++mRasterisedCurvesCount == mRasterisedCurves.count())
+        QMetaObject::invokeMethod(this, "rasterisingFinished",
+                                  Qt::QueuedConnection);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewGraphPanelPlotWidget::rasterisingFinished()
+{
+    // Composite our rasterised curves, if they are still for our current frame
+    // (our plot may have been panned, zoomed, etc. in the meantime)
+
+    mRasterisingMutex.lock();
+
+    bool currentFrame =    !mRasterisedCurves.isEmpty()
+                        && (mRasterisedCurvesCount == mRasterisedCurves.count());
+
+    if (currentFrame) {
+        mRasterisedImage = QImage(mRasterisedCurves.first().size(),
+                                  QImage::Format_ARGB32_Premultiplied);
+
+        mRasterisedImage.fill(Qt::transparent);
+
+        QPainter painter(&mRasterisedImage);
+
+        foreach (const QImage &rasterisedCurve, mRasterisedCurves)
+            painter.drawImage(0, 0, rasterisedCurve);
+
+        painter.end();
+
+        mRasterisedKey = mRasterisingKey;
+        mRasterisedMapX = mRasterisingMapX;
+        mRasterisedMapY = mRasterisingMapY;
+        mRasterisedCanvasRect = mRasterisingCanvasRect;
+
+        mRasterisedCurves.clear();
+        mRasterisedCurvesCount = 0;
+    }
+
+    mRasterisingMutex.unlock();
+
+    // Replot ourselves, so that our rasterised curves get drawn
+
+    if (currentFrame)
+        replot();
+}
+
+//==============================================================================
+
 void SingleCellSimulationViewGraphPanelPlotWidget::attach(SingleCellSimulationViewGraphPanelPlotCurve *pCurve)
 {
     // Make sure that the given curve is not already attached to us
@@ -1139,6 +1734,10 @@ void SingleCellSimulationViewGraphPanelPlotWidget::attach(SingleCellSimulationVi
     if (mCurves.contains(pCurve))
         return;
 
+    // Make sure that none of our curves is being rasterised
+
+    cancelRasterising();
+
     // Attach the given curve to ourselves
 
     pCurve->attach(this);
@@ -1157,6 +1756,11 @@ void SingleCellSimulationViewGraphPanelPlotWidget::detach(SingleCellSimulationVi
     if (!mCurves.contains(pCurve))
         return;
 
+    // Make sure that the given curve is not being rasterised, since it may be
+    // about to be deleted
+
+    cancelRasterising();
+
     // Detach the given curve from ourselves
 
     pCurve->detach();
@@ -1191,25 +1795,12 @@ void SingleCellSimulationViewGraphPanelPlotWidget::drawCurveSegment(SingleCellSi
         // It's not our first curve segment, so determine the minimum/maximum
         // X/Y values of our new data
 
-        double xMin = 0.0;
-        double xMax = 0.0;
-        double yMin = 0.0;
-        double yMax = 0.0;
+        QRectF boundingRect = pCurve->boundingRect(pFrom, pTo);
 
-        for (qulonglong i = pFrom; i <= pTo; ++i)
-            if (i == pFrom) {
-                xMin = xMax = pCurve->data()->sample(i).x();
-                yMin = yMax = pCurve->data()->sample(i).y();
-            } else {
-                double xVal = pCurve->data()->sample(i).x();
-                double yVal = pCurve->data()->sample(i).y();
-
-                xMin = qMin(xMin, xVal);
-                xMax = qMax(xMax, xVal);
-
-                yMin = qMin(yMin, yVal);
-                yMax = qMax(yMax, yVal);
-            }
+        double xMin = boundingRect.left();
+        double xMax = boundingRect.right();
+        double yMin = boundingRect.top();
+        double yMax = boundingRect.bottom();
 
         // Check whether our X/Y axis can handle the minimum/maximum X/Y values
         // of our new data
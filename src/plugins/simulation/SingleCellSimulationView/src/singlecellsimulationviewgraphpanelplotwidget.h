@@ -12,6 +12,13 @@
 
 //==============================================================================
 
+#include <QImage>
+#include <QMutex>
+#include <QThreadPool>
+#include <QVector>
+
+//==============================================================================
+
 class QwtPlotDirectPainter;
 
 //==============================================================================
@@ -34,6 +41,32 @@ class SingleCellSimulationViewGraphPanelPlotCurve : public QwtPlotCurve
 {
 public:
     explicit SingleCellSimulationViewGraphPanelPlotCurve();
+
+    void setRawSamples(const double *pXData, const double *pYData, int pSize);
+
+    virtual QRectF boundingRect() const;
+    QRectF boundingRect(const qulonglong &pFrom, const qulonglong &pTo) const;
+
+protected:
+    virtual void drawSeries(QPainter *pPainter, const QwtScaleMap &pXMap,
+                            const QwtScaleMap &pYMap,
+                            const QRectF &pCanvasRect,
+                            int pFrom, int pTo) const;
+
+private:
+    const double *mXData;
+    const double *mYData;
+    qulonglong mSize;
+
+    double mMinX;
+    double mMaxX;
+    double mMinY;
+    double mMaxY;
+
+    QList<QVector<qulonglong> > mPyramid;
+
+    void addToBucket(QVector<qulonglong> &pLevel, const qulonglong &pBucket,
+                     const qulonglong &pIndex);
 };
 
 //==============================================================================
@@ -42,6 +75,9 @@ class SingleCellSimulationViewGraphPanelPlotWidget : public QwtPlot
 {
     Q_OBJECT
 
+    friend class SingleCellSimulationViewGraphPanelPlotCurve;
+    friend class SingleCellSimulationViewGraphPanelPlotCurveRasteriser;
+
 public:
     explicit SingleCellSimulationViewGraphPanelPlotWidget(QWidget *pParent = 0);
     ~SingleCellSimulationViewGraphPanelPlotWidget();
@@ -137,6 +173,23 @@ private:
     QwtScaleMap mCanvasMapX;
     QwtScaleMap mCanvasMapY;
 
+    QThreadPool mRasterisingThreadPool;
+    QMutex mRasterisingMutex;
+
+    int mRasterisingGeneration;
+    QString mRasterisingKey;
+    QwtScaleMap mRasterisingMapX;
+    QwtScaleMap mRasterisingMapY;
+    QRectF mRasterisingCanvasRect;
+    QVector<QImage> mRasterisedCurves;
+    int mRasterisedCurvesCount;
+
+    QString mRasterisedKey;
+    QwtScaleMap mRasterisedMapX;
+    QwtScaleMap mRasterisedMapY;
+    QRectF mRasterisedCanvasRect;
+    QImage mRasterisedImage;
+
     void handleMouseDoubleClickEvent(QMouseEvent *pEvent);
 
     void checkLocalAxisValues(const int &pAxis, double &pMin, double &pMax,
@@ -164,6 +217,15 @@ private:
                          const QColor &pForegroundColor,
                          const Location &pLocation = TopLeft,
                          const bool &pCanMoveLocation = true);
+
+    void drawItemsInBackground(QPainter *pPainter);
+
+    void cancelRasterising();
+    void curveRasterised(const int &pGeneration, const int &pIndex,
+                         const QImage &pImage);
+
+private Q_SLOTS:
+    void rasterisingFinished();
 };
 
 //==============================================================================
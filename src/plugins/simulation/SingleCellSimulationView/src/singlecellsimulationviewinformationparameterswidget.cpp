@@ -3,6 +3,7 @@
 //==============================================================================
 
 #include "cellmlfileruntime.h"
+#include "coreutils.h"
 #include "propertyeditorwidget.h"
 #include "singlecellsimulationviewinformationparameterswidget.h"
 #include "singlecellsimulationviewsimulation.h"
@@ -10,7 +11,13 @@
 //==============================================================================
 
 #include <QHeaderView>
+#include <QLineEdit>
+#include <QMenu>
+#include <QScrollBar>
 #include <QSettings>
+#include <QStackedWidget>
+#include <QTimer>
+#include <QVBoxLayout>
 
 //==============================================================================
 
@@ -19,13 +26,47 @@ namespace SingleCellSimulationView {
 
 //==============================================================================
 
+static const int MaxUpdatesPerSecond = 25;
+
+//==============================================================================
+
+static const int MaxEagerlyPopulatedModelParameters = 512;
+
+//==============================================================================
+
 SingleCellSimulationViewInformationParametersWidget::SingleCellSimulationViewInformationParametersWidget(QWidget *pParent) :
-    QStackedWidget(pParent),
+    QWidget(pParent),
     mPropertyEditors(QMap<QString, Core::PropertyEditorWidget *>()),
     mModelParameters(QMap<Core::Property *, CellMLSupport::CellmlFileRuntimeModelParameter *>()),
+    mSectionModelParameters(QMap<Core::Property *, CellMLSupport::CellmlFileRuntimeModelParameters>()),
+    mShownSensitivities(QMap<CellMLSupport::CellmlFileRuntimeModelParameter *, CellMLSupport::CellmlFileRuntimeModelParameters>()),
     mColumnWidths(QList<int>()),
-    mSimulationData(0)
+    mSimulationData(0),
+    mNeedUpdate(false),
+    mPropertyValues(QMap<Core::Property *, double>())
 {
+    // Create a layout on which we put our filter value and a stacked widget
+    // for our property editors, separated by a line
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+
+    layout->setMargin(0);
+    layout->setSpacing(0);
+
+    setLayout(layout);
+
+    mFilterValue = new QLineEdit(this);
+    mPropertyEditorsWidget = new QStackedWidget(this);
+
+    mFilterValue->setFrame(false);
+
+    connect(mFilterValue, SIGNAL(textChanged(const QString &)),
+            this, SLOT(filterChanged()));
+
+    layout->addWidget(mFilterValue);
+    layout->addWidget(Core::newLineWidget(this));
+    layout->addWidget(mPropertyEditorsWidget);
+
     // Determine the default width of each column of our property editors
 
     Core::PropertyEditorWidget *tempPropertyEditor = new Core::PropertyEditorWidget(this);
@@ -34,12 +75,27 @@ SingleCellSimulationViewInformationParametersWidget::SingleCellSimulationViewInf
         mColumnWidths.append(tempPropertyEditor->columnWidth(i));
 
     delete tempPropertyEditor;
+
+    // Create our update timer, which we use to cap the rate at which our
+    // parameters get updated (e.g. while a simulation is running)
+
+    mUpdateTimer = new QTimer(this);
+
+    mUpdateTimer->setInterval(1000/MaxUpdatesPerSecond);
+    mUpdateTimer->setSingleShot(true);
+
+    connect(mUpdateTimer, SIGNAL(timeout()),
+            this, SLOT(updateTimeout()));
 }
 
 //==============================================================================
 
 void SingleCellSimulationViewInformationParametersWidget::retranslateUi()
 {
+    // Retranslate our filter value
+
+    mFilterValue->setPlaceholderText(tr("Filter"));
+
     // Retranslate all our property editors
 
     foreach (Core::PropertyEditorWidget *propertyEditor, mPropertyEditors)
@@ -126,25 +182,58 @@ void SingleCellSimulationViewInformationParametersWidget::initialize(const QStri
         connect(propertyEditor, SIGNAL(propertyChecked(Core::Property *, const bool &)),
                 this, SLOT(emitShowModelParameter(Core::Property *, const bool &)));
 
+        // We want a context menu for our property editor, so that the user can
+        // decide with respect to which constants the sensitivity of our states
+        // is to be computed and which of those sensitivities to show/hide
+
+        propertyEditor->setContextMenuPolicy(Qt::CustomContextMenu);
+
+        connect(propertyEditor, SIGNAL(customContextMenuRequested(const QPoint &)),
+                this, SLOT(showCustomContextMenu(const QPoint &)));
+
+        // Keep track of when a section gets expanded, since it may need to be
+        // populated
+
+        connect(propertyEditor, SIGNAL(expanded(const QModelIndex &)),
+                this, SLOT(sectionExpanded(const QModelIndex &)));
+
+        // Keep track of when some properties may become visible, since only
+        // visible properties get updated
+
+        connect(propertyEditor->verticalScrollBar(), SIGNAL(valueChanged(int)),
+                this, SLOT(updateParameters()));
+        connect(propertyEditor, SIGNAL(expanded(const QModelIndex &)),
+                this, SLOT(updateParameters()));
+
         // Add our new property editor to ourselves
 
-        addWidget(propertyEditor);
+        mPropertyEditorsWidget->addWidget(propertyEditor);
 
         // Keep track of our new property editor
 
         mPropertyEditors.insert(pFileName, propertyEditor);
     }
 
-    // Set our retrieved property editor as our widget
+    // Set our retrieved property editor as our current property editor and
+    // filter it
+
+    mPropertyEditorsWidget->setCurrentWidget(propertyEditor);
 
-    setCurrentWidget(propertyEditor);
+    filterProperties(propertyEditor);
 }
 
 //==============================================================================
 
 void SingleCellSimulationViewInformationParametersWidget::finalize(const QString &pFileName)
 {
-    // Remove any track of our property editor
+    // Remove any track of the sensitivities we show for our property editor's
+    // states and of our property editor itself
+
+    Core::PropertyEditorWidget *propertyEditor = mPropertyEditors.value(pFileName);
+
+    if (propertyEditor)
+        foreach (Core::Property *property, propertyEditor->properties())
+            mShownSensitivities.remove(mModelParameters.value(property));
 
     mPropertyEditors.remove(pFileName);
 }
@@ -152,43 +241,103 @@ void SingleCellSimulationViewInformationParametersWidget::finalize(const QString
 //==============================================================================
 
 void SingleCellSimulationViewInformationParametersWidget::updateParameters()
+{
+    // Update our parameters straightaway, unless they have been updated
+    // recently, in which case we coalesce this request with any other one we
+    // may get until our update timer times out
+
+    if (mUpdateTimer->isActive()) {
+        mNeedUpdate = true;
+    } else {
+        updateParametersNow();
+
+        mUpdateTimer->start();
+    }
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewInformationParametersWidget::updateTimeout()
+{
+    // Update our parameters, if some update requests were coalesced, and
+    // restart our update timer, so that our update rate remains capped
+
+    if (mNeedUpdate) {
+        mNeedUpdate = false;
+
+        updateParametersNow();
+
+        mUpdateTimer->start();
+    }
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewInformationParametersWidget::updateParametersNow()
 {
     // Retrieve our current property editor, if any
 
-    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(currentWidget());
+    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(mPropertyEditorsWidget->currentWidget());
 
-    if (!propertyEditor)
+    if (!propertyEditor || !mSimulationData)
         return;
 
     // Update our property editor's data
+    // Note: we only update the properties which are visible in our property
+    //       editor's viewport and which value has changed since we last
+    //       updated them. Other properties will get updated whenever they
+    //       become visible (see initialize())...
+
+    QRect viewportRect = propertyEditor->viewport()->rect();
 
     foreach (Core::Property *property, propertyEditor->properties()) {
         CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter = mModelParameters.value(property);
 
-        if (modelParameter)
-            switch (modelParameter->type()) {
-            case CellMLSupport::CellmlFileRuntimeModelParameter::Constant:
-            case CellMLSupport::CellmlFileRuntimeModelParameter::ComputedConstant:
-                propertyEditor->setDoublePropertyItem(property->value(), mSimulationData->constants()[modelParameter->index()]);
+        if (!modelParameter)
+            continue;
 
-                break;
-            case CellMLSupport::CellmlFileRuntimeModelParameter::State:
-                propertyEditor->setDoublePropertyItem(property->value(), mSimulationData->states()[modelParameter->index()]);
+        double *values;
 
-                break;
-            case CellMLSupport::CellmlFileRuntimeModelParameter::Rate:
-                propertyEditor->setDoublePropertyItem(property->value(), mSimulationData->rates()[modelParameter->index()]);
+        switch (modelParameter->type()) {
+        case CellMLSupport::CellmlFileRuntimeModelParameter::Constant:
+        case CellMLSupport::CellmlFileRuntimeModelParameter::ComputedConstant:
+            values = mSimulationData->constants();
 
-                break;
-            case CellMLSupport::CellmlFileRuntimeModelParameter::Algebraic:
-                propertyEditor->setDoublePropertyItem(property->value(), mSimulationData->algebraic()[modelParameter->index()]);
+            break;
+        case CellMLSupport::CellmlFileRuntimeModelParameter::State:
+            values = mSimulationData->states();
 
-                break;
-            default:
-                // Either Voi or Undefined, so...
+            break;
+        case CellMLSupport::CellmlFileRuntimeModelParameter::Rate:
+            values = mSimulationData->rates();
 
-                ;
-            }
+            break;
+        case CellMLSupport::CellmlFileRuntimeModelParameter::Algebraic:
+            values = mSimulationData->algebraic();
+
+            break;
+        default:
+            // Either Voi or Undefined, so...
+
+            values = 0;
+        }
+
+        if (!values)
+            continue;
+
+        double value = values[modelParameter->index()];
+        QMap<Core::Property *, double>::const_iterator propertyValue = mPropertyValues.constFind(property);
+
+        if (   (propertyValue != mPropertyValues.constEnd())
+            && (propertyValue.value() == value))
+            continue;
+
+        if (!propertyEditor->visualRect(property->value()->index()).intersects(viewportRect))
+            continue;
+
+        propertyEditor->setDoublePropertyItem(property->value(), value);
+
+        mPropertyValues.insert(property, value);
     }
 
     // Check whether any of our properties has actually been modified
@@ -202,11 +351,16 @@ void SingleCellSimulationViewInformationParametersWidget::propertyChanged(Core::
 {
     // Retrieve our current property editor, if any
 
-    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(currentWidget());
+    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(mPropertyEditorsWidget->currentWidget());
 
     if (!propertyEditor)
         return;
 
+    // Forget about the value we last displayed for the given property, since
+    // the user may have entered it in a different format
+
+    mPropertyValues.remove(pProperty);
+
     // Update our simulation data
 
     CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter = mModelParameters.value(pProperty);
@@ -243,7 +397,7 @@ void SingleCellSimulationViewInformationParametersWidget::emitShowModelParameter
 {
     // Retrieve our current property editor, if any
 
-    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(currentWidget());
+    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(mPropertyEditorsWidget->currentWidget());
 
     if (!propertyEditor)
         return;
@@ -258,11 +412,103 @@ void SingleCellSimulationViewInformationParametersWidget::emitShowModelParameter
 
 //==============================================================================
 
+void SingleCellSimulationViewInformationParametersWidget::showCustomContextMenu(const QPoint &pPosition)
+{
+    // Retrieve our current property editor, if any
+
+    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(mPropertyEditorsWidget->currentWidget());
+
+    if (!propertyEditor || !mSimulationData)
+        return;
+
+    // Retrieve the model parameter, if any, over which we are
+
+    QModelIndex index = propertyEditor->indexAt(pPosition);
+    CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter = 0;
+
+    if (index.isValid())
+        foreach (Core::Property *property, mModelParameters.keys())
+            if (   (property->name()->index().row() == index.row())
+                && (property->name()->index().parent() == index.parent())) {
+                modelParameter = mModelParameters.value(property);
+
+                break;
+            }
+
+    if (!modelParameter)
+        return;
+
+    // Create and show our context menu, which allows the user to decide
+    // whether the sensitivity of our states is to be computed with respect to
+    // a constant or which sensitivities of a state to show/hide
+    // Note: the sensitivities of a state which we offer to show are those
+    //       with respect to the constants the user is currently interested in,
+    //       as well as those which are currently shown (so that they can be
+    //       hidden)...
+
+    QMenu menu;
+    QAction *computeSensitivityAction = 0;
+    QMap<QAction *, CellMLSupport::CellmlFileRuntimeModelParameter *> showSensitivityActions = QMap<QAction *, CellMLSupport::CellmlFileRuntimeModelParameter *>();
+
+    if (modelParameter->type() == CellMLSupport::CellmlFileRuntimeModelParameter::Constant) {
+        computeSensitivityAction = menu.addAction(tr("Compute Sensitivity"));
+
+        computeSensitivityAction->setCheckable(true);
+        computeSensitivityAction->setChecked(mSimulationData->isSensitivityParameter(modelParameter));
+        computeSensitivityAction->setEnabled(mSimulationData->canComputeSensitivities());
+    } else if (modelParameter->type() == CellMLSupport::CellmlFileRuntimeModelParameter::State) {
+        CellMLSupport::CellmlFileRuntimeModelParameters shownSensitivities = mShownSensitivities.value(modelParameter);
+        CellMLSupport::CellmlFileRuntimeModelParameters sensitivityParameters = mSimulationData->sensitivityParameters();
+
+        foreach (CellMLSupport::CellmlFileRuntimeModelParameter *shownSensitivity, shownSensitivities)
+            if (!sensitivityParameters.contains(shownSensitivity))
+                sensitivityParameters << shownSensitivity;
+
+        QMenu *showSensitivityMenu = menu.addMenu(tr("Plot Sensitivity"));
+
+        foreach (CellMLSupport::CellmlFileRuntimeModelParameter *sensitivityParameter, sensitivityParameters) {
+            QAction *showSensitivityAction = showSensitivityMenu->addAction(tr("With Respect To %1 (%2)").arg(sensitivityParameter->name(),
+                                                                                                               sensitivityParameter->component()));
+
+            showSensitivityAction->setCheckable(true);
+            showSensitivityAction->setChecked(shownSensitivities.contains(sensitivityParameter));
+
+            showSensitivityActions.insert(showSensitivityAction, sensitivityParameter);
+        }
+
+        showSensitivityMenu->setEnabled(!sensitivityParameters.isEmpty());
+    } else {
+        return;
+    }
+
+    QAction *action = menu.exec(propertyEditor->viewport()->mapToGlobal(pPosition));
+
+    if (!action)
+        return;
+
+    if (action == computeSensitivityAction) {
+        mSimulationData->setSensitivityParameter(modelParameter, action->isChecked());
+    } else if (showSensitivityActions.contains(action)) {
+        CellMLSupport::CellmlFileRuntimeModelParameter *sensitivityParameter = showSensitivityActions.value(action);
+
+        if (action->isChecked())
+            mShownSensitivities[modelParameter] << sensitivityParameter;
+        else
+            mShownSensitivities[modelParameter].removeOne(sensitivityParameter);
+
+        emit showSensitivity(mPropertyEditors.key(propertyEditor),
+                             modelParameter, sensitivityParameter,
+                             action->isChecked());
+    }
+}
+
+//==============================================================================
+
 void SingleCellSimulationViewInformationParametersWidget::finishPropertyEditing()
 {
     // Retrieve our current property editor, if any
 
-    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(currentWidget());
+    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(mPropertyEditorsWidget->currentWidget());
 
     if (!propertyEditor)
         return;
@@ -281,11 +527,20 @@ void SingleCellSimulationViewInformationParametersWidget::populateModel(Core::Pr
 
     pPropertyEditor->setUpdatesEnabled(false);
 
-    // Populate our property editor with the model parameters
-
+    // Populate our property editor with a section for each component and,
+    // unless we have too many model parameters, the model parameters
+    // themselves
+    // Note: if we have too many model parameters, then we only add the first
+    //       model parameter of a component (so that its section can be
+    //       expanded) and keep track of the other ones, which will be added
+    //       when their section gets expanded (see sectionExpanded()) or when
+    //       they match our filter value (see filterProperties())...
+
+    const CellMLSupport::CellmlFileRuntimeModelParameters &modelParameters = pRuntime->modelParameters();
+    bool populateSections = modelParameters.count() <= MaxEagerlyPopulatedModelParameters;
     Core::Property *section = 0;
 
-    foreach (CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter, pRuntime->modelParameters()) {
+    foreach (CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter, modelParameters) {
         // Check whether the current model parameter is in the same component as
         // the previous one
 
@@ -298,76 +553,206 @@ void SingleCellSimulationViewInformationParametersWidget::populateModel(Core::Pr
             section = pPropertyEditor->addSectionProperty();
 
             pPropertyEditor->setStringPropertyItem(section->name(), crtComponent);
+
+            addModelParameter(pPropertyEditor, section, modelParameter);
+        } else if (populateSections) {
+            addModelParameter(pPropertyEditor, section, modelParameter);
+        } else {
+            mSectionModelParameters[section] << modelParameter;
         }
+    }
 
-        // Add the current model parameter to the 'current' component section
-        // Note: in case of an algebraic variable, if its degree is equal to
-        //       zero, then we are dealing with a 'proper' algebraic variable
-        //       otherwise a rate variable. Now, there may be several rate
-        //       variables with the same name (but different degrees) and a
-        //       state variable with the same name will also exist. So, to
-        //       distinguish between all of them, we 'customise' our variable's
-        //       name by appending n single quotes with n the degree of our
-        //       variable (that degree is zero for all but rate variables; e.g.
-        //       for a state variable which name is V, the corresponding rate
-        //       variables of degree 1, 2 and 3 will be V', V'' and V''',
-        //       respectively)...
-
-        bool parameterEditable = false;
-        QIcon parameterIcon = QIcon(":CellMLSupport_errorNode");
+    // Expand all our properties, if they have all been added
 
-        switch (modelParameter->type()) {
-        case CellMLSupport::CellmlFileRuntimeModelParameter::Constant:
-            parameterEditable = true;
+    if (populateSections)
+        pPropertyEditor->expandAll();
 
-            parameterIcon = QIcon(":SingleCellSimulationView_constant");
+    // Allow ourselves to be updated again
 
-            break;
-        case CellMLSupport::CellmlFileRuntimeModelParameter::ComputedConstant:
-            parameterIcon = QIcon(":SingleCellSimulationView_computedConstant");
+    pPropertyEditor->setUpdatesEnabled(true);
+}
 
-            break;
-        case CellMLSupport::CellmlFileRuntimeModelParameter::State:
-            parameterEditable = true;
+//==============================================================================
 
-            parameterIcon = QIcon(":SingleCellSimulationView_state");
+void SingleCellSimulationViewInformationParametersWidget::populateSection(Core::PropertyEditorWidget *pPropertyEditor,
+                                                                          Core::Property *pSection)
+{
+    // Add the model parameters of the given section which have not yet been
+    // added, if any
 
-            break;
-        case CellMLSupport::CellmlFileRuntimeModelParameter::Rate:
-            parameterIcon = QIcon(":SingleCellSimulationView_rate");
+    if (!mSectionModelParameters.contains(pSection))
+        return;
 
-            break;
-        case CellMLSupport::CellmlFileRuntimeModelParameter::Algebraic:
-            parameterIcon = QIcon(":SingleCellSimulationView_algebraic");
+    foreach (CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter,
+             mSectionModelParameters.take(pSection))
+        addModelParameter(pPropertyEditor, pSection, modelParameter);
+}
 
-            break;
-        default:
-            // We are dealing with a type of model parameter which is of no
-            // interest to us, so do nothing...
-            // Note: we should never reach this point...
+//==============================================================================
 
-            ;
+void SingleCellSimulationViewInformationParametersWidget::addModelParameter(Core::PropertyEditorWidget *pPropertyEditor,
+                                                                            Core::Property *pSection,
+                                                                            CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter)
+{
+    // Add the given model parameter to the given section
+    // Note: in case of an algebraic variable, if its degree is equal to zero,
+    //       then we are dealing with a 'proper' algebraic variable otherwise a
+    //       rate variable. Now, there may be several rate variables with the
+    //       same name (but different degrees) and a state variable with the
+    //       same name will also exist. So, to distinguish between all of them,
+    //       we 'customise' our variable's name by appending n single quotes
+    //       with n the degree of our variable (that degree is zero for all but
+    //       rate variables; e.g. for a state variable which name is V, the
+    //       corresponding rate variables of degree 1, 2 and 3 will be V', V''
+    //       and V''', respectively)...
+
+    bool parameterEditable = false;
+    QIcon parameterIcon = QIcon(":CellMLSupport_errorNode");
+
+    switch (pModelParameter->type()) {
+    case CellMLSupport::CellmlFileRuntimeModelParameter::Constant:
+        parameterEditable = true;
+
+        parameterIcon = QIcon(":SingleCellSimulationView_constant");
+
+        break;
+    case CellMLSupport::CellmlFileRuntimeModelParameter::ComputedConstant:
+        parameterIcon = QIcon(":SingleCellSimulationView_computedConstant");
+
+        break;
+    case CellMLSupport::CellmlFileRuntimeModelParameter::State:
+        parameterEditable = true;
+
+        parameterIcon = QIcon(":SingleCellSimulationView_state");
+
+        break;
+    case CellMLSupport::CellmlFileRuntimeModelParameter::Rate:
+        parameterIcon = QIcon(":SingleCellSimulationView_rate");
+
+        break;
+    case CellMLSupport::CellmlFileRuntimeModelParameter::Algebraic:
+        parameterIcon = QIcon(":SingleCellSimulationView_algebraic");
+
+        break;
+    default:
+        // We are dealing with a type of model parameter which is of no
+        // interest to us, so do nothing...
+        // Note: we should never reach this point...
+
+        ;
+    }
+
+    Core::Property *property = pPropertyEditor->addDoubleProperty(parameterEditable, true, pSection);
+
+    property->name()->setIcon(parameterIcon);
+
+    pPropertyEditor->setStringPropertyItem(property->name(), pModelParameter->name()+QString(pModelParameter->degree(), '\''));
+    pPropertyEditor->setStringPropertyItem(property->unit(), pModelParameter->unit());
+
+    // Keep track of the link between our property value and model parameter
+
+    mModelParameters.insert(property, pModelParameter);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewInformationParametersWidget::sectionExpanded(const QModelIndex &pIndex)
+{
+    // Populate the section that has just been expanded, if needed
+
+    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(sender());
+
+    if (!propertyEditor)
+        return;
+
+    foreach (Core::Property *section, mSectionModelParameters.keys())
+        if (section->name()->index() == pIndex) {
+            populateSection(propertyEditor, section);
+
+            // Make sure that our new properties are filtered
+
+            if (!mFilterValue->text().isEmpty())
+                filterProperties(propertyEditor);
+
+            break;
         }
+}
 
-        Core::Property *property = pPropertyEditor->addDoubleProperty(parameterEditable, true, section);
+//==============================================================================
 
-        property->name()->setIcon(parameterIcon);
+void SingleCellSimulationViewInformationParametersWidget::filterChanged()
+{
+    // Filter our current property editor, if any
 
-        pPropertyEditor->setStringPropertyItem(property->name(), modelParameter->name()+QString(modelParameter->degree(), '\''));
-        pPropertyEditor->setStringPropertyItem(property->unit(), modelParameter->unit());
+    Core::PropertyEditorWidget *propertyEditor = qobject_cast<Core::PropertyEditorWidget *>(mPropertyEditorsWidget->currentWidget());
 
-        // Keep track of the link between our property value and model parameter
+    if (propertyEditor)
+        filterProperties(propertyEditor);
+}
 
-        mModelParameters.insert(property, modelParameter);
-    }
+//==============================================================================
+
+void SingleCellSimulationViewInformationParametersWidget::filterProperties(Core::PropertyEditorWidget *pPropertyEditor)
+{
+    // Prevent ourselves from being updated (to avoid any flickering)
+
+    pPropertyEditor->setUpdatesEnabled(false);
+
+    // Populate the sections which model parameters have not all been added and
+    // for which one of them matches our filter value
+    // Note: this means that the sections we are going to expand below have
+    //       all been populated...
+
+    QString filter = mFilterValue->text();
 
-    // Expand all our properties
+    if (!filter.isEmpty())
+        foreach (Core::Property *property, pPropertyEditor->properties())
+            if (mSectionModelParameters.contains(property)) {
+                bool sectionMatches = property->name()->child(0)->text().contains(filter, Qt::CaseInsensitive);
+
+                foreach (CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter,
+                         mSectionModelParameters.value(property))
+                    if (sectionMatches)
+                        break;
+                    else
+                        sectionMatches = modelParameter->name().contains(filter, Qt::CaseInsensitive);
+
+                if (sectionMatches)
+                    populateSection(pPropertyEditor, property);
+            }
 
-    pPropertyEditor->expandAll();
+    // Show only the model parameters which name contains our filter value, as
+    // well as the (expanded) sections to which they belong
+
+    QMap<QStandardItem *, bool> sectionsVisible = QMap<QStandardItem *, bool>();
+
+    foreach (Core::Property *property, pPropertyEditor->properties())
+        if (mModelParameters.contains(property)) {
+            bool propertyVisible = property->name()->text().contains(filter, Qt::CaseInsensitive);
+
+            pPropertyEditor->setPropertyVisible(property, propertyVisible);
+
+            if (propertyVisible)
+                sectionsVisible.insert(property->name()->parent(), true);
+        }
+
+    foreach (Core::Property *property, pPropertyEditor->properties())
+        if (!mModelParameters.contains(property)) {
+            bool sectionVisible = filter.isEmpty() || sectionsVisible.value(property->name());
+
+            pPropertyEditor->setPropertyVisible(property, sectionVisible);
+
+            if (sectionVisible && !filter.isEmpty())
+                pPropertyEditor->expand(property->name()->index());
+        }
 
     // Allow ourselves to be updated again
 
     pPropertyEditor->setUpdatesEnabled(true);
+
+    // Update our parameters, since some of them may have become visible
+
+    updateParameters();
 }
 
 //==============================================================================
@@ -7,11 +7,21 @@
 
 //==============================================================================
 
+#include "cellmlfileruntime.h"
 #include "commonwidget.h"
 
 //==============================================================================
 
-#include <QStackedWidget>
+#include <QMap>
+#include <QWidget>
+
+//==============================================================================
+
+class QLineEdit;
+class QModelIndex;
+class QPoint;
+class QStackedWidget;
+class QTimer;
 
 //==============================================================================
 
@@ -26,13 +36,6 @@ namespace Core {
 
 //==============================================================================
 
-namespace CellMLSupport {
-    class CellmlFileRuntime;
-    class CellmlFileRuntimeModelParameter;
-}   // namespace CellMLSupport
-
-//==============================================================================
-
 namespace SingleCellSimulationView {
 
 //==============================================================================
@@ -41,7 +44,7 @@ class SingleCellSimulationViewSimulationData;
 
 //==============================================================================
 
-class SingleCellSimulationViewInformationParametersWidget : public QStackedWidget,
+class SingleCellSimulationViewInformationParametersWidget : public QWidget,
                                                             public Core::CommonWidget
 {
     Q_OBJECT
@@ -62,21 +65,43 @@ public:
     void finishPropertyEditing();
 
 private:
+    QLineEdit *mFilterValue;
+    QStackedWidget *mPropertyEditorsWidget;
+
     QMap<QString, Core::PropertyEditorWidget *> mPropertyEditors;
 
     QMap<Core::Property *, CellMLSupport::CellmlFileRuntimeModelParameter *> mModelParameters;
+    QMap<Core::Property *, CellMLSupport::CellmlFileRuntimeModelParameters> mSectionModelParameters;
+
+    QMap<CellMLSupport::CellmlFileRuntimeModelParameter *, CellMLSupport::CellmlFileRuntimeModelParameters> mShownSensitivities;
 
     QList<int> mColumnWidths;
 
     SingleCellSimulationViewSimulationData *mSimulationData;
 
+    QTimer *mUpdateTimer;
+    bool mNeedUpdate;
+
+    QMap<Core::Property *, double> mPropertyValues;
+
     void populateModel(Core::PropertyEditorWidget *pPropertyEditor,
                        CellMLSupport::CellmlFileRuntime *pRuntime);
+    void populateSection(Core::PropertyEditorWidget *pPropertyEditor,
+                         Core::Property *pSection);
+    void addModelParameter(Core::PropertyEditorWidget *pPropertyEditor,
+                           Core::Property *pSection,
+                           CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter);
+
+    void filterProperties(Core::PropertyEditorWidget *pPropertyEditor);
 
 Q_SIGNALS:
     void showModelParameter(const QString &pFileName,
                             CellMLSupport::CellmlFileRuntimeModelParameter *pParameter,
                             const bool &pShow);
+    void showSensitivity(const QString &pFileName,
+                         CellMLSupport::CellmlFileRuntimeModelParameter *pState,
+                         CellMLSupport::CellmlFileRuntimeModelParameter *pConstant,
+                         const bool &pShow);
 
 public Q_SLOTS:
     void updateParameters();
@@ -87,7 +112,16 @@ private Q_SLOTS:
 
     void propertyChanged(Core::Property *pProperty);
 
+    void sectionExpanded(const QModelIndex &pIndex);
+
+    void filterChanged();
+
+    void updateParametersNow();
+    void updateTimeout();
+
     void emitShowModelParameter(Core::Property *pProperty, const bool &pShow);
+
+    void showCustomContextMenu(const QPoint &pPosition);
 };
 
 //==============================================================================
@@ -19,6 +19,7 @@ namespace SingleCellSimulationView {
 
 SingleCellSimulationViewInformationSimulationWidget::SingleCellSimulationViewInformationSimulationWidget(QWidget *pParent) :
     PropertyEditorWidget(true, pParent),
+    mOdeModel(true),
     mGuiStates(QMap<QString, Core::PropertyEditorWidgetGuiState *>())
 {
     // Populate our property editor
@@ -26,6 +27,15 @@ SingleCellSimulationViewInformationSimulationWidget::SingleCellSimulationViewInf
     mStartingPointProperty = addDoubleProperty(true, false);
     mEndingPointProperty   = addDoubleProperty(true, false);
     mPointIntervalProperty = addDoubleProperty(true, false);
+    mModeProperty          = addListProperty();
+
+    mPeriodProperty          = addDoubleProperty(true, false);
+    mPeriodToleranceProperty = addDoubleProperty(true, false);
+    mKeptCyclesProperty      = addIntegerProperty(true, false);
+
+    mRecordingProperty          = addListProperty();
+    mRecordingIntervalProperty  = addIntegerProperty(true, false);
+    mRecordingThresholdProperty = addDoubleProperty(true, false);
 
     // Initialise our property values
 
@@ -33,6 +43,13 @@ SingleCellSimulationViewInformationSimulationWidget::SingleCellSimulationViewInf
     setDoublePropertyItem(mEndingPointProperty->value(), 1000.0);
     setDoublePropertyItem(mPointIntervalProperty->value(), 1.0);
 
+    setDoublePropertyItem(mPeriodProperty->value(), 0.0);
+    setDoublePropertyItem(mPeriodToleranceProperty->value(), 1.0e-6);
+    setIntegerPropertyItem(mKeptCyclesProperty->value(), 1);
+
+    setIntegerPropertyItem(mRecordingIntervalProperty->value(), 10);
+    setDoublePropertyItem(mRecordingThresholdProperty->value(), 1.0e-2);
+
     // Some further initialisations which are done as part of retranslating the
     // GUI (so that they can be updated when changing languages)
 
@@ -68,6 +85,50 @@ void SingleCellSimulationViewInformationSimulationWidget::retranslateUi()
     setStringPropertyItem(mStartingPointProperty->name(), tr("Starting point"));
     setStringPropertyItem(mEndingPointProperty->name(), tr("Ending point"));
     setStringPropertyItem(mPointIntervalProperty->name(), tr("Point interval"));
+    setStringPropertyItem(mModeProperty->name(), tr("Mode"));
+    setStringPropertyItem(mPeriodProperty->name(), tr("Period"));
+    setStringPropertyItem(mPeriodToleranceProperty->name(), tr("Period tolerance"));
+    setStringPropertyItem(mKeptCyclesProperty->name(), tr("Kept cycles"));
+    setStringPropertyItem(mRecordingProperty->name(), tr("Recording"));
+    setStringPropertyItem(mRecordingIntervalProperty->name(), tr("Recording interval"));
+    setStringPropertyItem(mRecordingThresholdProperty->name(), tr("Recording threshold"));
+
+    // Update our list of modes
+
+    updateModes();
+
+    // Update our list of recording policies while keeping track of the current
+    // one
+    // Note: the order of our recording policies must match that of
+    //       SingleCellSimulationViewSimulationData::RecordingPolicy...
+
+    int recordingIndex = qMax(0, mRecordingProperty->value()->list().indexOf(mRecordingProperty->value()->text()));
+    QStringList recordings = QStringList() << tr("All points") << tr("Every Nth point")
+                                           << tr("On change") << tr("Min/max per bucket");
+
+    mRecordingProperty->value()->setList(recordings);
+
+    setStringPropertyItem(mRecordingProperty->value(), recordings.at(recordingIndex));
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewInformationSimulationWidget::updateModes()
+{
+    // Update our list of modes while keeping track of the current one
+    // Note: we can only compute the steady state of an ODE model or compute
+    //       its time course in parallel, so only offer those modes for ODE
+    //       models...
+
+    int modeIndex = qMax(0, mModeProperty->value()->list().indexOf(mModeProperty->value()->text()));
+    QStringList modes = QStringList() << tr("Time course");
+
+    if (mOdeModel)
+        modes << tr("Steady state") << tr("Time course (parallel in time)");
+
+    mModeProperty->value()->setList(modes);
+
+    setStringPropertyItem(mModeProperty->value(), modes.at(qMin(modeIndex, modes.count()-1)));
 }
 
 //==============================================================================
@@ -87,6 +148,12 @@ void SingleCellSimulationViewInformationSimulationWidget::initialize(const QStri
                     mGuiStates.value(pFileName):
                     mDefaultGuiState);
 
+    // Only offer the modes that make sense for our type of model
+
+    mOdeModel = pRuntime->modelType() == CellMLSupport::CellmlFileRuntime::Ode;
+
+    updateModes();
+
     // Iniialise the unit of our different properties
 
     QString unit = pRuntime->variableOfIntegration()->unit();
@@ -94,6 +161,7 @@ void SingleCellSimulationViewInformationSimulationWidget::initialize(const QStri
     setStringPropertyItem(mStartingPointProperty->unit(), unit);
     setStringPropertyItem(mEndingPointProperty->unit(), unit);
     setStringPropertyItem(mPointIntervalProperty->unit(), unit);
+    setStringPropertyItem(mPeriodProperty->unit(), unit);
 
     // Initialise our simulation's starting point so that we can then properly
     // reset our simulation the first time round
@@ -148,6 +216,69 @@ Core::Property * SingleCellSimulationViewInformationSimulationWidget::pointInter
 
 //==============================================================================
 
+Core::Property * SingleCellSimulationViewInformationSimulationWidget::modeProperty() const
+{
+    // Return our mode property
+
+    return mModeProperty;
+}
+
+//==============================================================================
+
+Core::Property * SingleCellSimulationViewInformationSimulationWidget::periodProperty() const
+{
+    // Return our period property
+
+    return mPeriodProperty;
+}
+
+//==============================================================================
+
+Core::Property * SingleCellSimulationViewInformationSimulationWidget::periodToleranceProperty() const
+{
+    // Return our period tolerance property
+
+    return mPeriodToleranceProperty;
+}
+
+//==============================================================================
+
+Core::Property * SingleCellSimulationViewInformationSimulationWidget::keptCyclesProperty() const
+{
+    // Return our kept cycles property
+
+    return mKeptCyclesProperty;
+}
+
+//==============================================================================
+
+Core::Property * SingleCellSimulationViewInformationSimulationWidget::recordingProperty() const
+{
+    // Return our recording property
+
+    return mRecordingProperty;
+}
+
+//==============================================================================
+
+Core::Property * SingleCellSimulationViewInformationSimulationWidget::recordingIntervalProperty() const
+{
+    // Return our recording interval property
+
+    return mRecordingIntervalProperty;
+}
+
+//==============================================================================
+
+Core::Property * SingleCellSimulationViewInformationSimulationWidget::recordingThresholdProperty() const
+{
+    // Return our recording threshold property
+
+    return mRecordingThresholdProperty;
+}
+
+//==============================================================================
+
 double SingleCellSimulationViewInformationSimulationWidget::startingPoint() const
 {
     // Return our starting point
@@ -175,6 +306,81 @@ double SingleCellSimulationViewInformationSimulationWidget::pointInterval() cons
 
 //==============================================================================
 
+bool SingleCellSimulationViewInformationSimulationWidget::steadyState() const
+{
+    // Return whether we want to compute a steady state, i.e. whether our
+    // second mode is selected
+
+    return mModeProperty->value()->list().indexOf(mModeProperty->value()->text()) == 1;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewInformationSimulationWidget::parallelInTime() const
+{
+    // Return whether we want to compute our time course in parallel, i.e.
+    // whether our third mode is selected
+
+    return mModeProperty->value()->list().indexOf(mModeProperty->value()->text()) == 2;
+}
+
+//==============================================================================
+
+double SingleCellSimulationViewInformationSimulationWidget::period() const
+{
+    // Return our period
+
+    return doublePropertyItem(mPeriodProperty->value());
+}
+
+//==============================================================================
+
+double SingleCellSimulationViewInformationSimulationWidget::periodTolerance() const
+{
+    // Return our period tolerance
+
+    return doublePropertyItem(mPeriodToleranceProperty->value());
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewInformationSimulationWidget::keptCycles() const
+{
+    // Return our number of kept cycles
+
+    return integerPropertyItem(mKeptCyclesProperty->value());
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewInformationSimulationWidget::recordingPolicy() const
+{
+    // Return our recording policy, i.e. the index of our current recording
+    // policy
+
+    return qMax(0, mRecordingProperty->value()->list().indexOf(mRecordingProperty->value()->text()));
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewInformationSimulationWidget::recordingInterval() const
+{
+    // Return our recording interval
+
+    return integerPropertyItem(mRecordingIntervalProperty->value());
+}
+
+//==============================================================================
+
+double SingleCellSimulationViewInformationSimulationWidget::recordingThreshold() const
+{
+    // Return our recording threshold
+
+    return doublePropertyItem(mRecordingThresholdProperty->value());
+}
+
+//==============================================================================
+
 }   // namespace SingleCellSimulationView
 }   // namespace OpenCOR
 
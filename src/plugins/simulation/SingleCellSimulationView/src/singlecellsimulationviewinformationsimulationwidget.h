@@ -48,18 +48,44 @@ public:
     Core::Property * startingPointProperty() const;
     Core::Property * endingPointProperty() const;
     Core::Property * pointIntervalProperty() const;
+    Core::Property * modeProperty() const;
+    Core::Property * periodProperty() const;
+    Core::Property * periodToleranceProperty() const;
+    Core::Property * keptCyclesProperty() const;
+    Core::Property * recordingProperty() const;
+    Core::Property * recordingIntervalProperty() const;
+    Core::Property * recordingThresholdProperty() const;
 
     double startingPoint() const;
     double endingPoint() const;
     double pointInterval() const;
+    bool steadyState() const;
+    bool parallelInTime() const;
+    double period() const;
+    double periodTolerance() const;
+    int keptCycles() const;
+    int recordingPolicy() const;
+    int recordingInterval() const;
+    double recordingThreshold() const;
 
 private:
     Core::Property *mStartingPointProperty;
     Core::Property *mEndingPointProperty;
     Core::Property *mPointIntervalProperty;
+    Core::Property *mModeProperty;
+    Core::Property *mPeriodProperty;
+    Core::Property *mPeriodToleranceProperty;
+    Core::Property *mKeptCyclesProperty;
+    Core::Property *mRecordingProperty;
+    Core::Property *mRecordingIntervalProperty;
+    Core::Property *mRecordingThresholdProperty;
+
+    bool mOdeModel;
 
     QMap<QString, Core::PropertyEditorWidgetGuiState *> mGuiStates;
     Core::PropertyEditorWidgetGuiState *mDefaultGuiState;
+
+    void updateModes();
 };
 
 //==============================================================================
@@ -5,16 +5,22 @@
 #include "cellmlfileruntime.h"
 #include "corenlasolver.h"
 #include "singlecellsimulationviewcontentswidget.h"
+#include "singlecellsimulationviewcsvexporter.h"
 #include "singlecellsimulationviewinformationsimulationwidget.h"
 #include "singlecellsimulationviewinformationwidget.h"
 #include "singlecellsimulationviewsimulation.h"
+#include "singlecellsimulationviewsimulationcheckpoint.h"
+#include "singlecellsimulationviewsimulationresultscache.h"
+#include "singlecellsimulationviewtimeseriescodec.h"
 #include "singlecellsimulationviewwidget.h"
 #include "solverinterface.h"
 
 //==============================================================================
 
+#include <QCryptographicHash>
 #include <QFile>
-#include <QTextStream>
+#include <QMutexLocker>
+#include <QRunnable>
 
 //==============================================================================
 
@@ -39,19 +45,33 @@ SingleCellSimulationViewSimulationData::SingleCellSimulationViewSimulationData(C
     mStartingPoint(0.0),
     mEndingPoint(1000.0),
     mPointInterval(1.0),
+    mSteadyState(false),
+    mParallelInTime(false),
+    mPeriod(0.0),
+    mPeriodTolerance(1.0e-6),
+    mKeptCycles(1),
+    mRecordingPolicy(AllPoints),
+    mRecordingInterval(10),
+    mRecordingThreshold(1.0e-2),
+    mRevision(0),
     mOdeSolverName(QString()),
     mOdeSolverProperties(CoreSolver::Properties()),
     mDaeSolverName(QString()),
     mDaeSolverProperties(CoreSolver::Properties()),
     mNlaSolverName(QString()),
-    mNlaSolverProperties(CoreSolver::Properties())
+    mNlaSolverProperties(CoreSolver::Properties()),
+    mSensitivityParameters(QList<QPair<QString, QString> >())
 {
     // Create our various arrays, if possible
 
     if (pRuntime) {
         // Create our various arrays to compute our model
+        // Note: our constants array is big enough to also hold the number and
+        //       indexes of the constants with respect to which we want to
+        //       compute the sensitivity of our states (see
+        //       CellmlFileRuntime::update())...
 
-        mConstants = new double[pRuntime->constantsCount()];
+        mConstants = new double[2*pRuntime->constantsCount()+1];
         mStates    = new double[pRuntime->statesCount()];
         mRates     = new double[pRuntime->ratesCount()];
         mAlgebraic = new double[pRuntime->algebraicCount()];
@@ -61,9 +81,15 @@ SingleCellSimulationViewSimulationData::SingleCellSimulationViewSimulationData(C
 
         mInitialConstants = new double[pRuntime->constantsCount()];
         mInitialStates    = new double[pRuntime->statesCount()];
+
+        // Create our array to keep track of the states from which our last run
+        // started
+
+        mStartingStates = new double[pRuntime->statesCount()];
     } else {
         mConstants = mStates = mRates = mAlgebraic = mCondVar = 0;
         mInitialConstants = mInitialStates = 0;
+        mStartingStates = 0;
     }
 }
 
@@ -81,6 +107,8 @@ SingleCellSimulationViewSimulationData::~SingleCellSimulationViewSimulationData(
 
     delete[] mInitialConstants;
     delete[] mInitialStates;
+
+    delete[] mStartingStates;
 }
 
 //==============================================================================
@@ -130,6 +158,28 @@ double * SingleCellSimulationViewSimulationData::condVar() const
 
 //==============================================================================
 
+double * SingleCellSimulationViewSimulationData::startingStates() const
+{
+    // Return the states from which our last run started
+
+    return mStartingStates;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationData::updateStartingStates()
+{
+    // Keep track of our current states as those from which our next run will
+    // start
+    // Note: unlike our states, those don't evolve while we are running, so they
+    //       can be used to identify a run even after it has been stopped (see
+    //       SingleCellSimulationViewSimulation::computeCacheKey())...
+
+    memcpy(mStartingStates, mStates, mRuntime->statesCount()*sizeof(double));
+}
+
+//==============================================================================
+
 int SingleCellSimulationViewSimulationData::delay() const
 {
     // Return our delay
@@ -208,6 +258,162 @@ void SingleCellSimulationViewSimulationData::setPointInterval(const double &pPoi
 
 //==============================================================================
 
+bool SingleCellSimulationViewSimulationData::steadyState() const
+{
+    // Return whether we want to compute a steady state rather than a time
+    // course
+    // Note: we can only compute the steady state of an ODE model (see
+    //       SingleCellSimulationViewSimulationWorker::run()), so we ignore the
+    //       request for any other type of model...
+
+    return    mSteadyState && mRuntime
+           && (mRuntime->modelType() == CellMLSupport::CellmlFileRuntime::Ode);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationData::setSteadyState(const bool &pSteadyState)
+{
+    // Set whether we want to compute a steady state rather than a time course
+
+    mSteadyState = pSteadyState;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationData::parallelInTime() const
+{
+    // Return whether we want to compute our time course in parallel
+
+    return mParallelInTime;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationData::setParallelInTime(const bool &pParallelInTime)
+{
+    // Set whether we want to compute our time course in parallel
+
+    mParallelInTime = pParallelInTime;
+}
+
+//==============================================================================
+
+double SingleCellSimulationViewSimulationData::period() const
+{
+    // Return our period
+
+    return mPeriod;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationData::setPeriod(const double &pPeriod)
+{
+    // Set our period
+    // Note: a period of zero means that we don't want to check whether our
+    //       model has reached a periodic steady state...
+
+    mPeriod = pPeriod;
+}
+
+//==============================================================================
+
+double SingleCellSimulationViewSimulationData::periodTolerance() const
+{
+    // Return our period tolerance
+
+    return mPeriodTolerance;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationData::setPeriodTolerance(const double &pPeriodTolerance)
+{
+    // Set our period tolerance
+
+    mPeriodTolerance = pPeriodTolerance;
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewSimulationData::keptCycles() const
+{
+    // Return the number of cycles we want to keep
+
+    return mKeptCycles;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationData::setKeptCycles(const int &pKeptCycles)
+{
+    // Set the number of cycles we want to keep
+    // Note: zero means that we want to keep all our cycles...
+
+    mKeptCycles = pKeptCycles;
+}
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationData::RecordingPolicy SingleCellSimulationViewSimulationData::recordingPolicy() const
+{
+    // Return our recording policy
+
+    return mRecordingPolicy;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationData::setRecordingPolicy(const RecordingPolicy &pRecordingPolicy)
+{
+    // Set our recording policy, i.e. which of the points computed by our
+    // solver we want to keep in our results
+
+    mRecordingPolicy = pRecordingPolicy;
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewSimulationData::recordingInterval() const
+{
+    // Return our recording interval
+
+    return mRecordingInterval;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationData::setRecordingInterval(const int &pRecordingInterval)
+{
+    // Set our recording interval, i.e. the number of points we want to skip
+    // (EveryNthPoint) or to put in a bucket (MinMaxPerBucket)
+
+    mRecordingInterval = pRecordingInterval;
+}
+
+//==============================================================================
+
+double SingleCellSimulationViewSimulationData::recordingThreshold() const
+{
+    // Return our recording threshold
+
+    return mRecordingThreshold;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationData::setRecordingThreshold(const double &pRecordingThreshold)
+{
+    // Set our recording threshold, i.e. the relative change that any of our
+    // states or algebraic variables must undergo for a point to be recorded
+    // (OnChange)
+
+    mRecordingThreshold = pRecordingThreshold;
+}
+
+//==============================================================================
+
 QString SingleCellSimulationViewSimulationData::odeSolverName() const
 {
     // Return our ODE solver name
@@ -345,6 +551,82 @@ void SingleCellSimulationViewSimulationData::addNlaSolverProperty(const QString
 
 //==============================================================================
 
+bool SingleCellSimulationViewSimulationData::canComputeSensitivities() const
+{
+    // Return whether we can compute the sensitivity of our states, which we
+    // can only do for ODE models
+
+    return    mRuntime && mRuntime->isValid()
+           && (mRuntime->modelType() == CellMLSupport::CellmlFileRuntime::Ode)
+           && mRuntime->computeSensitivityRates();
+}
+
+//==============================================================================
+
+CellMLSupport::CellmlFileRuntimeModelParameters SingleCellSimulationViewSimulationData::sensitivityParameters() const
+{
+    // Return the constants with respect to which we want to compute the
+    // sensitivity of our states
+    // Note: we keep track of our constants by component and name rather than
+    //       by model parameter since the model parameters of our runtime get
+    //       recreated every time our runtime gets updated...
+
+    CellMLSupport::CellmlFileRuntimeModelParameters res = CellMLSupport::CellmlFileRuntimeModelParameters();
+
+    if (!canComputeSensitivities())
+        return res;
+
+    for (int i = 0, iMax = mSensitivityParameters.count(); i < iMax; ++i) {
+        CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter = mRuntime->modelParameter(mSensitivityParameters[i].first,
+                                                                                                  mSensitivityParameters[i].second);
+
+        if (   modelParameter
+            && (modelParameter->type() == CellMLSupport::CellmlFileRuntimeModelParameter::Constant))
+            res << modelParameter;
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationData::isSensitivityParameter(CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter) const
+{
+    // Return whether the given model parameter is one of the constants with
+    // respect to which we want to compute the sensitivity of our states
+
+    return    pModelParameter
+           && mSensitivityParameters.contains(qMakePair(pModelParameter->component(),
+                                                        pModelParameter->name()));
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationData::setSensitivityParameter(CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter,
+                                                                     const bool &pSensitive)
+{
+    // Add/remove the given model parameter to/from the list of constants with
+    // respect to which we want to compute the sensitivity of our states
+    // Note: only 'proper' constants are of interest since 'computed constants'
+    //       are, well, computed from them...
+
+    if (   !canComputeSensitivities() || !pModelParameter
+        || (pModelParameter->type() != CellMLSupport::CellmlFileRuntimeModelParameter::Constant))
+        return;
+
+    QPair<QString, QString> sensitivityParameter = qMakePair(pModelParameter->component(),
+                                                             pModelParameter->name());
+
+    if (pSensitive) {
+        if (!mSensitivityParameters.contains(sensitivityParameter))
+            mSensitivityParameters << sensitivityParameter;
+    } else {
+        mSensitivityParameters.removeOne(sensitivityParameter);
+    }
+}
+
+//==============================================================================
+
 void SingleCellSimulationViewSimulationData::reset()
 {
     // Reset our model parameter values which means both initialising our
@@ -410,6 +692,7 @@ void SingleCellSimulationViewSimulationData::reset()
 
     memcpy(mInitialConstants, mConstants, mRuntime->constantsCount()*SizeOfDouble);
     memcpy(mInitialStates, mStates, mRuntime->statesCount()*SizeOfDouble);
+    memcpy(mStartingStates, mStates, mRuntime->statesCount()*SizeOfDouble);
 
     // Let people know that our data is 'cleaned', i.e. not modified
 
@@ -418,8 +701,24 @@ void SingleCellSimulationViewSimulationData::reset()
 
 //==============================================================================
 
+int SingleCellSimulationViewSimulationData::revision() const
+{
+    // Return our revision, which gets increased every time our 'constants' or
+    // 'states' may have been modified (see
+    // recomputeComputedConstantsAndVariables())
+
+    return mRevision;
+}
+
+//==============================================================================
+
 void SingleCellSimulationViewSimulationData::recomputeComputedConstantsAndVariables()
 {
+    // Our 'constants' or 'states' may have been modified (or reset), so
+    // increase our revision
+
+    ++mRevision;
+
     // Recompute our 'computed constants' and 'variables', if possible
 
     if (mRuntime && mRuntime->isValid()) {
@@ -457,28 +756,20 @@ void SingleCellSimulationViewSimulationData::checkForModifications()
 {
     // Check whether any of our constants or states has been modified
 
-    foreach (CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter, mRuntime->modelParameters())
-        switch (modelParameter->type()) {
-        case CellMLSupport::CellmlFileRuntimeModelParameter::Constant:
-            if (mConstants[modelParameter->index()] != mInitialConstants[modelParameter->index()]) {
-                emit modified(true);
-
-                return;
-            }
-
-            break;
-        case CellMLSupport::CellmlFileRuntimeModelParameter::State:
-            if (mStates[modelParameter->index()] != mInitialStates[modelParameter->index()]) {
-                emit modified(true);
+    foreach (CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter,
+             mRuntime->modelParameters(CellMLSupport::CellmlFileRuntimeModelParameter::Constant))
+        if (mConstants[modelParameter->index()] != mInitialConstants[modelParameter->index()]) {
+            emit modified(true);
 
-                return;
-            }
+            return;
+        }
 
-            break;
-        default:
-            // Either Voi, ComputedConstant, Rate, Algebraic or Undefined, so...
+    foreach (CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter,
+             mRuntime->modelParameters(CellMLSupport::CellmlFileRuntimeModelParameter::State))
+        if (mStates[modelParameter->index()] != mInitialStates[modelParameter->index()]) {
+            emit modified(true);
 
-            ;
+            return;
         }
 
     // Let people know that no data has been modified
@@ -493,12 +784,33 @@ SingleCellSimulationViewSimulationResults::SingleCellSimulationViewSimulationRes
     mRuntime(pRuntime),
     mSimulation(pSimulation),
     mSize(0),
+    mCapacity(0),
+    mCyclesCount(0),
     mPoints(0),
     mConstants(0),
     mStates(0),
     mRates(0),
-    mAlgebraic(0)
+    mAlgebraic(0),
+    mSensitivityParameters(CellMLSupport::CellmlFileRuntimeModelParameters()),
+    mSensitivities(0),
+    mRecordingPolicy(SingleCellSimulationViewSimulationData::AllPoints),
+    mRecordingInterval(1),
+    mRecordingThreshold(0.0),
+    mRecordingCounter(0),
+    mPendingSize(0),
+    mRecordingArrays(QVector<double *>()),
+    mTrackedArrays(QVector<double *>()),
+    mMinimumFirst(QVector<bool>()),
+    mResultsFile(0),
+    mResultsFileColumns(QVector<double *>()),
+    mCompressionCancelled(0),
+    mCompressed(false),
+    mCompressedData(QVector<QByteArray>())
 {
+    // Compress and store our results one at a time
+
+    mCompressionThreadPool.setMaxThreadCount(1);
+    mStorageThreadPool.setMaxThreadCount(1);
 }
 
 //==============================================================================
@@ -507,18 +819,25 @@ SingleCellSimulationViewSimulationResults::~SingleCellSimulationViewSimulationRe
 {
     // Delete some internal objects
 
+    cancelCompression();
+    waitForStorage();
+
+    stopStreaming();
+
     deleteArrays();
+
+    qDeleteAll(mSensitivityParameters);
 }
 
 //==============================================================================
 
-bool SingleCellSimulationViewSimulationResults::createArrays()
+bool SingleCellSimulationViewSimulationResults::createArrays(const qulonglong &pSize)
 {
     static const int SizeOfDoublePointer = sizeof(double *);
 
-    // Retrieve the size of our data and make sure that it is valid
+    // Make sure that the size of our data is valid
 
-    qulonglong simulationSize = qulonglong(mSimulation->size());
+    qulonglong simulationSize = pSize;
 
     if (!simulationSize)
         return true;
@@ -615,7 +934,39 @@ bool SingleCellSimulationViewSimulationResults::createArrays()
             return false;
         }
 
-    // We could allocate all of our required memory, so...
+    // Create our sensitivities arrays, if needed
+    // Note: there is one array for each state and each of the constants with
+    //       respect to which we want to compute the sensitivity of our states,
+    //       i.e. the sensitivity of state i with respect to the jth constant is
+    //       to be found in mSensitivities[j*statesCount+i]...
+
+    if (mSensitivityParameters.count()) {
+        int sensitivitiesCount = mSensitivityParameters.count()*mRuntime->statesCount();
+
+        try {
+            mSensitivities = new double*[sensitivitiesCount];
+
+            memset(mSensitivities, 0, sensitivitiesCount*SizeOfDoublePointer);
+        } catch(...) {
+            deleteArrays();
+
+            return false;
+        }
+
+        for (int i = 0; i < sensitivitiesCount; ++i)
+            try {
+                mSensitivities[i] = new double[simulationSize];
+            } catch(...) {
+                deleteArrays();
+
+                return false;
+            }
+    }
+
+    // We could allocate all of our required memory, so keep track of how many
+    // points we can hold
+
+    mCapacity = simulationSize;
 
     return true;
 }
@@ -624,6 +975,10 @@ bool SingleCellSimulationViewSimulationResults::createArrays()
 
 void SingleCellSimulationViewSimulationResults::deleteArrays()
 {
+    // We cannot hold any point anymore
+
+    mCapacity = 0;
+
     // Delete our points array
 
     delete[] mPoints;
@@ -669,191 +1024,1104 @@ void SingleCellSimulationViewSimulationResults::deleteArrays()
     delete mAlgebraic;
 
     mAlgebraic = 0;
+
+    // Delete our sensitivities arrays
+
+    if (mSensitivities)
+        for (int i = 0, iMax = mSensitivityParameters.count()*mRuntime->statesCount(); i < iMax; ++i)
+            delete[] mSensitivities[i];
+
+    delete[] mSensitivities;
+
+    mSensitivities = 0;
 }
 
 //==============================================================================
 
 bool SingleCellSimulationViewSimulationResults::reset(const bool &pCreateArrays)
 {
-    // Reset our size
+    // Stop streaming and compressing our results, if needed, wait for them to
+    // be stored, if needed, and forget about our compressed results, if any
+
+    stopStreaming();
+
+    cancelCompression();
+    waitForStorage();
+
+    mCompressed = false;
+    mCompressedData.clear();
+
+    QMutexLocker locker(&mMutex);
+
+    // Reset our size and number of cycles
 
     mSize = 0;
+    mCyclesCount = 0;
 
     // Reset our arrays
 
     deleteArrays();
 
-    return pCreateArrays?createArrays():true;
-}
+    updateRecordingArrays();
 
-//==============================================================================
+    // Keep track of our recording policy
+    // Note: like for our sensitivity parameters below, we need our own copy
+    //       since the user may change it while we are running...
 
-void SingleCellSimulationViewSimulationResults::addPoint(const double &pPoint)
-{
-    // Add the data to our different arrays
+    mRecordingPolicy    = mSimulation->data()->recordingPolicy();
+    mRecordingInterval  = qMax(1, mSimulation->data()->recordingInterval());
+    mRecordingThreshold = qAbs(mSimulation->data()->recordingThreshold());
+    mRecordingCounter   = 0;
+    mPendingSize        = 0;
 
-    mPoints[mSize] = pPoint;
+    if (mRecordingInterval == 1) {
+        if (   (mRecordingPolicy == SingleCellSimulationViewSimulationData::EveryNthPoint)
+            || (mRecordingPolicy == SingleCellSimulationViewSimulationData::MinMaxPerBucket))
+            mRecordingPolicy = SingleCellSimulationViewSimulationData::AllPoints;
+    }
 
-    for (int i = 0, iMax = mRuntime->constantsCount(); i < iMax; ++i)
-        mConstants[i][mSize] = mSimulation->data()->constants()[i];
+    // Keep track of the constants with respect to which we want to compute the
+    // sensitivity of our states
+    // Note #1: we need our own copy of them since the user may change the list
+    //          while we are running and since the model parameters of our
+    //          runtime get recreated every time our runtime gets updated...
+    // Note #2: we don't compute any sensitivity when solving for a steady
+    //          state (see SingleCellSimulationViewSimulationWorker::run())...
 
-    for (int i = 0, iMax = mRuntime->statesCount(); i < iMax; ++i)
-        mStates[i][mSize] = mSimulation->data()->states()[i];
+    qDeleteAll(mSensitivityParameters);
 
-    for (int i = 0, iMax = mRuntime->ratesCount(); i < iMax; ++i)
-        mRates[i][mSize] = mSimulation->data()->rates()[i];
+    mSensitivityParameters.clear();
 
-    for (int i = 0, iMax = mRuntime->algebraicCount(); i < iMax; ++i)
-        mAlgebraic[i][mSize] = mSimulation->data()->algebraic()[i];
+    if (pCreateArrays && !mSimulation->data()->steadyState())
+        foreach (CellMLSupport::CellmlFileRuntimeModelParameter *sensitivityParameter,
+                 mSimulation->data()->sensitivityParameters())
+            mSensitivityParameters << new CellMLSupport::CellmlFileRuntimeModelParameter(*sensitivityParameter);
+
+    if (!pCreateArrays)
+        return true;
+
+    if (!createArrays(qulonglong(mSimulation->recordedSize())))
+        return false;
 
-    // Increase our size
+    updateRecordingArrays();
 
-    ++mSize;
+    return true;
 }
 
 //==============================================================================
 
-qulonglong SingleCellSimulationViewSimulationResults::size() const
+void SingleCellSimulationViewSimulationResults::updateRecordingArrays()
 {
-    // Return our size
+    // Keep track of the arrays that our recording policy needs
 
-    return mSize;
-}
+    mRecordingArrays.clear();
+    mTrackedArrays.clear();
+    mMinimumFirst.clear();
 
-//==============================================================================
+    if (!mPoints)
+        return;
 
-double * SingleCellSimulationViewSimulationResults::points() const
-{
-    // Return our points
+    mRecordingArrays = arrays();
 
-    return mPoints;
+    if (mRecordingPolicy == SingleCellSimulationViewSimulationData::OnChange) {
+        for (int i = 0, iMax = mRuntime->statesCount(); i < iMax; ++i)
+            mTrackedArrays << mStates[i];
+
+        for (int i = 0, iMax = mRuntime->algebraicCount(); i < iMax; ++i)
+            mTrackedArrays << mAlgebraic[i];
+    } else if (mRecordingPolicy == SingleCellSimulationViewSimulationData::MinMaxPerBucket) {
+        mMinimumFirst.fill(true, mRecordingArrays.count());
+    }
 }
 
 //==============================================================================
 
-double ** SingleCellSimulationViewSimulationResults::constants() const
+void SingleCellSimulationViewSimulationResults::storePoint(const qulonglong &pIndex,
+                                                           const double &pPoint,
+                                                           const double *pSensitivities)
 {
-    // Return our constants array
+    // Store the data at the given index of our different arrays
 
-    return mConstants;
-}
+    mPoints[pIndex] = pPoint;
 
-//==============================================================================
+    for (int i = 0, iMax = mRuntime->constantsCount(); i < iMax; ++i)
+        mConstants[i][pIndex] = mSimulation->data()->constants()[i];
 
-double ** SingleCellSimulationViewSimulationResults::states() const
-{
-    // Return our states array
+    for (int i = 0, iMax = mRuntime->statesCount(); i < iMax; ++i)
+        mStates[i][pIndex] = mSimulation->data()->states()[i];
 
-    return mStates;
+    for (int i = 0, iMax = mRuntime->ratesCount(); i < iMax; ++i)
+        mRates[i][pIndex] = mSimulation->data()->rates()[i];
+
+    for (int i = 0, iMax = mRuntime->algebraicCount(); i < iMax; ++i)
+        mAlgebraic[i][pIndex] = mSimulation->data()->algebraic()[i];
+
+    if (mSensitivities && pSensitivities)
+        for (int i = 0, iMax = mSensitivityParameters.count()*mRuntime->statesCount(); i < iMax; ++i)
+            mSensitivities[i][pIndex] = pSensitivities[i];
 }
 
 //==============================================================================
 
-double ** SingleCellSimulationViewSimulationResults::rates() const
+void SingleCellSimulationViewSimulationResults::recordPoints(const qulonglong &pNumberOfPoints)
 {
-    // Return our rates array
+    // Record the given number of points, i.e. the ones that are stored right
+    // after our current last point, by increasing our size and streaming them,
+    // if needed
 
-    return mRates;
-}
+    QMutexLocker locker(&mMutex);
 
-//==============================================================================
+    qulonglong oldSize = mSize;
 
-double ** SingleCellSimulationViewSimulationResults::algebraic() const
-{
-    // Return our algebraic array
+    mSize += pNumberOfPoints;
 
-    return mAlgebraic;
+    if (mResultsFile)
+        mResultsFile->addPoints(mResultsFileColumns.constData(), oldSize, mSize);
 }
 
 //==============================================================================
 
-bool SingleCellSimulationViewSimulationResults::exportToCsv(const QString &pFileName) const
+bool SingleCellSimulationViewSimulationResults::hasChanged(const qulonglong &pIndex) const
 {
-    // Export of all of our data to a CSV file
+    // Return whether any of our tracked variables has changed, relative to our
+    // last recorded point, by more than our recording threshold
+    // Note: a relative change is meaningless for a value that is (close to)
+    //       zero (e.g. a state that starts at zero would otherwise be recorded
+    //       at every point until it moves away from zero), hence we use an
+    //       absolute floor for our last value...
 
-    QFile file(pFileName);
+    static const double AbsoluteTolerance = 1.0e-6;
 
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        // The file can't be opened, so...
+    if (!mSize)
+        return true;
 
-        file.remove();
+    foreach (double *trackedArray, mTrackedArrays) {
+        double lastValue = trackedArray[mSize-1];
 
-        return false;
+        if (qAbs(trackedArray[pIndex]-lastValue) > mRecordingThreshold*qMax(qAbs(lastValue), AbsoluteTolerance))
+            return true;
     }
 
-    // Write out the contents of the CellML file to the file
+    return false;
+}
 
-    QTextStream out(&file);
+//==============================================================================
 
-    // Header
+void SingleCellSimulationViewSimulationResults::closeBucket()
+{
+    // Our current bucket, which minimum and maximum values are stored in our
+    // first and second pending points, is full (or we are done), so put, for
+    // each array, its minimum and maximum values in the order in which they
+    // were reached and record our bucket
+    // Note: our points array is not concerned since our first and second
+    //       pending points hold the first and last point of our bucket...
+
+    if (!mPendingSize)
+        return;
+
+    if (mPendingSize == 1) {
+        recordPoints(1);
+    } else {
+        qulonglong minimumIndex = mSize;
+        qulonglong maximumIndex = mSize+1;
 
-    static const QString Header = "%1 | %2 (%3)";
+        for (int i = 1, iMax = mRecordingArrays.count(); i < iMax; ++i)
+            if (!mMinimumFirst[i]) {
+                double *array = mRecordingArrays[i];
 
-    out << Header.arg(mRuntime->variableOfIntegration()->component(),
-                      mRuntime->variableOfIntegration()->name(),
-                      mRuntime->variableOfIntegration()->unit());
+                qSwap(array[minimumIndex], array[maximumIndex]);
+            }
 
-    for (int i = 0, iMax = mRuntime->modelParameters().count(); i < iMax; ++i) {
-        CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter = mRuntime->modelParameters()[i];
+        recordPoints(2);
+    }
+
+    mPendingSize = 0;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResults::addPoint(const double &pPoint,
+                                                         const double *pSensitivities)
+{
+    // Add the data to our different arrays, based on our recording policy
+    // Note: our arrays are big enough to hold all the points that our
+    //       recording policy may need to record, as well as the ones that have
+    //       yet to be recorded (see SingleCellSimulationViewSimulation::recordedSize())...
+
+    // Make sure that we have room for our new point
+    // Note: this should never happen, but we would rather lose a point than
+    //       write past the end of our arrays should our size and that of our
+    //       simulation ever disagree...
+
+    qulonglong lastIndex = mSize;
+
+    if (mRecordingPolicy == SingleCellSimulationViewSimulationData::OnChange)
+        lastIndex += mPendingSize;
+    else if (mRecordingPolicy == SingleCellSimulationViewSimulationData::MinMaxPerBucket)
+        lastIndex += mPendingSize?2:1;
+
+    if (!mPoints || (lastIndex >= mCapacity))
+        return;
+
+    switch (mRecordingPolicy) {
+    case SingleCellSimulationViewSimulationData::EveryNthPoint:
+        // Store our new point, but only record it if it is an Nth point, or
+        // keep it pending, so that we can still record it should it be our
+        // last point (see flushPoints())
+
+        storePoint(mSize, pPoint, pSensitivities);
+
+        if (!(mRecordingCounter++ % mRecordingInterval)) {
+            mPendingSize = 0;
+
+            recordPoints(1);
+        } else {
+            mPendingSize = 1;
+        }
+
+        break;
+    case SingleCellSimulationViewSimulationData::OnChange: {
+        // Store our new point after our pending point, if any, and record
+        // both of them if any of our tracked variables has changed enough
+        // Note: recording our pending point means that we also record the
+        //       point right before a sudden change (e.g. an upstroke), so that
+        //       the change doesn't get smeared...
+
+        qulonglong index = mSize+mPendingSize;
+
+        storePoint(index, pPoint, pSensitivities);
+
+        if (hasChanged(index)) {
+            recordPoints(mPendingSize+1);
+
+            mPendingSize = 0;
+        } else {
+            if (mPendingSize)
+                foreach (double *array, mRecordingArrays)
+                    array[mSize] = array[index];
+
+            mPendingSize = 1;
+        }
+
+        break;
+    }
+    case SingleCellSimulationViewSimulationData::MinMaxPerBucket:
+        // Store our new point as both the minimum and maximum of a new bucket,
+        // or update the minimum and maximum values of our current bucket
+
+        if (!mPendingSize) {
+            storePoint(mSize, pPoint, pSensitivities);
+
+            foreach (double *array, mRecordingArrays)
+                array[mSize+1] = array[mSize];
+
+            mPendingSize = 1;
+        } else {
+            qulonglong minimumIndex = mSize;
+            qulonglong maximumIndex = mSize+1;
+            qulonglong index = mSize+2;
+
+            storePoint(index, pPoint, pSensitivities);
+
+            mPoints[maximumIndex] = pPoint;
+
+            for (int i = 1, iMax = mRecordingArrays.count(); i < iMax; ++i) {
+                double *array = mRecordingArrays[i];
+                double value = array[index];
+
+                if (value < array[minimumIndex]) {
+                    array[minimumIndex] = value;
+
+                    mMinimumFirst[i] = false;
+                } else if (value > array[maximumIndex]) {
+                    array[maximumIndex] = value;
+
+                    mMinimumFirst[i] = true;
+                }
+            }
+
+            ++mPendingSize;
+        }
+
+        if (mPendingSize == qulonglong(mRecordingInterval))
+            closeBucket();
+
+        break;
+    default:
+        // AllPoints, so store and record our new point
+
+        storePoint(mSize, pPoint, pSensitivities);
+
+        recordPoints(1);
+    }
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResults::flushPoints()
+{
+    // Record whatever our recording policy has yet to record, so that our last
+    // point always ends up in our results
+
+    if (mRecordingPolicy == SingleCellSimulationViewSimulationData::MinMaxPerBucket) {
+        closeBucket();
+    } else if (mPendingSize) {
+        recordPoints(mPendingSize);
+
+        mPendingSize = 0;
+    }
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResults::discardPoints(const qulonglong &pNumberOfPoints)
+{
+    // Discard the given number of points from the beginning of our different
+    // arrays
+
+    static const int SizeOfDouble = sizeof(double);
+
+    QMutexLocker locker(&mMutex);
+
+    if (!pNumberOfPoints || (pNumberOfPoints > mSize))
+        return;
+
+    qulonglong newSize = mSize-pNumberOfPoints;
+    size_t newSizeInBytes = newSize*SizeOfDouble;
+
+    memmove(mPoints, mPoints+pNumberOfPoints, newSizeInBytes);
+
+    for (int i = 0, iMax = mRuntime->constantsCount(); i < iMax; ++i)
+        memmove(mConstants[i], mConstants[i]+pNumberOfPoints, newSizeInBytes);
+
+    for (int i = 0, iMax = mRuntime->statesCount(); i < iMax; ++i)
+        memmove(mStates[i], mStates[i]+pNumberOfPoints, newSizeInBytes);
+
+    for (int i = 0, iMax = mRuntime->ratesCount(); i < iMax; ++i)
+        memmove(mRates[i], mRates[i]+pNumberOfPoints, newSizeInBytes);
+
+    for (int i = 0, iMax = mRuntime->algebraicCount(); i < iMax; ++i)
+        memmove(mAlgebraic[i], mAlgebraic[i]+pNumberOfPoints, newSizeInBytes);
+
+    if (mSensitivities)
+        for (int i = 0, iMax = mSensitivityParameters.count()*mRuntime->statesCount(); i < iMax; ++i)
+            memmove(mSensitivities[i], mSensitivities[i]+pNumberOfPoints, newSizeInBytes);
+
+    // Update our size
+
+    mSize = newSize;
+}
+
+//==============================================================================
+
+qulonglong SingleCellSimulationViewSimulationResults::size() const
+{
+    // Return our size
+
+    return mSize;
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewSimulationResults::cyclesCount() const
+{
+    // Return the number of cycles that were needed to reach a periodic steady
+    // state, or zero if none was reached
+
+    return mCyclesCount;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResults::setCyclesCount(const int &pCyclesCount)
+{
+    // Set the number of cycles that were needed to reach a periodic steady
+    // state
+
+    mCyclesCount = pCyclesCount;
+}
+
+//==============================================================================
+
+double * SingleCellSimulationViewSimulationResults::points() const
+{
+    // Return our points
+
+    return mPoints;
+}
+
+//==============================================================================
+
+double ** SingleCellSimulationViewSimulationResults::constants() const
+{
+    // Return our constants array
+
+    return mConstants;
+}
+
+//==============================================================================
+
+double ** SingleCellSimulationViewSimulationResults::states() const
+{
+    // Return our states array
+
+    return mStates;
+}
+
+//==============================================================================
+
+double ** SingleCellSimulationViewSimulationResults::rates() const
+{
+    // Return our rates array
+
+    return mRates;
+}
+
+//==============================================================================
+
+double ** SingleCellSimulationViewSimulationResults::algebraic() const
+{
+    // Return our algebraic array
+
+    return mAlgebraic;
+}
+
+//==============================================================================
+
+CellMLSupport::CellmlFileRuntimeModelParameters SingleCellSimulationViewSimulationResults::sensitivityParameters() const
+{
+    // Return the constants for which we have sensitivities
+
+    return mSensitivityParameters;
+}
+
+//==============================================================================
+
+double ** SingleCellSimulationViewSimulationResults::sensitivities() const
+{
+    // Return our sensitivities array
+
+    return mSensitivities;
+}
+
+//==============================================================================
+
+double * SingleCellSimulationViewSimulationResults::sensitivities(CellMLSupport::CellmlFileRuntimeModelParameter *pState,
+                                                                  CellMLSupport::CellmlFileRuntimeModelParameter *pConstant) const
+{
+    // Return the sensitivities of the given state with respect to the given
+    // constant, if we have them
+    // Note: our constant is looked up by component and name since it may come
+    //       from a runtime that has since been updated...
+
+    if (   !mSensitivities || !pState || !pConstant
+        || (pState->type() != CellMLSupport::CellmlFileRuntimeModelParameter::State))
+        return 0;
+
+    for (int k = 0, kMax = mSensitivityParameters.count(); k < kMax; ++k)
+        if (   !mSensitivityParameters[k]->component().compare(pConstant->component())
+            && !mSensitivityParameters[k]->name().compare(pConstant->name()))
+            return mSensitivities[k*mRuntime->statesCount()+pState->index()];
+
+    return 0;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResults::exportToCsv(const QString &pFileName) const
+{
+    // Export of all of our data to a CSV file
+
+    // Header
+
+    static const QString Header = "%1 | %2 (%3)";
+
+    QString header = Header.arg(mRuntime->variableOfIntegration()->component(),
+                                mRuntime->variableOfIntegration()->name(),
+                                mRuntime->variableOfIntegration()->unit());
+
+    const CellMLSupport::CellmlFileRuntimeModelParameters &modelParameters = mRuntime->modelParameters();
+
+    foreach (CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter, modelParameters) {
+        header += ","+Header.arg(modelParameter->component(),
+                                 modelParameter->name()+QString(modelParameter->degree(), '\''),
+                                 modelParameter->unit());
+    }
+
+    static const QString SensitivityHeader = "d(%1 | %2)/d(%3 | %4) (%5/%6)";
+
+    const CellMLSupport::CellmlFileRuntimeModelParameters &states = mRuntime->modelParameters(CellMLSupport::CellmlFileRuntimeModelParameter::State);
+
+    if (mSensitivities) {
+        foreach (CellMLSupport::CellmlFileRuntimeModelParameter *sensitivityParameter, mSensitivityParameters)
+            foreach (CellMLSupport::CellmlFileRuntimeModelParameter *state, states)
+                header += ","+SensitivityHeader.arg(state->component(),
+                                                    state->name(),
+                                                    sensitivityParameter->component(),
+                                                    sensitivityParameter->name(),
+                                                    state->unit(),
+                                                    sensitivityParameter->unit());
+    }
+
+    // Data itself
+
+    QVector<const double *> columns = QVector<const double *>();
+
+    columns << mPoints;
+
+    foreach (CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter, modelParameters) {
+        switch (modelParameter->type()) {
+        case CellMLSupport::CellmlFileRuntimeModelParameter::Constant:
+        case CellMLSupport::CellmlFileRuntimeModelParameter::ComputedConstant:
+            columns << mConstants[modelParameter->index()];
+
+            break;
+        case CellMLSupport::CellmlFileRuntimeModelParameter::State:
+            columns << mStates[modelParameter->index()];
+
+            break;
+        case CellMLSupport::CellmlFileRuntimeModelParameter::Rate:
+            columns << mRates[modelParameter->index()];
+
+            break;
+        case CellMLSupport::CellmlFileRuntimeModelParameter::Algebraic:
+            columns << mAlgebraic[modelParameter->index()];
+
+            break;
+        default:
+            // Either Voi or Undefined, so...
+
+            ;
+        }
+    }
+
+    for (int k = 0, kMax = mSensitivityParameters.count(), statesCount = mRuntime->statesCount(); k < kMax; ++k)
+        foreach (CellMLSupport::CellmlFileRuntimeModelParameter *state, states)
+            columns << mSensitivities[k*statesCount+state->index()];
+
+    // Export our header and data, formatting the latter in parallel
+
+    return SingleCellSimulationViewCsvExporter(header, columns, mSize).exportTo(pFileName);
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResults::exportToBinary(const QString &pFileName,
+                                                               const bool &pStream)
+{
+    // Export all of our data to a binary file and keep streaming new data to
+    // it, if requested (i.e. while we are running)
+    // Note: points discarded once streamed (see discardPoints()) remain in the
+    //       file...
+
+    stopStreaming();
+
+    QMutexLocker locker(&mMutex);
+
+    // Determine our columns, as well as where to find their stored values
+
+    SingleCellSimulationViewSimulationResultsFileColumns columns = SingleCellSimulationViewSimulationResultsFileColumns();
+    QVector<double *> storedValues = QVector<double *>();
+
+    CellMLSupport::CellmlFileRuntimeModelParameter *voi = mRuntime->variableOfIntegration();
+
+    columns << SingleCellSimulationViewSimulationResultsFileColumn(voi->type(), voi->index(), voi->degree(),
+                                                                   voi->component(), voi->name(), voi->unit());
+    storedValues << mPoints;
+
+    foreach (CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter, mRuntime->modelParameters()) {
+        switch (modelParameter->type()) {
+        case CellMLSupport::CellmlFileRuntimeModelParameter::Constant:
+        case CellMLSupport::CellmlFileRuntimeModelParameter::ComputedConstant:
+            storedValues << (mConstants?mConstants[modelParameter->index()]:0);
+
+            break;
+        case CellMLSupport::CellmlFileRuntimeModelParameter::State:
+            storedValues << (mStates?mStates[modelParameter->index()]:0);
+
+            break;
+        case CellMLSupport::CellmlFileRuntimeModelParameter::Rate:
+            storedValues << (mRates?mRates[modelParameter->index()]:0);
+
+            break;
+        case CellMLSupport::CellmlFileRuntimeModelParameter::Algebraic:
+            storedValues << (mAlgebraic?mAlgebraic[modelParameter->index()]:0);
+
+            break;
+        default:
+            // Either Voi or Undefined, so...
+
+            continue;
+        }
+
+        columns << SingleCellSimulationViewSimulationResultsFileColumn(modelParameter->type(), modelParameter->index(),
+                                                                       modelParameter->degree(), modelParameter->component(),
+                                                                       modelParameter->name(), modelParameter->unit());
+    }
+
+    if (mSensitivities) {
+        static const QString SensitivityName = "d(%1)/d(%2 | %3)";
+        static const QString SensitivityUnit = "%1/%2";
+
+        int statesCount = mRuntime->statesCount();
+
+        for (int k = 0, kMax = mSensitivityParameters.count(); k < kMax; ++k) {
+            CellMLSupport::CellmlFileRuntimeModelParameter *sensitivityParameter = mSensitivityParameters[k];
+
+            foreach (CellMLSupport::CellmlFileRuntimeModelParameter *state,
+                     mRuntime->modelParameters(CellMLSupport::CellmlFileRuntimeModelParameter::State)) {
+                int index = k*statesCount+state->index();
+
+                columns << SingleCellSimulationViewSimulationResultsFileColumn(SingleCellSimulationViewSimulationResultsFileColumn::Sensitivity,
+                                                                               index, 0, state->component(),
+                                                                               SensitivityName.arg(state->name(),
+                                                                                                   sensitivityParameter->component(),
+                                                                                                   sensitivityParameter->name()),
+                                                                               SensitivityUnit.arg(state->unit(),
+                                                                                                   sensitivityParameter->unit()));
+                storedValues << mSensitivities[index];
+            }
+        }
+    }
+
+    // Create our file and write our stored data to it
+
+    SingleCellSimulationViewSimulationResultsFile *resultsFile = new SingleCellSimulationViewSimulationResultsFile(pFileName);
+
+    if (!resultsFile->open(columns)) {
+        delete resultsFile;
+
+        return false;
+    }
+
+    if (mSize)
+        resultsFile->addPoints(storedValues.constData(), 0, mSize);
+
+    // Keep streaming our data to our file, if requested, or close it
+
+    if (pStream) {
+        mResultsFile = resultsFile;
+        mResultsFileColumns = storedValues;
+
+        return !resultsFile->hasError();
+    } else {
+        bool res = resultsFile->close();
+
+        delete resultsFile;
+
+        return res;
+    }
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResults::stopStreaming()
+{
+    // Stop streaming our data, if we were doing so, and close our file
+
+    QMutexLocker locker(&mMutex);
+
+    if (!mResultsFile)
+        return true;
+
+    bool res = mResultsFile->close();
+
+    delete mResultsFile;
+
+    mResultsFile = 0;
+
+    return res;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResults::serialize(QDataStream &pStream,
+                                                          const qulonglong &pFrom)
+{
+    // Serialise our results from the given point onwards, using the compressed
+    // version of our arrays (see SingleCellSimulationViewTimeSeriesCodec)
+    // Note #1: we lock our mutex so that our arrays cannot be deleted by our
+    //          background compression (see compressArrays()) while we are
+    //          using them...
+    // Note #2: only points that have been recorded can be serialised, and
+    //          those never change once recorded, so a checkpoint can serialise
+    //          only the points that were recorded since its previous save (see
+    //          SingleCellSimulationViewSimulationCheckpoint::addResults())...
+
+    QMutexLocker locker(&mMutex);
+
+    if ((pFrom >= mSize) || (mCompressed && pFrom))
+        return false;
+
+    QVector<QByteArray> compressedData = mCompressedData;
+
+    if (!mCompressed) {
+        QVector<double *> arrays = this->arrays();
+
+        for (int i = 0, iMax = arrays.count(); i < iMax; ++i)
+            compressedData << (i?
+                                   SingleCellSimulationViewTimeSeriesCodec::compressValues(arrays[i]+pFrom, mSize-pFrom):
+                                   SingleCellSimulationViewTimeSeriesCodec::compressPoints(arrays[i]+pFrom, mSize-pFrom));
+    }
+
+    pStream << mSize-pFrom << qint32(mCyclesCount) << mRecordingCounter
+            << compressedData;
+
+    return pStream.status() == QDataStream::Ok;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResults::deserialize(QDataStream &pStream,
+                                                            const bool &pAppend)
+{
+    // Deserialise our results (see serialize()), making sure that they match
+    // our model and the sensitivity parameters we were reset with, and append
+    // them to the results we already have, if requested (e.g. we are carrying
+    // on from a checkpoint which results were saved in several chunks)
+
+    qulonglong size;
+    qint32 cyclesCount;
+    qulonglong recordingCounter;
+    QVector<QByteArray> compressedData;
+
+    pStream >> size >> cyclesCount >> recordingCounter >> compressedData;
+
+    int arraysCount =  1+mRuntime->constantsCount()+mRuntime->statesCount()
+                      +mRuntime->ratesCount()+mRuntime->algebraicCount()
+                      +mSensitivityParameters.count()*mRuntime->statesCount();
+
+    if (   (pStream.status() != QDataStream::Ok)
+        || !size || (compressedData.count() != arraysCount))
+        return false;
 
-        out << "," << Header.arg(modelParameter->component(),
-                                 modelParameter->name()+QString(modelParameter->degree(), '\''),
-                                 modelParameter->unit());
-    }
+    // Make sure that all of our compressed data is consistent with our size,
+    // so that we don't create arrays for a (corrupted) size that our data
+    // cannot hold
 
-    out << "\n";
+    foreach (const QByteArray &data, compressedData)
+        if (!SingleCellSimulationViewTimeSeriesCodec::isValidSize(data, size))
+            return false;
 
-    // Data itself
+    // Uncompress our deserialised results into our arrays, reusing them if
+    // they are big enough (e.g. we have just been reset and are about to carry
+    // on from a checkpoint)
+    // Note: the results to which we append must be in our arrays, which must
+    //       also be big enough to hold our new results, since we cannot resize
+    //       them without losing what they contain...
 
-    for (qulonglong j = 0; j < mSize; ++j) {
-        out << mPoints[j];
+    cancelCompression();
+    waitForStorage();
 
-        for (int i = 0, iMax = mRuntime->modelParameters().count(); i < iMax; ++i) {
-            CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter = mRuntime->modelParameters()[i];
+    QMutexLocker locker(&mMutex);
 
-            switch (modelParameter->type()) {
-            case CellMLSupport::CellmlFileRuntimeModelParameter::Constant:
-            case CellMLSupport::CellmlFileRuntimeModelParameter::ComputedConstant:
-                out << "," << mConstants[modelParameter->index()][j];
+    qulonglong offset = pAppend?mSize:0;
 
-                break;
-            case CellMLSupport::CellmlFileRuntimeModelParameter::State:
-                out << "," << mStates[modelParameter->index()][j];
+    if (pAppend && (mCompressed || !mPoints || (mCapacity < offset+size)))
+        return false;
 
-                break;
-            case CellMLSupport::CellmlFileRuntimeModelParameter::Rate:
-                out << "," << mRates[modelParameter->index()][j];
+    mCompressed = false;
+    mCompressedData.clear();
 
-                break;
-            case CellMLSupport::CellmlFileRuntimeModelParameter::Algebraic:
-                out << "," << mAlgebraic[modelParameter->index()][j];
+    if (!mPoints || (mCapacity < size)) {
+        deleteArrays();
 
-                break;
-            default:
-                // Either Voi or Undefined, so...
+        bool arraysCreated = createArrays(size);
 
-                ;
-            }
-        }
+        updateRecordingArrays();
+
+        if (!arraysCreated) {
+            mSize = 0;
 
-        out << "\n";
+            return false;
+        }
     }
 
-    // We are done, so close our file
+    QVector<double *> arrays = this->arrays();
 
-    file.close();
+    for (int i = 0; i < arraysCount; ++i)
+        if (!(i?
+                  SingleCellSimulationViewTimeSeriesCodec::uncompressValues(compressedData[i], arrays[i]+offset, size):
+                  SingleCellSimulationViewTimeSeriesCodec::uncompressPoints(compressedData[i], arrays[i]+offset, size))) {
+            mSize = offset;
 
-    // Everything went fine, so...
+            return false;
+        }
+
+    mSize = offset+size;
+    mCyclesCount = cyclesCount;
+
+    mRecordingCounter = recordingCounter;
+    mPendingSize = 0;
 
     return true;
 }
 
 //==============================================================================
 
+class SingleCellSimulationViewSimulationResultsCompressor : public QRunnable
+{
+public:
+    explicit SingleCellSimulationViewSimulationResultsCompressor(SingleCellSimulationViewSimulationResults *pResults);
+
+    virtual void run();
+
+private:
+    SingleCellSimulationViewSimulationResults *mResults;
+};
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationResultsCompressor::SingleCellSimulationViewSimulationResultsCompressor(SingleCellSimulationViewSimulationResults *pResults) :
+    mResults(pResults)
+{
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResultsCompressor::run()
+{
+    // Compress our results
+
+    mResults->compressArrays();
+}
+
+//==============================================================================
+
+QVector<double *> SingleCellSimulationViewSimulationResults::arrays() const
+{
+    // Return all of our arrays, starting with our points array
+
+    QVector<double *> res = QVector<double *>();
+
+    res << mPoints;
+
+    for (int i = 0, iMax = mRuntime->constantsCount(); i < iMax; ++i)
+        res << mConstants[i];
+
+    for (int i = 0, iMax = mRuntime->statesCount(); i < iMax; ++i)
+        res << mStates[i];
+
+    for (int i = 0, iMax = mRuntime->ratesCount(); i < iMax; ++i)
+        res << mRates[i];
+
+    for (int i = 0, iMax = mRuntime->algebraicCount(); i < iMax; ++i)
+        res << mAlgebraic[i];
+
+    if (mSensitivities)
+        for (int i = 0, iMax = mSensitivityParameters.count()*mRuntime->statesCount(); i < iMax; ++i)
+            res << mSensitivities[i];
+
+    return res;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResults::isCompressed() const
+{
+    // Return whether our results are compressed
+
+    return mCompressed;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResults::compress()
+{
+    // Compress our results in the background, but only if we have some and
+    // they are not already compressed (or being compressed)
+    // Note: we are only to be compressed when our simulation is neither
+    //       running nor the active one, so nobody should need our arrays in the
+    //       meantime, but we keep them until all of them have been compressed,
+    //       just in case...
+
+    if (   !mSize || mCompressed
+        || (mCompressionThreadPool.activeThreadCount() != 0))
+        return;
+
+    mCompressionThreadPool.start(new SingleCellSimulationViewSimulationResultsCompressor(this));
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResults::compressArrays()
+{
+    // Compress our arrays, using a delta-of-delta coding for our points and an
+    // XOR coding for everything else (see SingleCellSimulationViewTimeSeriesCodec)
+
+    QVector<double *> arrays = this->arrays();
+    QVector<QByteArray> compressedData = QVector<QByteArray>();
+
+    for (int i = 0, iMax = arrays.count(); i < iMax; ++i) {
+        if (mCompressionCancelled.load())
+            return;
+
+        compressedData << (i?
+                               SingleCellSimulationViewTimeSeriesCodec::compressValues(arrays[i], mSize):
+                               SingleCellSimulationViewTimeSeriesCodec::compressPoints(arrays[i], mSize));
+    }
+
+    // Replace our arrays with their compressed version, unless we have been
+    // cancelled in the meantime
+
+    QMutexLocker locker(&mMutex);
+
+    if (mCompressionCancelled.load())
+        return;
+
+    mCompressedData = compressedData;
+
+    deleteArrays();
+
+    updateRecordingArrays();
+
+    mCompressed = true;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResults::cancelCompression()
+{
+    // Cancel the compression of our results, if any, and wait for it to be
+    // done
+
+    mCompressionCancelled.store(1);
+
+    mCompressionThreadPool.waitForDone();
+
+    mCompressionCancelled.store(0);
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResults::uncompress()
+{
+    // Make sure that we are not being compressed and uncompress our results, if
+    // they are compressed
+    // Note: we lock our mutex since our arrays are to be (re)created, and keep
+    //       our compressed data should our arrays not be created or our
+    //       compressed data turn out to be invalid...
+
+    cancelCompression();
+
+    QMutexLocker locker(&mMutex);
+
+    if (!mCompressed)
+        return true;
+
+    bool res = createArrays(mSize);
+
+    if (res) {
+        QVector<double *> arrays = this->arrays();
+
+        for (int i = 0, iMax = arrays.count(); res && (i < iMax); ++i)
+            res = i?
+                      SingleCellSimulationViewTimeSeriesCodec::uncompressValues(mCompressedData[i], arrays[i], mSize):
+                      SingleCellSimulationViewTimeSeriesCodec::uncompressPoints(mCompressedData[i], arrays[i], mSize);
+    }
+
+    if (res) {
+        mCompressed = false;
+        mCompressedData.clear();
+    } else {
+        deleteArrays();
+    }
+
+    updateRecordingArrays();
+
+    return res;
+}
+
+//==============================================================================
+
+class SingleCellSimulationViewSimulationResultsStorer : public QRunnable
+{
+public:
+    explicit SingleCellSimulationViewSimulationResultsStorer(SingleCellSimulationViewSimulationResults *pResults,
+                                                             const QByteArray &pKey,
+                                                             const QByteArray &pData);
+
+    virtual void run();
+
+private:
+    SingleCellSimulationViewSimulationResults *mResults;
+
+    QByteArray mKey;
+    QByteArray mData;
+};
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationResultsStorer::SingleCellSimulationViewSimulationResultsStorer(SingleCellSimulationViewSimulationResults *pResults,
+                                                                                                 const QByteArray &pKey,
+                                                                                                 const QByteArray &pData) :
+    mResults(pResults),
+    mKey(pKey),
+    mData(pData)
+{
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResultsStorer::run()
+{
+    // Store our results
+
+    mResults->storeArrays(mKey, mData);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResults::store(const QByteArray &pKey,
+                                                      const QByteArray &pData)
+{
+    // Store our results, after the given data, in our results cache, using the
+    // given key, in the background since serialising our results and writing
+    // them to disk may take a while
+    // Note: anything that may modify or delete our arrays (i.e. reset(),
+    //       deserialize() and our destructor) waits for our storage to be
+    //       done...
+
+    mStorageThreadPool.start(new SingleCellSimulationViewSimulationResultsStorer(this, pKey, pData));
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResults::storeArrays(const QByteArray &pKey,
+                                                            const QByteArray &pData)
+{
+    // Serialise our results after the given data and store the whole lot in
+    // our results cache
+
+    QByteArray data = pData;
+    QDataStream stream(&data, QIODevice::WriteOnly | QIODevice::Append);
+
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    if (serialize(stream))
+        SingleCellSimulationViewSimulationResultsCache::instance()->store(pKey, data);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResults::waitForStorage()
+{
+    // Wait for our results to be stored, if they are being stored
+
+    mStorageThreadPool.waitForDone();
+}
+
+//==============================================================================
+
 SingleCellSimulationViewSimulation::SingleCellSimulationViewSimulation(const QString &pFileName,
                                                                        CellMLSupport::CellmlFileRuntime *pRuntime,
                                                                        const SolverInterfaces &pSolverInterfaces) :
     mWorker(0),
+    mStopRequested(false),
+    mResuming(false),
+    mCacheKey(QByteArray()),
+    mCacheRevision(0),
+    mStatistics(QVariantMap()),
     mFileName(pFileName),
     mRuntime(pRuntime),
     mSolverInterfaces(pSolverInterfaces),
@@ -955,12 +2223,13 @@ double SingleCellSimulationViewSimulation::requiredMemory()
 
     static const int SizeOfDouble = sizeof(double);
 
-    return  size()
+    return  recordedSize()
            *( 1
              +mRuntime->constantsCount()
              +mRuntime->statesCount()
              +mRuntime->ratesCount()
-             +mRuntime->algebraicCount())
+             +mRuntime->algebraicCount()
+             +mData->sensitivityParameters().count()*mRuntime->statesCount())
            *SizeOfDouble;
 }
 
@@ -1009,7 +2278,9 @@ double SingleCellSimulationViewSimulation::size()
     if (simulationSettingsOk(false))
         // Our simulation settings are fine, so...
 
-        return ceil((mData->endingPoint()-mData->startingPoint())/mData->pointInterval())+1.0;
+        return mData->steadyState()?
+                   1.0:
+                   ceil((mData->endingPoint()-mData->startingPoint())/mData->pointInterval())+1.0;
     else
         // Something wrong with our simulation settings, so...
 
@@ -1018,9 +2289,63 @@ double SingleCellSimulationViewSimulation::size()
 
 //==============================================================================
 
-void SingleCellSimulationViewSimulation::run()
+double SingleCellSimulationViewSimulation::recordedSize()
+{
+    // Return the number of data points which our results need to be able to
+    // hold, based on our recording policy
+    // Note: for every Nth point and min/max per bucket, this includes room for
+    //       the point(s) which have yet to be recorded (see
+    //       SingleCellSimulationViewSimulationResults::addPoint())...
+
+    double simulationSize = size();
+    double recordingInterval = qMax(1, mData->recordingInterval());
+
+    if (!simulationSize || (recordingInterval == 1.0))
+        return simulationSize;
+
+    switch (mData->recordingPolicy()) {
+    case SingleCellSimulationViewSimulationData::EveryNthPoint:
+        return qMin(simulationSize, ceil(simulationSize/recordingInterval)+1.0);
+    case SingleCellSimulationViewSimulationData::MinMaxPerBucket:
+        return 2.0*ceil(simulationSize/recordingInterval)+1.0;
+    default:
+        // AllPoints or OnChange, so we may have to record all of our points
+
+        return simulationSize;
+    }
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulation::hasCheckpoint() const
+{
+    // Return whether there is a checkpoint from which our simulation could be
+    // resumed, i.e. a checkpoint that was saved by a previous run of the very
+    // same simulation (see computeCacheKey())
+
+    QByteArray key = computeCacheKey();
+
+    return !key.isEmpty() && QFile::exists(SingleCellSimulationViewSimulationCheckpoint::fileName(key));
+}
+
+//==============================================================================
+
+QVariantMap SingleCellSimulationViewSimulation::statistics() const
+{
+    // Return the statistics of the solver(s) used by our last run, keyed by
+    // solver name
+    // Note: we don't have any if our results were retrieved from our cache...
+
+    return mStatistics;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulation::run(const bool &pResume)
 {
     // Initialise our worker, if not active
+    // Note: if requested, our worker will resume our simulation from its
+    //       checkpoint (see hasCheckpoint())...
 
     if (!mWorker) {
         // First, check that our simulation settings we were given are sound
@@ -1030,6 +2355,32 @@ void SingleCellSimulationViewSimulation::run()
 
             return;
 
+        // Keep track of our starting states
+        // Note: we start from our current states, unless we are resuming, in
+        //       which case we carry on from those from which our checkpoint's
+        //       run started...
+
+        mStopRequested = false;
+        mResuming = pResume;
+
+        if (!pResume)
+            mData->updateStartingStates();
+
+        // Retrieve our results from our cache, if we have already run the very
+        // same simulation and are not resuming it
+
+        mCacheKey = computeCacheKey();
+        mCacheRevision = mData->revision();
+
+        mStatistics = QVariantMap();
+
+        if (!pResume && retrieveResults()) {
+            emit running(false);
+            emit stopped(0);
+
+            return;
+        }
+
         // Create our worker
 
         mWorker = new SingleCellSimulationViewSimulationWorker(mSolverInterfaces, mRuntime, this, &mWorker);
@@ -1047,8 +2398,8 @@ void SingleCellSimulationViewSimulation::run()
         connect(mWorker, SIGNAL(paused()),
                 this, SIGNAL(paused()));
 
-        connect(mWorker, SIGNAL(finished(const int &)),
-                this, SIGNAL(stopped(const int &)));
+        connect(mWorker, SIGNAL(finished(const int &, const QVariantMap &, const qulonglong &)),
+                this, SLOT(workerFinished(const int &, const QVariantMap &, const qulonglong &)));
 
         connect(mWorker, SIGNAL(error(const QString &)),
                 this, SIGNAL(error(const QString &)));
@@ -1061,6 +2412,199 @@ void SingleCellSimulationViewSimulation::run()
 
 //==============================================================================
 
+QByteArray SingleCellSimulationViewSimulation::cacheKey() const
+{
+    // Return the key of our current or last run (see computeCacheKey())
+
+    return mCacheKey;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulation::isResuming() const
+{
+    // Return whether our current or last run was resumed from a checkpoint
+
+    return mResuming;
+}
+
+//==============================================================================
+
+QByteArray SingleCellSimulationViewSimulation::computeCacheKey() const
+{
+    // Determine the key of our results in our results cache, i.e. a hash of
+    // everything our results depend on: our model code, the value of our
+    // 'constants', the 'states' from which our run starts, our simulation
+    // settings, and our solvers and their properties
+    // Note #1: we use our starting 'states' rather than our current ones, since
+    //          the latter evolve while we are running, i.e. the key of a
+    //          stopped run (and therefore of its checkpoint) could otherwise
+    //          never be determined again. Our 'constants' don't evolve, but
+    //          their modification means that we cannot resume our run...
+    // Note #2: an empty key means that our results cannot be cached...
+
+    QByteArray codeHash = mRuntime->codeHash();
+
+    if (codeHash.isEmpty())
+        return QByteArray();
+
+    QByteArray data = QByteArray();
+    QDataStream stream(&data, QIODevice::WriteOnly);
+
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << codeHash;
+
+    for (int i = 0, iMax = mRuntime->constantsCount(); i < iMax; ++i)
+        stream << mData->constants()[i];
+
+    for (int i = 0, iMax = mRuntime->statesCount(); i < iMax; ++i)
+        stream << mData->startingStates()[i];
+
+    stream << mData->startingPoint() << mData->endingPoint()
+           << mData->pointInterval()
+           << mData->steadyState() << mData->parallelInTime()
+           << mData->period() << mData->periodTolerance()
+           << qint32(mData->keptCycles())
+           << qint32(mData->recordingPolicy())
+           << qint32(mData->recordingInterval())
+           << mData->recordingThreshold();
+
+    stream << mData->odeSolverName() << mData->odeSolverProperties()
+           << mData->daeSolverName() << mData->daeSolverProperties()
+           << mData->nlaSolverName() << mData->nlaSolverProperties();
+
+    foreach (CellMLSupport::CellmlFileRuntimeModelParameter *sensitivityParameter,
+             mData->sensitivityParameters())
+        stream << sensitivityParameter->component() << sensitivityParameter->name()
+               << qint32(sensitivityParameter->degree());
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulation::retrieveResults()
+{
+    // Retrieve our results, as well as the final value of our model
+    // parameters, from our results cache, if possible
+
+    QByteArray data;
+
+    if (!SingleCellSimulationViewSimulationResultsCache::instance()->retrieve(mCacheKey, data))
+        return false;
+
+    QDataStream stream(&data, QIODevice::ReadOnly);
+    QVector<double> constants;
+    QVector<double> states;
+    QVector<double> rates;
+    QVector<double> algebraic;
+
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream >> constants >> states >> rates >> algebraic;
+
+    if (   (stream.status() != QDataStream::Ok)
+        || (constants.count() != mRuntime->constantsCount())
+        || (states.count() != mRuntime->statesCount())
+        || (rates.count() != mRuntime->ratesCount())
+        || (algebraic.count() != mRuntime->algebraicCount())) {
+        // Our cache entry is invalid, so get rid of it
+
+        SingleCellSimulationViewSimulationResultsCache::instance()->remove(mCacheKey);
+
+        return false;
+    }
+
+    if (!mResults->deserialize(stream)) {
+        // We couldn't deserialise our results, so get rid of our cache entry
+        // and make sure that our results are ready for our worker
+
+        SingleCellSimulationViewSimulationResultsCache::instance()->remove(mCacheKey);
+
+        if (!mResults->reset())
+            emit error(tr("the simulation results could not be reset"));
+
+        return false;
+    }
+
+    static const int SizeOfDouble = sizeof(double);
+
+    memcpy(mData->constants(), constants.constData(), constants.count()*SizeOfDouble);
+    memcpy(mData->states(), states.constData(), states.count()*SizeOfDouble);
+    memcpy(mData->rates(), rates.constData(), rates.count()*SizeOfDouble);
+    memcpy(mData->algebraic(), algebraic.constData(), algebraic.count()*SizeOfDouble);
+
+    mData->checkForModifications();
+
+    return true;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulation::storeResults()
+{
+    // Store our results, as well as the final value of our model parameters,
+    // in our results cache
+    // Note: our results get serialised and stored in the background (see
+    //       SingleCellSimulationViewSimulationResults::store()), so that our
+    //       GUI doesn't freeze while this happens...
+
+    QByteArray data = QByteArray();
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    QVector<double> constants(mRuntime->constantsCount());
+    QVector<double> states(mRuntime->statesCount());
+    QVector<double> rates(mRuntime->ratesCount());
+    QVector<double> algebraic(mRuntime->algebraicCount());
+
+    static const int SizeOfDouble = sizeof(double);
+
+    memcpy(constants.data(), mData->constants(), constants.count()*SizeOfDouble);
+    memcpy(states.data(), mData->states(), states.count()*SizeOfDouble);
+    memcpy(rates.data(), mData->rates(), rates.count()*SizeOfDouble);
+    memcpy(algebraic.data(), mData->algebraic(), algebraic.count()*SizeOfDouble);
+
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << constants << states << rates << algebraic;
+
+    mResults->store(mCacheKey, data);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulation::workerFinished(const int &pElapsedTime,
+                                                        const QVariantMap &pStatistics,
+                                                        const qulonglong &pDiscardedPointsCount)
+{
+    // Keep track of the statistics of our solver(s)
+
+    mStatistics = pStatistics;
+
+    // Discard the points that precede the cycles we want to keep, if any
+    // Note: we do this here rather than in our worker since we are in the GUI
+    //       thread, i.e. our results cannot be plotted while we move them
+    //       around. Our size will have shrunk by the time anyone checks our
+    //       results, so they will know to replot them (see
+    //       SingleCellSimulationViewWidget::updateResults())...
+
+    mResults->discardPoints(pDiscardedPointsCount);
+
+    // Cache our results, but only if they are complete and still correspond
+    // to our cache key, i.e. no error occurred, and our simulation was neither
+    // stopped nor had its 'constants' or 'states' modified while running
+
+    if (   (pElapsedTime != -1) && !mStopRequested && !mCacheKey.isEmpty()
+        && (mData->revision() == mCacheRevision))
+        storeResults();
+
+    // Let people know that we are stopped
+
+    emit stopped(pElapsedTime);
+}
+
+//==============================================================================
+
 void SingleCellSimulationViewSimulation::pause()
 {
     // Ask our worker to pause, if active
@@ -1085,8 +2629,11 @@ void SingleCellSimulationViewSimulation::stop()
 {
     // Ask our worker to stop, if active
 
-    if (mWorker)
+    if (mWorker) {
+        mStopRequested = true;
+
         mWorker->stop();
+    }
 }
 
 //==============================================================================
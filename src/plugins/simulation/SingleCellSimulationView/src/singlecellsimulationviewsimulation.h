@@ -7,13 +7,21 @@
 
 //==============================================================================
 
+#include "cellmlfileruntime.h"
 #include "coresolver.h"
+#include "singlecellsimulationviewglobal.h"
+#include "singlecellsimulationviewsimulationresultsfile.h"
 #include "singlecellsimulationviewsimulationworker.h"
 #include "solverinterface.h"
 
 //==============================================================================
 
+#include <QAtomicInt>
+#include <QDataStream>
+#include <QMutex>
 #include <QObject>
+#include <QPair>
+#include <QThreadPool>
 
 //==============================================================================
 
@@ -25,12 +33,6 @@ namespace OpenCOR {
 
 //==============================================================================
 
-namespace CellMLSupport {
-    class CellmlFileRuntime;
-}   // namespace CellMLSupport
-
-//==============================================================================
-
 namespace SingleCellSimulationView {
 
 //==============================================================================
@@ -39,11 +41,18 @@ class SingleCellSimulationViewWidget;
 
 //==============================================================================
 
-class SingleCellSimulationViewSimulationData : public QObject
+class SINGLECELLSIMULATIONVIEW_EXPORT SingleCellSimulationViewSimulationData : public QObject
 {
     Q_OBJECT
 
 public:
+    enum RecordingPolicy {
+        AllPoints,
+        EveryNthPoint,
+        OnChange,
+        MinMaxPerBucket
+    };
+
     explicit SingleCellSimulationViewSimulationData(CellMLSupport::CellmlFileRuntime *pRuntime,
                                                     const SolverInterfaces &pSolverInterfaces);
     ~SingleCellSimulationViewSimulationData();
@@ -54,6 +63,9 @@ public:
     double * algebraic() const;
     double * condVar() const;
 
+    double * startingStates() const;
+    void updateStartingStates();
+
     int delay() const;
     void setDelay(const int &pDelay);
 
@@ -67,6 +79,30 @@ public:
     double pointInterval() const;
     void setPointInterval(const double &pPointInterval);
 
+    bool steadyState() const;
+    void setSteadyState(const bool &pSteadyState);
+
+    bool parallelInTime() const;
+    void setParallelInTime(const bool &pParallelInTime);
+
+    double period() const;
+    void setPeriod(const double &pPeriod);
+
+    double periodTolerance() const;
+    void setPeriodTolerance(const double &pPeriodTolerance);
+
+    int keptCycles() const;
+    void setKeptCycles(const int &pKeptCycles);
+
+    RecordingPolicy recordingPolicy() const;
+    void setRecordingPolicy(const RecordingPolicy &pRecordingPolicy);
+
+    int recordingInterval() const;
+    void setRecordingInterval(const int &pRecordingInterval);
+
+    double recordingThreshold() const;
+    void setRecordingThreshold(const double &pRecordingThreshold);
+
     QString odeSolverName() const;
     void setOdeSolverName(const QString &pOdeSolverName);
 
@@ -87,8 +123,17 @@ public:
     void addNlaSolverProperty(const QString &pName, const QVariant &pValue,
                               const bool &pReset = true);
 
+    bool canComputeSensitivities() const;
+
+    CellMLSupport::CellmlFileRuntimeModelParameters sensitivityParameters() const;
+    bool isSensitivityParameter(CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter) const;
+    void setSensitivityParameter(CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter,
+                                 const bool &pSensitive);
+
     void reset();
 
+    int revision() const;
+
     void recomputeComputedConstantsAndVariables();
     void recomputeVariables(const double &pCurrentPoint,
                             const bool &pEmitSignal = true);
@@ -106,6 +151,19 @@ private:
     double mEndingPoint;
     double mPointInterval;
 
+    bool mSteadyState;
+    bool mParallelInTime;
+
+    double mPeriod;
+    double mPeriodTolerance;
+    int mKeptCycles;
+
+    RecordingPolicy mRecordingPolicy;
+    int mRecordingInterval;
+    double mRecordingThreshold;
+
+    int mRevision;
+
     QString mOdeSolverName;
     CoreSolver::Properties mOdeSolverProperties;
 
@@ -115,6 +173,8 @@ private:
     QString mNlaSolverName;
     CoreSolver::Properties mNlaSolverProperties;
 
+    QList<QPair<QString, QString> > mSensitivityParameters;
+
     double *mConstants;
     double *mStates;
     double *mRates;
@@ -124,6 +184,8 @@ private:
     double *mInitialConstants;
     double *mInitialStates;
 
+    double *mStartingStates;
+
 Q_SIGNALS:
     void updated();
     void modified(const bool &pIsModified);
@@ -133,8 +195,11 @@ Q_SIGNALS:
 
 //==============================================================================
 
-class SingleCellSimulationViewSimulationResults : public QObject
+class SINGLECELLSIMULATIONVIEW_EXPORT SingleCellSimulationViewSimulationResults : public QObject
 {
+    friend class SingleCellSimulationViewSimulationResultsCompressor;
+    friend class SingleCellSimulationViewSimulationResultsStorer;
+
 public:
     explicit SingleCellSimulationViewSimulationResults(CellMLSupport::CellmlFileRuntime *pRuntime,
                                                        SingleCellSimulationViewSimulation *pSimulation);
@@ -142,10 +207,15 @@ public:
 
     bool reset(const bool &pCreateArrays = true);
 
-    void addPoint(const double &pPoint);
+    void addPoint(const double &pPoint, const double *pSensitivities = 0);
+    void flushPoints();
+    void discardPoints(const qulonglong &pNumberOfPoints);
 
     qulonglong size() const;
 
+    int cyclesCount() const;
+    void setCyclesCount(const int &pCyclesCount);
+
     double * points() const;
 
     double **constants() const;
@@ -153,7 +223,25 @@ public:
     double **rates() const;
     double **algebraic() const;
 
+    CellMLSupport::CellmlFileRuntimeModelParameters sensitivityParameters() const;
+    double **sensitivities() const;
+    double * sensitivities(CellMLSupport::CellmlFileRuntimeModelParameter *pState,
+                           CellMLSupport::CellmlFileRuntimeModelParameter *pConstant) const;
+
     bool exportToCsv(const QString &pFileName) const;
+    bool exportToBinary(const QString &pFileName, const bool &pStream = false);
+
+    bool stopStreaming();
+
+    bool serialize(QDataStream &pStream, const qulonglong &pFrom = 0);
+    bool deserialize(QDataStream &pStream, const bool &pAppend = false);
+
+    void store(const QByteArray &pKey, const QByteArray &pData);
+
+    bool isCompressed() const;
+
+    void compress();
+    bool uncompress();
 
 private:
     CellMLSupport::CellmlFileRuntime *mRuntime;
@@ -161,6 +249,9 @@ private:
     SingleCellSimulationViewSimulation *mSimulation;
 
     qulonglong mSize;
+    qulonglong mCapacity;
+
+    int mCyclesCount;
 
     double *mPoints;
 
@@ -169,18 +260,61 @@ private:
     double **mRates;
     double **mAlgebraic;
 
-    bool createArrays();
+    CellMLSupport::CellmlFileRuntimeModelParameters mSensitivityParameters;
+    double **mSensitivities;
+
+    SingleCellSimulationViewSimulationData::RecordingPolicy mRecordingPolicy;
+    int mRecordingInterval;
+    double mRecordingThreshold;
+
+    qulonglong mRecordingCounter;
+    qulonglong mPendingSize;
+
+    QVector<double *> mRecordingArrays;
+    QVector<double *> mTrackedArrays;
+    QVector<bool> mMinimumFirst;
+
+    QMutex mMutex;
+
+    SingleCellSimulationViewSimulationResultsFile *mResultsFile;
+    QVector<double *> mResultsFileColumns;
+
+    QThreadPool mCompressionThreadPool;
+    QAtomicInt mCompressionCancelled;
+
+    bool mCompressed;
+    QVector<QByteArray> mCompressedData;
+
+    QThreadPool mStorageThreadPool;
+
+    bool createArrays(const qulonglong &pSize);
     void deleteArrays();
+
+    QVector<double *> arrays() const;
+
+    void storePoint(const qulonglong &pIndex, const double &pPoint,
+                    const double *pSensitivities);
+    void recordPoints(const qulonglong &pNumberOfPoints);
+
+    void updateRecordingArrays();
+
+    bool hasChanged(const qulonglong &pIndex) const;
+
+    void closeBucket();
+
+    void compressArrays();
+    void cancelCompression();
+
+    void storeArrays(const QByteArray &pKey, const QByteArray &pData);
+    void waitForStorage();
 };
 
 //==============================================================================
 
-class SingleCellSimulationViewSimulation : public QObject
+class SINGLECELLSIMULATIONVIEW_EXPORT SingleCellSimulationViewSimulation : public QObject
 {
     Q_OBJECT
 
-    friend class SingleCellSimulationViewSimulationWorker;
-
 public:
     explicit SingleCellSimulationViewSimulation(const QString &pFileName,
                                                 CellMLSupport::CellmlFileRuntime *pRuntime,
@@ -202,8 +336,16 @@ public:
     double requiredMemory();
 
     double size();
+    double recordedSize();
+
+    QByteArray cacheKey() const;
+    bool isResuming() const;
+
+    bool hasCheckpoint() const;
 
-    void run();
+    QVariantMap statistics() const;
+
+    void run(const bool &pResume = false);
     void pause();
     void resume();
     void stop();
@@ -213,6 +355,14 @@ public:
 private:
     SingleCellSimulationViewSimulationWorker *mWorker;
 
+    bool mStopRequested;
+    bool mResuming;
+
+    QByteArray mCacheKey;
+    int mCacheRevision;
+
+    QVariantMap mStatistics;
+
     QString mFileName;
 
     CellMLSupport::CellmlFileRuntime *mRuntime;
@@ -224,12 +374,22 @@ private:
 
     bool simulationSettingsOk(const bool &pEmitError = true);
 
+    QByteArray computeCacheKey() const;
+
+    bool retrieveResults();
+    void storeResults();
+
 Q_SIGNALS:
     void running(const bool &pIsResuming);
     void paused();
     void stopped(const int &pElapsedTime);
 
     void error(const QString &pMessage);
+
+private Q_SLOTS:
+    void workerFinished(const int &pElapsedTime,
+                        const QVariantMap &pStatistics,
+                        const qulonglong &pDiscardedPointsCount);
 };
 
 //==============================================================================
@@ -0,0 +1,409 @@
+//==============================================================================
+// Single cell simulation view simulation checkpoint
+//==============================================================================
+
+#include "singlecellsimulationviewsimulationcheckpoint.h"
+#include "singlecellsimulationviewsimulationstorage.h"
+
+//==============================================================================
+
+#include <QDataStream>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStandardPaths>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+static const quint32 Magic   = 0x4f434350;   // i.e. "OCCP"
+static const quint32 Version = 2;
+
+static const QString FileExtension = ".occp";
+
+//==============================================================================
+
+static int checkpointInterval = 300;
+
+static QMutex checkpointsMutex;
+static qint64 checkpointsMaximumSize = 256*1024*1024;
+
+//==============================================================================
+
+static QString checkpointsDirName()
+{
+    // Return the name of the directory which holds our checkpoints
+
+    return QStandardPaths::writableLocation(QStandardPaths::DataLocation)+"/Checkpoints";
+}
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationCheckpoint::SingleCellSimulationViewSimulationCheckpoint() :
+    mKey(QByteArray()),
+    mPoint(0.0),
+    mPointCounter(0),
+    mConstants(QVector<double>()),
+    mStates(QVector<double>()),
+    mRates(QVector<double>()),
+    mAlgebraic(QVector<double>()),
+    mCyclesCount(0),
+    mCycleStates(QVector<double>()),
+    mCycleStarts(QList<qulonglong>()),
+    mSolverState(CoreSolver::Properties()),
+    mResults(QList<QByteArray>())
+{
+}
+
+//==============================================================================
+
+QString SingleCellSimulationViewSimulationCheckpoint::fileName(const QByteArray &pKey)
+{
+    // Return the name of the checkpoint file for the simulation with the given
+    // key (see SingleCellSimulationViewSimulation::computeCacheKey())
+
+    return checkpointsDirName()+"/"+pKey.toHex()+FileExtension;
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewSimulationCheckpoint::interval()
+{
+    // Return the interval, in seconds, at which checkpoints are to be saved
+
+    return checkpointInterval;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setInterval(const int &pInterval)
+{
+    // Set the interval, in seconds, at which checkpoints are to be saved
+    // Note: an interval of zero means that no checkpoint is to be saved...
+
+    checkpointInterval = qMax(0, pInterval);
+}
+
+//==============================================================================
+
+qint64 SingleCellSimulationViewSimulationCheckpoint::maximumSize()
+{
+    // Return the maximum size of all our checkpoints together
+
+    QMutexLocker locker(&checkpointsMutex);
+
+    return checkpointsMaximumSize;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setMaximumSize(const qint64 &pMaximumSize)
+{
+    // Set the maximum size of all our checkpoints together and evict whatever
+    // doesn't fit in it anymore
+    // Note: a maximum size of zero means that no checkpoint is to be kept...
+
+    QMutexLocker locker(&checkpointsMutex);
+
+    checkpointsMaximumSize = qMax(qint64(0), pMaximumSize);
+
+    SingleCellSimulationViewSimulationStorage::evict(checkpointsDirName(), FileExtension,
+                                                     checkpointsMaximumSize);
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationCheckpoint::load(const QString &pFileName)
+{
+    // Load our checkpoint from the given file
+
+    QFile file(pFileName);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic;
+    quint32 version;
+    qint32 checkpointPointCounter;
+    qint32 checkpointCyclesCount;
+
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream >> magic >> version;
+
+    if ((stream.status() != QDataStream::Ok) || (magic != Magic) || (version != Version))
+        return false;
+
+    stream >> mKey >> mPoint >> checkpointPointCounter
+           >> mConstants >> mStates >> mRates >> mAlgebraic
+           >> checkpointCyclesCount >> mCycleStates >> mCycleStarts
+           >> mSolverState >> mResults;
+
+    mPointCounter = checkpointPointCounter;
+    mCyclesCount = checkpointCyclesCount;
+
+    return stream.status() == QDataStream::Ok;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationCheckpoint::save(const QString &pFileName) const
+{
+    // Save our checkpoint to the given file, making sure that our checkpoints
+    // don't exceed their maximum size (see
+    // SingleCellSimulationViewSimulationStorage::save())
+
+    QByteArray data = QByteArray();
+    QDataStream stream(&data, QIODevice::WriteOnly);
+
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << Magic << Version
+           << mKey << mPoint << qint32(mPointCounter)
+           << mConstants << mStates << mRates << mAlgebraic
+           << qint32(mCyclesCount) << mCycleStates << mCycleStarts
+           << mSolverState << mResults;
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    QMutexLocker locker(&checkpointsMutex);
+
+    return SingleCellSimulationViewSimulationStorage::save(pFileName, data,
+                                                           FileExtension,
+                                                           checkpointsMaximumSize);
+}
+
+//==============================================================================
+
+QByteArray SingleCellSimulationViewSimulationCheckpoint::key() const
+{
+    // Return the key of the simulation to which we belong
+
+    return mKey;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setKey(const QByteArray &pKey)
+{
+    // Set the key of the simulation to which we belong
+
+    mKey = pKey;
+}
+
+//==============================================================================
+
+double SingleCellSimulationViewSimulationCheckpoint::point() const
+{
+    // Return the point at which we were saved
+
+    return mPoint;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setPoint(const double &pPoint)
+{
+    // Set the point at which we are saved
+
+    mPoint = pPoint;
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewSimulationCheckpoint::pointCounter() const
+{
+    // Return the number of points that had been computed when we were saved
+
+    return mPointCounter;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setPointCounter(const int &pPointCounter)
+{
+    // Set the number of points that have been computed
+
+    mPointCounter = pPointCounter;
+}
+
+//==============================================================================
+
+QVector<double> SingleCellSimulationViewSimulationCheckpoint::constants() const
+{
+    // Return our constants
+
+    return mConstants;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setConstants(const QVector<double> &pConstants)
+{
+    // Set our constants
+
+    mConstants = pConstants;
+}
+
+//==============================================================================
+
+QVector<double> SingleCellSimulationViewSimulationCheckpoint::states() const
+{
+    // Return our states (and their sensitivities, if any)
+
+    return mStates;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setStates(const QVector<double> &pStates)
+{
+    // Set our states (and their sensitivities, if any)
+
+    mStates = pStates;
+}
+
+//==============================================================================
+
+QVector<double> SingleCellSimulationViewSimulationCheckpoint::rates() const
+{
+    // Return our rates (and those of our sensitivities, if any)
+
+    return mRates;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setRates(const QVector<double> &pRates)
+{
+    // Set our rates (and those of our sensitivities, if any)
+
+    mRates = pRates;
+}
+
+//==============================================================================
+
+QVector<double> SingleCellSimulationViewSimulationCheckpoint::algebraic() const
+{
+    // Return our algebraic variables
+
+    return mAlgebraic;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setAlgebraic(const QVector<double> &pAlgebraic)
+{
+    // Set our algebraic variables
+
+    mAlgebraic = pAlgebraic;
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewSimulationCheckpoint::cyclesCount() const
+{
+    // Return the number of cycles that had been completed when we were saved
+
+    return mCyclesCount;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setCyclesCount(const int &pCyclesCount)
+{
+    // Set the number of cycles that have been completed
+
+    mCyclesCount = pCyclesCount;
+}
+
+//==============================================================================
+
+QVector<double> SingleCellSimulationViewSimulationCheckpoint::cycleStates() const
+{
+    // Return our states at the beginning of our current cycle
+
+    return mCycleStates;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setCycleStates(const QVector<double> &pCycleStates)
+{
+    // Set our states at the beginning of our current cycle
+
+    mCycleStates = pCycleStates;
+}
+
+//==============================================================================
+
+QList<qulonglong> SingleCellSimulationViewSimulationCheckpoint::cycleStarts() const
+{
+    // Return the index of the first point of each of our cycles
+
+    return mCycleStarts;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setCycleStarts(const QList<qulonglong> &pCycleStarts)
+{
+    // Set the index of the first point of each of our cycles
+
+    mCycleStarts = pCycleStarts;
+}
+
+//==============================================================================
+
+CoreSolver::Properties SingleCellSimulationViewSimulationCheckpoint::solverState() const
+{
+    // Return the internal state of our ODE/DAE solver
+
+    return mSolverState;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::setSolverState(const CoreSolver::Properties &pSolverState)
+{
+    // Set the internal state of our ODE/DAE solver
+
+    mSolverState = pSolverState;
+}
+
+//==============================================================================
+
+QList<QByteArray> SingleCellSimulationViewSimulationCheckpoint::results() const
+{
+    // Return our results, as a list of consecutive chunks (see addResults())
+
+    return mResults;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationCheckpoint::addResults(const QByteArray &pResults)
+{
+    // Add a chunk of results, i.e. the results that were recorded since our
+    // previous chunk
+    // Note: this means that, every time we are saved, only our new results
+    //       need to be serialised (and therefore compressed), rather than all
+    //       of them (see SingleCellSimulationViewSimulationResults::serialize())...
+
+    mResults << pResults;
+}
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,110 @@
+//==============================================================================
+// Single cell simulation view simulation checkpoint
+//==============================================================================
+
+#ifndef SINGLECELLSIMULATIONVIEWSIMULATIONCHECKPOINT_H
+#define SINGLECELLSIMULATIONVIEWSIMULATIONCHECKPOINT_H
+
+//==============================================================================
+
+#include "coresolver.h"
+#include "singlecellsimulationviewglobal.h"
+
+//==============================================================================
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+class SINGLECELLSIMULATIONVIEW_EXPORT SingleCellSimulationViewSimulationCheckpoint
+{
+public:
+    explicit SingleCellSimulationViewSimulationCheckpoint();
+
+    static QString fileName(const QByteArray &pKey);
+
+    static int interval();
+    static void setInterval(const int &pInterval);
+
+    static qint64 maximumSize();
+    static void setMaximumSize(const qint64 &pMaximumSize);
+
+    bool load(const QString &pFileName);
+    bool save(const QString &pFileName) const;
+
+    QByteArray key() const;
+    void setKey(const QByteArray &pKey);
+
+    double point() const;
+    void setPoint(const double &pPoint);
+
+    int pointCounter() const;
+    void setPointCounter(const int &pPointCounter);
+
+    QVector<double> constants() const;
+    void setConstants(const QVector<double> &pConstants);
+
+    QVector<double> states() const;
+    void setStates(const QVector<double> &pStates);
+
+    QVector<double> rates() const;
+    void setRates(const QVector<double> &pRates);
+
+    QVector<double> algebraic() const;
+    void setAlgebraic(const QVector<double> &pAlgebraic);
+
+    int cyclesCount() const;
+    void setCyclesCount(const int &pCyclesCount);
+
+    QVector<double> cycleStates() const;
+    void setCycleStates(const QVector<double> &pCycleStates);
+
+    QList<qulonglong> cycleStarts() const;
+    void setCycleStarts(const QList<qulonglong> &pCycleStarts);
+
+    CoreSolver::Properties solverState() const;
+    void setSolverState(const CoreSolver::Properties &pSolverState);
+
+    QList<QByteArray> results() const;
+    void addResults(const QByteArray &pResults);
+
+private:
+    QByteArray mKey;
+
+    double mPoint;
+    int mPointCounter;
+
+    QVector<double> mConstants;
+    QVector<double> mStates;
+    QVector<double> mRates;
+    QVector<double> mAlgebraic;
+
+    int mCyclesCount;
+    QVector<double> mCycleStates;
+    QList<qulonglong> mCycleStarts;
+
+    CoreSolver::Properties mSolverState;
+
+    QList<QByteArray> mResults;
+};
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+
+#endif
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,175 @@
+//==============================================================================
+// Single cell simulation view simulation results cache
+//==============================================================================
+
+#include "singlecellsimulationviewsimulationresultscache.h"
+#include "singlecellsimulationviewsimulationstorage.h"
+
+//==============================================================================
+
+#include <QDataStream>
+#include <QFile>
+#include <QStandardPaths>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+static const quint32 Magic   = 0x4f435243;   // i.e. "OCRC"
+static const quint32 Version = 1;
+
+static const QString FileExtension = ".ocrc";
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationResultsCache::SingleCellSimulationViewSimulationResultsCache() :
+    mDirName(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)+"/SimulationResults"),
+    mMaximumSize(256*1024*1024)
+{
+}
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationResultsCache * SingleCellSimulationViewSimulationResultsCache::instance()
+{
+    // Return the 'global' instance of our simulation results cache
+
+    static SingleCellSimulationViewSimulationResultsCache instance;
+
+    return &instance;
+}
+
+//==============================================================================
+
+qint64 SingleCellSimulationViewSimulationResultsCache::maximumSize() const
+{
+    // Return the maximum size of our cache
+
+    QMutexLocker locker(&mMutex);
+
+    return mMaximumSize;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResultsCache::setMaximumSize(const qint64 &pMaximumSize)
+{
+    // Set the maximum size of our cache and evict whatever doesn't fit in it
+    // anymore
+    // Note: a maximum size of zero means that our cache is disabled...
+
+    QMutexLocker locker(&mMutex);
+
+    mMaximumSize = qMax(qint64(0), pMaximumSize);
+
+    SingleCellSimulationViewSimulationStorage::evict(mDirName, FileExtension,
+                                                     mMaximumSize);
+}
+
+//==============================================================================
+
+QString SingleCellSimulationViewSimulationResultsCache::fileName(const QByteArray &pKey) const
+{
+    // Return the name of the file which holds the entry for the given key
+
+    return mDirName+"/"+pKey.toHex()+FileExtension;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResultsCache::retrieve(const QByteArray &pKey,
+                                                              QByteArray &pData)
+{
+    // Retrieve the data for the given key, if we have it
+
+    QMutexLocker locker(&mMutex);
+
+    if (!mMaximumSize || pKey.isEmpty())
+        return false;
+
+    QFile file(fileName(pKey));
+
+    if (!file.open(QIODevice::ReadWrite))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic;
+    quint32 version;
+    QByteArray key;
+
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream >> magic >> version >> key >> pData;
+
+    if (   (stream.status() != QDataStream::Ok)
+        || (magic != Magic) || (version != Version) || (key != pKey)) {
+        // Our entry is either corrupted or from another version of our cache,
+        // so get rid of it
+
+        pData = QByteArray();
+
+        file.remove();
+
+        return false;
+    }
+
+    // Rewrite our magic number, so that our entry becomes our most recently
+    // used one (see SingleCellSimulationViewSimulationStorage::evict())
+
+    file.seek(0);
+
+    stream << Magic;
+
+    return true;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResultsCache::store(const QByteArray &pKey,
+                                                           const QByteArray &pData)
+{
+    // Store the given data for the given key, making sure that we don't exceed
+    // our maximum size (see SingleCellSimulationViewSimulationStorage::save())
+
+    QMutexLocker locker(&mMutex);
+
+    if (!mMaximumSize || pKey.isEmpty())
+        return false;
+
+    QByteArray data = QByteArray();
+    QDataStream stream(&data, QIODevice::WriteOnly);
+
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << Magic << Version << pKey << pData;
+
+    return    (stream.status() == QDataStream::Ok)
+           && SingleCellSimulationViewSimulationStorage::save(fileName(pKey), data,
+                                                              FileExtension,
+                                                              mMaximumSize);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResultsCache::remove(const QByteArray &pKey)
+{
+    // Remove the entry for the given key, if any (e.g. its data turned out to
+    // be invalid)
+
+    QMutexLocker locker(&mMutex);
+
+    if (!pKey.isEmpty())
+        QFile::remove(fileName(pKey));
+}
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
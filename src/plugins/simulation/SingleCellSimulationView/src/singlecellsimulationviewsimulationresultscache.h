@@ -0,0 +1,60 @@
+//==============================================================================
+// Single cell simulation view simulation results cache
+//==============================================================================
+
+#ifndef SINGLECELLSIMULATIONVIEWSIMULATIONRESULTSCACHE_H
+#define SINGLECELLSIMULATIONVIEWSIMULATIONRESULTSCACHE_H
+
+//==============================================================================
+
+#include "singlecellsimulationviewglobal.h"
+
+//==============================================================================
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+class SINGLECELLSIMULATIONVIEW_EXPORT SingleCellSimulationViewSimulationResultsCache
+{
+public:
+    static SingleCellSimulationViewSimulationResultsCache * instance();
+
+    qint64 maximumSize() const;
+    void setMaximumSize(const qint64 &pMaximumSize);
+
+    bool retrieve(const QByteArray &pKey, QByteArray &pData);
+    bool store(const QByteArray &pKey, const QByteArray &pData);
+    void remove(const QByteArray &pKey);
+
+private:
+    mutable QMutex mMutex;
+
+    QString mDirName;
+
+    qint64 mMaximumSize;
+
+    explicit SingleCellSimulationViewSimulationResultsCache();
+
+    QString fileName(const QByteArray &pKey) const;
+};
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+
+#endif
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,485 @@
+//==============================================================================
+// Single cell simulation view simulation results file
+//==============================================================================
+
+#include "singlecellsimulationviewsimulationresultsfile.h"
+
+//==============================================================================
+
+#include <QtEndian>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+static const char Magic[] = "OCBR";
+static const quint32 Version = 1;
+static const quint32 ChunkSize = 4096;
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationResultsFileColumn::SingleCellSimulationViewSimulationResultsFileColumn(const int &pType,
+                                                                                                         const int &pIndex,
+                                                                                                         const int &pDegree,
+                                                                                                         const QString &pComponent,
+                                                                                                         const QString &pName,
+                                                                                                         const QString &pUnit) :
+    type(pType),
+    index(pIndex),
+    degree(pDegree),
+    component(pComponent),
+    name(pName),
+    unit(pUnit)
+{
+}
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationResultsFile::SingleCellSimulationViewSimulationResultsFile(const QString &pFileName) :
+    mFile(pFileName),
+    mColumnsCount(0),
+    mChunk(QVector<double>()),
+    mChunkPointsCount(0),
+    mError(false)
+{
+}
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationResultsFile::~SingleCellSimulationViewSimulationResultsFile()
+{
+    // Make sure that our file is closed
+
+    close();
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResultsFile::write(const void *pData,
+                                                          const qint64 &pSize)
+{
+    // Write the given data to our file, keeping track of any error
+
+    if (!mError && (mFile.write(static_cast<const char *>(pData), pSize) != pSize))
+        mError = true;
+}
+
+//==============================================================================
+
+static QByteArray littleEndian(const qint32 &pValue)
+{
+    // Return the given value as little-endian bytes
+
+    uchar res[4];
+
+    qToLittleEndian(pValue, res);
+
+    return QByteArray(reinterpret_cast<const char *>(res), 4);
+}
+
+//==============================================================================
+
+static QByteArray littleEndian(const quint32 &pValue)
+{
+    // Return the given value as little-endian bytes
+
+    uchar res[4];
+
+    qToLittleEndian(pValue, res);
+
+    return QByteArray(reinterpret_cast<const char *>(res), 4);
+}
+
+//==============================================================================
+
+static QByteArray littleEndian(const quint64 &pValue)
+{
+    // Return the given value as little-endian bytes
+
+    uchar res[8];
+
+    qToLittleEndian(pValue, res);
+
+    return QByteArray(reinterpret_cast<const char *>(res), 8);
+}
+
+//==============================================================================
+
+static QByteArray littleEndian(const QString &pValue)
+{
+    // Return the given string as its length followed by its UTF-8 bytes
+
+    QByteArray value = pValue.toUtf8();
+
+    return littleEndian(quint32(value.size()))+value;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResultsFile::open(const SingleCellSimulationViewSimulationResultsFileColumns &pColumns)
+{
+    // Open our file
+
+    if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        mFile.remove();
+
+        return false;
+    }
+
+    mColumnsCount = pColumns.count();
+
+    mChunk.resize(mColumnsCount*ChunkSize);
+
+    mChunkPointsCount = 0;
+    mError = false;
+
+    // Generate our header, padding it so that our chunks are 8-byte aligned
+
+    QByteArray columns = QByteArray();
+
+    foreach (const SingleCellSimulationViewSimulationResultsFileColumn &column, pColumns)
+        columns +=  littleEndian(qint32(column.type))
+                   +littleEndian(qint32(column.index))
+                   +littleEndian(qint32(column.degree))
+                   +littleEndian(column.component)
+                   +littleEndian(column.name)
+                   +littleEndian(column.unit);
+
+    static const int FixedHeaderSize = 4+3*4+8;
+
+    quint64 headerSize = FixedHeaderSize+columns.size();
+
+    headerSize = (headerSize+7) & ~quint64(7);
+
+    QByteArray header =  QByteArray(Magic, 4)
+                        +littleEndian(Version)
+                        +littleEndian(quint32(mColumnsCount))
+                        +littleEndian(ChunkSize)
+                        +littleEndian(headerSize)
+                        +columns;
+
+    header += QByteArray(headerSize-header.size(), '\0');
+
+    write(header.constData(), header.size());
+
+    return !mError;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResultsFile::close()
+{
+    // Write our last (partial) chunk, if any, and close our file
+
+    if (!mFile.isOpen())
+        return !mError;
+
+    writeChunk();
+
+    mFile.close();
+
+    return !mError;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResultsFile::writeChunk()
+{
+    // Write our current chunk, if it isn't empty
+
+    if (!mChunkPointsCount)
+        return;
+
+    QByteArray pointsCount = littleEndian(quint64(mChunkPointsCount));
+
+    write(pointsCount.constData(), pointsCount.size());
+
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    for (int i = 0, iMax = mChunk.count(); i < iMax; ++i) {
+        quint64 value;
+
+        memcpy(&value, mChunk.constData()+i, sizeof(double));
+
+        value = qToLittleEndian(value);
+
+        memcpy(mChunk.data()+i, &value, sizeof(double));
+    }
+#endif
+
+    for (int i = 0; i < mColumnsCount; ++i)
+        write(mChunk.constData()+i*ChunkSize, mChunkPointsCount*sizeof(double));
+
+    mChunkPointsCount = 0;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResultsFile::addPoints(double * const *pColumns,
+                                                              const qulonglong &pFrom,
+                                                              const qulonglong &pTo)
+{
+    // Add the points [pFrom; pTo[ of the given columns to our file
+
+    static const int SizeOfDouble = sizeof(double);
+
+    for (qulonglong i = pFrom; i < pTo;) {
+        qulonglong pointsCount = qMin(pTo-i, ChunkSize-mChunkPointsCount);
+
+        for (int j = 0; j < mColumnsCount; ++j)
+            memcpy(mChunk.data()+j*ChunkSize+mChunkPointsCount,
+                   pColumns[j]+i, pointsCount*SizeOfDouble);
+
+        mChunkPointsCount += pointsCount;
+
+        if (mChunkPointsCount == ChunkSize)
+            writeChunk();
+
+        i += pointsCount;
+    }
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResultsFile::addPoint(const double *pValues)
+{
+    // Add the given point (i.e. one value per column) to our file
+
+    for (int i = 0; i < mColumnsCount; ++i)
+        mChunk[i*ChunkSize+mChunkPointsCount] = pValues[i];
+
+    if (++mChunkPointsCount == ChunkSize)
+        writeChunk();
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResultsFile::hasError() const
+{
+    // Return whether an error occurred while writing to our file
+
+    return mError;
+}
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationResultsFileReader::SingleCellSimulationViewSimulationResultsFileReader(const QString &pFileName) :
+    mFile(pFileName),
+    mColumns(SingleCellSimulationViewSimulationResultsFileColumns()),
+    mChunkPositions(QList<qint64>()),
+    mChunkPointsCounts(QList<qulonglong>()),
+    mPointsCount(0)
+{
+}
+
+//==============================================================================
+
+template<typename T>
+static bool fromLittleEndian(const QByteArray &pData, int &pPosition,
+                             T &pValue)
+{
+    // Retrieve a value from the given little-endian bytes, making sure that
+    // there are enough of them
+
+    if (pPosition+int(sizeof(T)) > pData.size())
+        return false;
+
+    pValue = qFromLittleEndian<T>(reinterpret_cast<const uchar *>(pData.constData()+pPosition));
+
+    pPosition += sizeof(T);
+
+    return true;
+}
+
+//==============================================================================
+
+static bool fromLittleEndian(const QByteArray &pData, int &pPosition,
+                             QString &pValue)
+{
+    // Retrieve a string from its length and UTF-8 bytes, making sure that
+    // there are enough of them
+
+    quint32 size;
+
+    if (   !fromLittleEndian(pData, pPosition, size)
+        || (size > quint32(pData.size()-pPosition)))
+        return false;
+
+    pValue = QString::fromUtf8(pData.constData()+pPosition, size);
+
+    pPosition += size;
+
+    return true;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResultsFileReader::open()
+{
+    // Open our file and read its header, as well as the position and size of
+    // its chunks, checking that they are consistent with the size of our file
+
+    close();
+
+    if (!mFile.open(QIODevice::ReadOnly))
+        return false;
+
+    static const int FixedHeaderSize = 4+3*4+8;
+
+    QByteArray header = mFile.read(FixedHeaderSize);
+    int position = 4;
+    quint32 version;
+    quint32 columnsCount;
+    quint32 chunkSize;
+    quint64 headerSize;
+
+    if (   (header.size() != FixedHeaderSize)
+        || !header.startsWith(QByteArray(Magic, 4))
+        || !fromLittleEndian(header, position, version)
+        || !fromLittleEndian(header, position, columnsCount)
+        || !fromLittleEndian(header, position, chunkSize)
+        || !fromLittleEndian(header, position, headerSize)
+        || (version != Version) || !chunkSize
+        || (headerSize < quint64(FixedHeaderSize))
+        || (headerSize > quint64(mFile.size()))) {
+        close();
+
+        return false;
+    }
+
+    header = mFile.read(headerSize-FixedHeaderSize);
+    position = 0;
+
+    for (quint32 i = 0; i < columnsCount; ++i) {
+        qint32 type;
+        qint32 index;
+        qint32 degree;
+        QString component;
+        QString name;
+        QString unit;
+
+        if (   !fromLittleEndian(header, position, type)
+            || !fromLittleEndian(header, position, index)
+            || !fromLittleEndian(header, position, degree)
+            || !fromLittleEndian(header, position, component)
+            || !fromLittleEndian(header, position, name)
+            || !fromLittleEndian(header, position, unit)) {
+            close();
+
+            return false;
+        }
+
+        mColumns << SingleCellSimulationViewSimulationResultsFileColumn(type, index, degree,
+                                                                        component, name, unit);
+    }
+
+    for (qint64 chunkPosition = headerSize, fileSize = mFile.size();
+         chunkPosition < fileSize;) {
+        QByteArray pointsCountData;
+        int pointsCountPosition = 0;
+        quint64 pointsCount;
+
+        if (   !mFile.seek(chunkPosition)
+            || ((pointsCountData = mFile.read(8)).size() != 8)
+            || !fromLittleEndian(pointsCountData, pointsCountPosition, pointsCount)
+            || !pointsCount || (pointsCount > chunkSize)
+            || (pointsCount*columnsCount*sizeof(double) > quint64(fileSize-chunkPosition-8))) {
+            close();
+
+            return false;
+        }
+
+        mChunkPositions << chunkPosition;
+        mChunkPointsCounts << pointsCount;
+
+        mPointsCount += pointsCount;
+
+        chunkPosition += 8+pointsCount*columnsCount*sizeof(double);
+    }
+
+    return true;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationResultsFileReader::close()
+{
+    // Close our file and reset our information about it
+
+    mFile.close();
+
+    mColumns.clear();
+
+    mChunkPositions.clear();
+    mChunkPointsCounts.clear();
+
+    mPointsCount = 0;
+}
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationResultsFileColumns SingleCellSimulationViewSimulationResultsFileReader::columns() const
+{
+    // Return our columns
+
+    return mColumns;
+}
+
+//==============================================================================
+
+qulonglong SingleCellSimulationViewSimulationResultsFileReader::pointsCount() const
+{
+    // Return our number of points
+
+    return mPointsCount;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationResultsFileReader::values(const int &pColumn,
+                                                                 QVector<double> &pValues)
+{
+    // Retrieve all the values of the given column
+
+    if (!mFile.isOpen() || (pColumn < 0) || (pColumn >= mColumns.count()))
+        return false;
+
+    pValues.resize(mPointsCount);
+
+    qulonglong offset = 0;
+
+    for (int i = 0, iMax = mChunkPositions.count(); i < iMax; ++i) {
+        qint64 size = mChunkPointsCounts[i]*sizeof(double);
+
+        if (   !mFile.seek(mChunkPositions[i]+8+pColumn*size)
+            || (mFile.read(reinterpret_cast<char *>(pValues.data()+offset), size) != size))
+            return false;
+
+        offset += mChunkPointsCounts[i];
+    }
+
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    for (qulonglong i = 0; i < mPointsCount; ++i) {
+        quint64 value;
+
+        memcpy(&value, pValues.constData()+i, sizeof(double));
+
+        value = qFromLittleEndian(value);
+
+        memcpy(pValues.data()+i, &value, sizeof(double));
+    }
+#endif
+
+    return true;
+}
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,138 @@
+//==============================================================================
+// Single cell simulation view simulation results file
+//==============================================================================
+
+#ifndef SINGLECELLSIMULATIONVIEWSIMULATIONRESULTSFILE_H
+#define SINGLECELLSIMULATIONVIEWSIMULATIONRESULTSFILE_H
+
+//==============================================================================
+
+#include "singlecellsimulationviewglobal.h"
+
+//==============================================================================
+
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+class SINGLECELLSIMULATIONVIEW_EXPORT SingleCellSimulationViewSimulationResultsFileColumn
+{
+public:
+    enum Type {
+        Sensitivity = 100
+    };
+
+    explicit SingleCellSimulationViewSimulationResultsFileColumn(const int &pType,
+                                                                 const int &pIndex,
+                                                                 const int &pDegree,
+                                                                 const QString &pComponent,
+                                                                 const QString &pName,
+                                                                 const QString &pUnit);
+
+    int type;
+    int index;
+    int degree;
+
+    QString component;
+    QString name;
+    QString unit;
+};
+
+//==============================================================================
+
+typedef QList<SingleCellSimulationViewSimulationResultsFileColumn> SingleCellSimulationViewSimulationResultsFileColumns;
+
+//==============================================================================
+
+// Our file uses a binary columnar format, with all numbers in little-endian order:
+//  - header:
+//     - "OCBR" (4 bytes), followed by the version of the format (quint32), the
+//       number of columns (quint32), the maximum number of points per chunk
+//       (quint32) and the size of the header in bytes (quint64);
+//     - for each column: its type (qint32, i.e. a ModelParameterType or
+//       Sensitivity), its index (qint32), its degree (qint32), and its
+//       component, name and unit (each as a quint32 length followed by that
+//       many UTF-8 bytes); and
+//     - zero padding up to the size of the header (a multiple of 8 bytes).
+//  - chunks: the number of points in the chunk (quint64), followed by the
+//    values of each column (doubles), one column after the other.
+// Every chunk but the last one is full, so the data can be memory mapped
+// (e.g. using numpy.memmap) once the header has been read. Alternatively, the
+// file can be read using SingleCellSimulationViewSimulationResultsFileReader...
+
+class SINGLECELLSIMULATIONVIEW_EXPORT SingleCellSimulationViewSimulationResultsFile
+{
+public:
+    explicit SingleCellSimulationViewSimulationResultsFile(const QString &pFileName);
+    ~SingleCellSimulationViewSimulationResultsFile();
+
+    bool open(const SingleCellSimulationViewSimulationResultsFileColumns &pColumns);
+    bool close();
+
+    void addPoints(double * const *pColumns, const qulonglong &pFrom,
+                   const qulonglong &pTo);
+    void addPoint(const double *pValues);
+
+    bool hasError() const;
+
+private:
+    QFile mFile;
+
+    int mColumnsCount;
+
+    QVector<double> mChunk;
+    qulonglong mChunkPointsCount;
+
+    bool mError;
+
+    void write(const void *pData, const qint64 &pSize);
+    void writeChunk();
+};
+
+//==============================================================================
+
+class SINGLECELLSIMULATIONVIEW_EXPORT SingleCellSimulationViewSimulationResultsFileReader
+{
+public:
+    explicit SingleCellSimulationViewSimulationResultsFileReader(const QString &pFileName);
+
+    bool open();
+    void close();
+
+    SingleCellSimulationViewSimulationResultsFileColumns columns() const;
+
+    qulonglong pointsCount() const;
+
+    bool values(const int &pColumn, QVector<double> &pValues);
+
+private:
+    QFile mFile;
+
+    SingleCellSimulationViewSimulationResultsFileColumns mColumns;
+
+    QList<qint64> mChunkPositions;
+    QList<qulonglong> mChunkPointsCounts;
+
+    qulonglong mPointsCount;
+};
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+
+#endif
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,255 @@
+//==============================================================================
+// Single cell simulation view simulation scheduler
+//==============================================================================
+
+#include "singlecellsimulationviewsimulationscheduler.h"
+
+//==============================================================================
+
+#include <QMutexLocker>
+#include <QThread>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationScheduler::SingleCellSimulationViewSimulationScheduler() :
+    mMaximumRunningSimulationsCount(qMax(1, QThread::idealThreadCount())),
+    mPrioritySimulation(0),
+    mWaitingSimulations(QList<SingleCellSimulationViewSimulation *>()),
+    mRunningSimulations(QMap<SingleCellSimulationViewSimulation *, QElapsedTimer>()),
+    mAdditionalSlots(QMap<SingleCellSimulationViewSimulation *, int>())
+{
+}
+
+//==============================================================================
+
+SingleCellSimulationViewSimulationScheduler * SingleCellSimulationViewSimulationScheduler::instance()
+{
+    // Return the 'global' instance of our simulation scheduler
+
+    static SingleCellSimulationViewSimulationScheduler instance;
+
+    return &instance;
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewSimulationScheduler::maximumRunningSimulationsCount() const
+{
+    // Return the maximum number of simulations that can run at the same time
+
+    QMutexLocker locker(&mMutex);
+
+    return mMaximumRunningSimulationsCount;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationScheduler::setMaximumRunningSimulationsCount(const int &pMaximumRunningSimulationsCount)
+{
+    // Set the maximum number of simulations that can run at the same time, and
+    // let any waiting simulation know about it since it may now be able to run
+
+    QMutexLocker locker(&mMutex);
+
+    mMaximumRunningSimulationsCount = qMax(1, pMaximumRunningSimulationsCount);
+
+    mCondition.wakeAll();
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationScheduler::setPrioritySimulation(SingleCellSimulationViewSimulation *pSimulation)
+{
+    // Keep track of the simulation that should be given priority (i.e. the one
+    // in the visible tab) and let our waiting simulations know about it
+
+    QMutexLocker locker(&mMutex);
+
+    mPrioritySimulation = pSimulation;
+
+    mCondition.wakeAll();
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewSimulationScheduler::usedSlotsCount() const
+{
+    // Return the number of slots that are currently used, i.e. one per running
+    // simulation and whatever additional slots they may have
+    // Note: we expect our mutex to be locked...
+
+    int res = mRunningSimulations.count();
+
+    foreach (const int &additionalSlotsCount, mAdditionalSlots)
+        res += additionalSlotsCount;
+
+    return res;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationScheduler::canRun(SingleCellSimulationViewSimulation *pSimulation) const
+{
+    // Determine whether the given simulation can run, which is the case if we
+    // have a free slot for it and if it's either our priority simulation or
+    // the first waiting simulation (with our priority simulation not waiting)
+    // Note: we expect our mutex to be locked...
+
+    if (usedSlotsCount() >= mMaximumRunningSimulationsCount)
+        return false;
+
+    if (pSimulation == mPrioritySimulation)
+        return true;
+
+    if (mWaitingSimulations.contains(mPrioritySimulation))
+        return false;
+
+    foreach (SingleCellSimulationViewSimulation *simulation, mWaitingSimulations)
+        if (simulation != mPrioritySimulation)
+            return simulation == pSimulation;
+
+    return false;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationScheduler::acquire(SingleCellSimulationViewSimulation *pSimulation,
+                                                          const bool &pStopped)
+{
+    // Wait for the given simulation to be allowed to run, unless it gets
+    // stopped in the meantime, in which case we return false
+
+    QMutexLocker locker(&mMutex);
+
+    mWaitingSimulations << pSimulation;
+
+    while (!pStopped && !canRun(pSimulation))
+        mCondition.wait(&mMutex);
+
+    mWaitingSimulations.removeOne(pSimulation);
+
+    if (pStopped) {
+        // We have been stopped, so let the other waiting simulations know that
+        // one of them may now be able to run
+
+        mCondition.wakeAll();
+
+        return false;
+    }
+
+    // Keep track of the time at which the simulation started running, so that
+    // we can time-slice it, if needed
+
+    QElapsedTimer timer;
+
+    timer.start();
+
+    mRunningSimulations.insert(pSimulation, timer);
+
+    return true;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationScheduler::release(SingleCellSimulationViewSimulation *pSimulation)
+{
+    // The given simulation is done running (for now, at least), so free its
+    // slot(s) and let our waiting simulations know about it
+
+    QMutexLocker locker(&mMutex);
+
+    int freedSlotsCount =  mRunningSimulations.remove(pSimulation)
+                          +mAdditionalSlots.remove(pSimulation);
+
+    if (freedSlotsCount)
+        mCondition.wakeAll();
+}
+
+//==============================================================================
+
+int SingleCellSimulationViewSimulationScheduler::acquireAdditionalSlots(SingleCellSimulationViewSimulation *pSimulation,
+                                                                         const int &pMaximumSlotsCount)
+{
+    // Give the given (running) simulation up to the given number of additional
+    // slots (e.g. to compute it in parallel in time), but only from those
+    // slots which are currently free and only if no other simulation is
+    // waiting, and return the number of slots that were actually given
+    // Note: unlike acquire(), we never wait for slots to become free...
+
+    QMutexLocker locker(&mMutex);
+
+    if (!mRunningSimulations.contains(pSimulation) || !mWaitingSimulations.isEmpty())
+        return 0;
+
+    int res = qBound(0, mMaximumRunningSimulationsCount-usedSlotsCount(),
+                     pMaximumSlotsCount);
+
+    if (res)
+        mAdditionalSlots.insert(pSimulation, mAdditionalSlots.value(pSimulation)+res);
+
+    return res;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationScheduler::releaseAdditionalSlots(SingleCellSimulationViewSimulation *pSimulation)
+{
+    // The given simulation is done with its additional slots, if any, so free
+    // them and let our waiting simulations know about it
+
+    QMutexLocker locker(&mMutex);
+
+    if (mAdditionalSlots.remove(pSimulation))
+        mCondition.wakeAll();
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationScheduler::shouldYield(SingleCellSimulationViewSimulation *pSimulation)
+{
+    // Determine whether the given (running) simulation should give its slot to
+    // a waiting simulation, which is the case if it's not our priority
+    // simulation and if either our priority simulation is waiting or its time
+    // slice has expired while other simulations are waiting
+    // Note: this is called at each output point, so we try to be quick about
+    //       it...
+
+    static const qint64 TimeSlice = 250;   // ms
+
+    QMutexLocker locker(&mMutex);
+
+    if (   mWaitingSimulations.isEmpty() || (pSimulation == mPrioritySimulation)
+        || (usedSlotsCount() < mMaximumRunningSimulationsCount))
+        return false;
+
+    if (mWaitingSimulations.contains(mPrioritySimulation))
+        return true;
+
+    return mRunningSimulations.value(pSimulation).elapsed() >= TimeSlice;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationScheduler::wakeUp()
+{
+    // Wake up our waiting simulations, so that they can check whether they
+    // have been stopped
+
+    QMutexLocker locker(&mMutex);
+
+    mCondition.wakeAll();
+}
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,79 @@
+//==============================================================================
+// Single cell simulation view simulation scheduler
+//==============================================================================
+
+#ifndef SINGLECELLSIMULATIONVIEWSIMULATIONSCHEDULER_H
+#define SINGLECELLSIMULATIONVIEWSIMULATIONSCHEDULER_H
+
+//==============================================================================
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QWaitCondition>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+class SingleCellSimulationViewSimulation;
+
+//==============================================================================
+
+class SingleCellSimulationViewSimulationScheduler
+{
+public:
+    static SingleCellSimulationViewSimulationScheduler * instance();
+
+    int maximumRunningSimulationsCount() const;
+    void setMaximumRunningSimulationsCount(const int &pMaximumRunningSimulationsCount);
+
+    void setPrioritySimulation(SingleCellSimulationViewSimulation *pSimulation);
+
+    bool acquire(SingleCellSimulationViewSimulation *pSimulation,
+                 const bool &pStopped);
+    void release(SingleCellSimulationViewSimulation *pSimulation);
+
+    int acquireAdditionalSlots(SingleCellSimulationViewSimulation *pSimulation,
+                               const int &pMaximumSlotsCount);
+    void releaseAdditionalSlots(SingleCellSimulationViewSimulation *pSimulation);
+
+    bool shouldYield(SingleCellSimulationViewSimulation *pSimulation);
+
+    void wakeUp();
+
+private:
+    mutable QMutex mMutex;
+    QWaitCondition mCondition;
+
+    int mMaximumRunningSimulationsCount;
+
+    SingleCellSimulationViewSimulation *mPrioritySimulation;
+
+    QList<SingleCellSimulationViewSimulation *> mWaitingSimulations;
+    QMap<SingleCellSimulationViewSimulation *, QElapsedTimer> mRunningSimulations;
+    QMap<SingleCellSimulationViewSimulation *, int> mAdditionalSlots;
+
+    explicit SingleCellSimulationViewSimulationScheduler();
+
+    int usedSlotsCount() const;
+
+    bool canRun(SingleCellSimulationViewSimulation *pSimulation) const;
+};
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+
+#endif
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,100 @@
+//==============================================================================
+// Single cell simulation view simulation storage
+//==============================================================================
+
+#include "singlecellsimulationviewsimulationstorage.h"
+
+//==============================================================================
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationStorage::save(const QString &pFileName,
+                                                     const QByteArray &pData,
+                                                     const QString &pFileExtension,
+                                                     const qint64 &pMaximumSize)
+{
+    // Save the given data to the given file, and then evict the least recently
+    // used files with the given extension from the file's directory, so that
+    // all of them fit in the given maximum size
+    // Note #1: we first save our data to a temporary file, which we then
+    //          rename, so that nobody can ever read a partially written file
+    //          and a crash while saving cannot corrupt a previous version of
+    //          our file...
+    // Note #2: our file is never evicted, so we fail if it cannot fit in the
+    //          given maximum size on its own...
+
+    if (   !pMaximumSize || (pData.size() > pMaximumSize)
+        || !QDir().mkpath(QFileInfo(pFileName).absolutePath()))
+        return false;
+
+    QString temporaryFileName = pFileName+".tmp";
+    QFile file(temporaryFileName);
+
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    bool res = file.write(pData) == pData.size();
+
+    file.close();
+
+    if (   !res || (file.error() != QFile::NoError)
+        || (QFile::exists(pFileName) && !QFile::remove(pFileName))
+        || !QFile::rename(temporaryFileName, pFileName)) {
+        QFile::remove(temporaryFileName);
+
+        return false;
+    }
+
+    evict(QFileInfo(pFileName).absolutePath(), pFileExtension, pMaximumSize,
+          pFileName);
+
+    return true;
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewSimulationStorage::evict(const QString &pDirName,
+                                                      const QString &pFileExtension,
+                                                      const qint64 &pMaximumSize,
+                                                      const QString &pKeptFileName)
+{
+    // Remove the least recently used files with the given extension from the
+    // given directory until they all fit in the given maximum size, keeping
+    // the given file (e.g. one we have just saved) no matter what
+    // Note: our files are sorted by modification time, most recent first, so
+    //       our callers must 'touch' a file whenever it gets used...
+
+    QFileInfo keptFileInfo = QFileInfo(pKeptFileName);
+    qint64 size = pKeptFileName.isEmpty()?0:keptFileInfo.size();
+
+    foreach (const QFileInfo &fileInfo,
+             QDir(pDirName).entryInfoList(QStringList() << "*"+pFileExtension, QDir::Files, QDir::Time)) {
+        if (   !pKeptFileName.isEmpty()
+            && !fileInfo.absoluteFilePath().compare(keptFileInfo.absoluteFilePath()))
+            continue;
+
+        size += fileInfo.size();
+
+        if (size > pMaximumSize)
+            QFile::remove(fileInfo.absoluteFilePath());
+    }
+}
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,43 @@
+//==============================================================================
+// Single cell simulation view simulation storage
+//==============================================================================
+
+#ifndef SINGLECELLSIMULATIONVIEWSIMULATIONSTORAGE_H
+#define SINGLECELLSIMULATIONVIEWSIMULATIONSTORAGE_H
+
+//==============================================================================
+
+#include <QByteArray>
+#include <QString>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+class SingleCellSimulationViewSimulationStorage
+{
+public:
+    static bool save(const QString &pFileName, const QByteArray &pData,
+                     const QString &pFileExtension,
+                     const qint64 &pMaximumSize);
+
+    static void evict(const QString &pDirName, const QString &pFileExtension,
+                      const qint64 &pMaximumSize,
+                      const QString &pKeptFileName = QString());
+};
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+
+#endif
+
+//==============================================================================
+// End of file
+//==============================================================================
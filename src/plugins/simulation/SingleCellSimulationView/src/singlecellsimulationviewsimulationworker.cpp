@@ -7,13 +7,25 @@
 #include "corenlasolver.h"
 #include "coreodesolver.h"
 #include "singlecellsimulationviewsimulation.h"
+#include "singlecellsimulationviewsimulationcheckpoint.h"
+#include "singlecellsimulationviewsimulationscheduler.h"
 #include "singlecellsimulationviewsimulationworker.h"
 
 //==============================================================================
 
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QMutex>
+#include <QRunnable>
 #include <QThread>
+#include <QThreadPool>
 #include <QTime>
+#include <QVector>
+
+//==============================================================================
+
+#include <qnumeric.h>
 
 //==============================================================================
 
@@ -22,6 +34,277 @@ namespace SingleCellSimulationView {
 
 //==============================================================================
 
+static QVector<double> vector(const double *pArray, const int &pSize)
+{
+    // Return a copy of the given array as a vector
+
+    QVector<double> res(pSize);
+
+    memcpy(res.data(), pArray, pSize*sizeof(double));
+
+    return res;
+}
+
+//==============================================================================
+
+struct SteadyStateSystem
+{
+    CellMLSupport::CellmlFileRuntime::ComputeRatesFunction computeRates;
+
+    double voi;
+
+    double *constants;
+    double *algebraic;
+    double *previousStates;
+
+    double oneOverTimeStep;
+
+    int statesCount;
+};
+
+//==============================================================================
+
+void steadyStateSystem(double *pStates, double *pResiduals, void *pUserData)
+{
+    // Compute the residuals of our steady-state system, i.e. f(y) when looking
+    // for a steady state directly or f(y)-(y-y_n)/dt when doing a step of
+    // pseudo-transient continuation
+
+    SteadyStateSystem *system = static_cast<SteadyStateSystem *>(pUserData);
+
+    system->computeRates(system->voi, system->constants, pResiduals, pStates,
+                         system->algebraic);
+
+    if (system->oneOverTimeStep != 0.0)
+        for (int i = 0; i < system->statesCount; ++i)
+            pResiduals[i] -= system->oneOverTimeStep*(pStates[i]-system->previousStates[i]);
+}
+
+//==============================================================================
+
+class ParallelInTimeSlice : public QRunnable
+{
+public:
+    explicit ParallelInTimeSlice(CoreSolver::CoreOdeSolver *pSolver,
+                                 CellMLSupport::CellmlFileRuntime *pRuntime,
+                                 double *pConstants,
+                                 const double &pStartingPoint,
+                                 const double &pEndingPoint,
+                                 const double &pPointInterval,
+                                 const qulonglong &pFirstPoint,
+                                 const qulonglong &pLastPoint);
+    ~ParallelInTimeSlice();
+
+    virtual void run();
+
+    CoreSolver::CoreOdeSolver * solver() const;
+
+    double point(const qulonglong &pPoint) const;
+
+    qulonglong firstPoint() const;
+    qulonglong lastPoint() const;
+
+    double * initialStates() const;
+    double * finalStates() const;
+    double * trajectory() const;
+
+    bool propagateCoarsely(double *pStates, double *pRates,
+                           double *pAlgebraic) const;
+
+private:
+    CoreSolver::CoreOdeSolver *mSolver;
+
+    CellMLSupport::CellmlFileRuntime *mRuntime;
+
+    double *mConstants;
+
+    double mStartingPoint;
+    double mEndingPoint;
+    double mPointInterval;
+
+    qulonglong mFirstPoint;
+    qulonglong mLastPoint;
+
+    int mStatesCount;
+
+    double *mInitialStates;
+    double *mStates;
+    double *mRates;
+    double *mAlgebraic;
+    double *mTrajectory;
+};
+
+//==============================================================================
+
+ParallelInTimeSlice::ParallelInTimeSlice(CoreSolver::CoreOdeSolver *pSolver,
+                                         CellMLSupport::CellmlFileRuntime *pRuntime,
+                                         double *pConstants,
+                                         const double &pStartingPoint,
+                                         const double &pEndingPoint,
+                                         const double &pPointInterval,
+                                         const qulonglong &pFirstPoint,
+                                         const qulonglong &pLastPoint) :
+    mSolver(pSolver),
+    mRuntime(pRuntime),
+    mConstants(pConstants),
+    mStartingPoint(pStartingPoint),
+    mEndingPoint(pEndingPoint),
+    mPointInterval(pPointInterval),
+    mFirstPoint(pFirstPoint),
+    mLastPoint(pLastPoint),
+    mStatesCount(pRuntime->statesCount())
+{
+    // We are to be run several times, so we shouldn't be deleted by our thread
+    // pool
+
+    setAutoDelete(false);
+
+    // Create our various arrays
+
+    mInitialStates = new double[mStatesCount];
+    mStates        = new double[mStatesCount];
+    mRates         = new double[pRuntime->ratesCount()];
+    mAlgebraic     = new double[pRuntime->algebraicCount()];
+    mTrajectory    = new double[(pLastPoint-pFirstPoint)*mStatesCount];
+}
+
+//==============================================================================
+
+ParallelInTimeSlice::~ParallelInTimeSlice()
+{
+    // Delete some internal objects
+
+    delete mSolver;
+
+    delete[] mInitialStates;
+    delete[] mStates;
+    delete[] mRates;
+    delete[] mAlgebraic;
+    delete[] mTrajectory;
+}
+
+//==============================================================================
+
+void ParallelInTimeSlice::run()
+{
+    // Compute our model from our first output point to our last one using our
+    // (fine) ODE solver and keep track of our states at each output point
+
+    static const int SizeOfDouble = sizeof(double);
+
+    double voi = point(mFirstPoint);
+
+    memcpy(mStates, mInitialStates, mStatesCount*SizeOfDouble);
+
+    mSolver->initialize(voi, mStatesCount, mConstants, mStates, mRates,
+                        mAlgebraic, mRuntime->computeRates());
+
+    for (qulonglong i = mFirstPoint+1; i <= mLastPoint; ++i) {
+        mSolver->solve(voi, point(i));
+
+        memcpy(mTrajectory+(i-mFirstPoint-1)*mStatesCount, mStates,
+               mStatesCount*SizeOfDouble);
+    }
+}
+
+//==============================================================================
+
+CoreSolver::CoreOdeSolver * ParallelInTimeSlice::solver() const
+{
+    // Return our (fine) ODE solver
+
+    return mSolver;
+}
+
+//==============================================================================
+
+double ParallelInTimeSlice::point(const qulonglong &pPoint) const
+{
+    // Return the value of the given output point, making sure that our last
+    // output point is our ending point, as in the main work loop of
+    // SingleCellSimulationViewSimulationWorker::started()
+
+    return (mPointInterval > 0.0)?
+               qMin(mEndingPoint, mStartingPoint+pPoint*mPointInterval):
+               qMax(mEndingPoint, mStartingPoint+pPoint*mPointInterval);
+}
+
+//==============================================================================
+
+qulonglong ParallelInTimeSlice::firstPoint() const
+{
+    // Return our first output point
+
+    return mFirstPoint;
+}
+
+//==============================================================================
+
+qulonglong ParallelInTimeSlice::lastPoint() const
+{
+    // Return our last output point
+
+    return mLastPoint;
+}
+
+//==============================================================================
+
+double * ParallelInTimeSlice::initialStates() const
+{
+    // Return our initial states
+
+    return mInitialStates;
+}
+
+//==============================================================================
+
+double * ParallelInTimeSlice::finalStates() const
+{
+    // Return our final states
+
+    return mStates;
+}
+
+//==============================================================================
+
+double * ParallelInTimeSlice::trajectory() const
+{
+    // Return our trajectory
+
+    return mTrajectory;
+}
+
+//==============================================================================
+
+bool ParallelInTimeSlice::propagateCoarsely(double *pStates, double *pRates,
+                                            double *pAlgebraic) const
+{
+    // Propagate the given states from our first output point to our last one
+    // using a (coarse) forward Euler method, with our point interval as a
+    // step, and let people know whether the resulting states are finite
+    // Note: a forward Euler method is not stable for stiff models, in which
+    //       case our states may overflow and make any further correction
+    //       meaningless...
+
+    for (qulonglong i = mFirstPoint; i < mLastPoint; ++i) {
+        double voi = point(i);
+        double step = point(i+1)-voi;
+
+        mRuntime->computeRates()(voi, mConstants, pRates, pStates, pAlgebraic);
+
+        for (int j = 0; j < mStatesCount; ++j)
+            pStates[j] += step*pRates[j];
+    }
+
+    for (int i = 0; i < mStatesCount; ++i)
+        if (!qIsFinite(pStates[i]))
+            return false;
+
+    return true;
+}
+
+//==============================================================================
+
 SingleCellSimulationViewSimulationWorker::SingleCellSimulationViewSimulationWorker(const SolverInterfaces &pSolverInterfaces,
                                                                                    CellMLSupport::CellmlFileRuntime *pRuntime,
                                                                                    SingleCellSimulationViewSimulation *pSimulation,
@@ -49,7 +332,7 @@ SingleCellSimulationViewSimulationWorker::SingleCellSimulationViewSimulationWork
     connect(mThread, SIGNAL(started()),
             this, SLOT(started()));
 
-    connect(this, SIGNAL(finished(const int &)),
+    connect(this, SIGNAL(finished(const int &, const QVariantMap &, const qulonglong &)),
             mThread, SLOT(quit()));
 
     connect(mThread, SIGNAL(finished()),
@@ -105,6 +388,28 @@ void SingleCellSimulationViewSimulationWorker::run()
 
 void SingleCellSimulationViewSimulationWorker::started()
 {
+    // Wait for our simulation scheduler to let us run, unless we get stopped
+    // in the meantime
+    // Note: our scheduler caps the number of simulations that can run at the
+    //       same time, so we may have to wait for another simulation to be
+    //       done or to yield...
+
+    SingleCellSimulationViewSimulationScheduler *scheduler = SingleCellSimulationViewSimulationScheduler::instance();
+
+    if (!scheduler->acquire(mSimulation, mStopped)) {
+        // We were stopped before we even got to run, so let people know that
+        // we didn't run
+        // Note: we use -1 as a way to indicate that our simulation didn't
+        //       (properly) run, so that it doesn't look like a successful (and
+        //       instantaneous) run...
+
+        *mSelf = 0;
+
+        emit finished(-1, QVariantMap(), 0);
+
+        return;
+    }
+
     // Reset our progress
 
     mProgress = 0.0;
@@ -118,6 +423,7 @@ void SingleCellSimulationViewSimulationWorker::started()
     CoreSolver::CoreVoiSolver *voiSolver = 0;
     CoreSolver::CoreOdeSolver *odeSolver = 0;
     CoreSolver::CoreDaeSolver *daeSolver = 0;
+    SolverInterface *odeSolverInterface = 0;
 
     if (mRuntime->needOdeSolver()) {
         foreach (SolverInterface *solverInterface, mSolverInterfaces)
@@ -126,6 +432,7 @@ void SingleCellSimulationViewSimulationWorker::started()
                 // of it
 
                 voiSolver = odeSolver = static_cast<CoreSolver::CoreOdeSolver *>(solverInterface->instance());
+                odeSolverInterface = solverInterface;
 
                 break;
             }
@@ -177,6 +484,24 @@ void SingleCellSimulationViewSimulationWorker::started()
         connect(nlaSolver, SIGNAL(error(const QString &)),
                 this, SLOT(emitError(const QString &)));
 
+    // Set up the NLA solver to compute our steady state, if needed
+    // Note: we cannot reuse the above NLA solver since it may be needed to
+    //       solve some NLA systems while computing our rates...
+
+    CoreSolver::CoreNlaSolver *steadyStateSolver = 0;
+
+    if (odeSolver && mSimulation->data()->steadyState()) {
+        foreach (SolverInterface *solverInterface, mSolverInterfaces)
+            if (!solverInterface->name().compare("KINSOL")) {
+                steadyStateSolver = static_cast<CoreSolver::CoreNlaSolver *>(solverInterface->instance());
+
+                break;
+            }
+
+        if (!steadyStateSolver)
+            emitError(tr("the KINSOL solver is needed to compute a steady state"));
+    }
+
     // Retrieve our simulation properties
 
     double startingPoint = mSimulation->data()->startingPoint();
@@ -188,18 +513,123 @@ void SingleCellSimulationViewSimulationWorker::started()
     int pointCounter = 0;
     double currentPoint = startingPoint;
 
+    // Determine whether we need to compute the sensitivity of our states with
+    // respect to some of our constants, in which case our ODE solver has to
+    // solve an augmented system which consists of our states followed by their
+    // sensitivities
+
+    static const int SizeOfDouble = sizeof(double);
+
+    int statesCount = mRuntime->statesCount();
+    int sensitivityParametersCount = mSimulation->results()->sensitivityParameters().count();
+    double *states = mSimulation->data()->states();
+    double *rates = mSimulation->data()->rates();
+    double *sensitivities = 0;
+    CellMLSupport::CellmlFileRuntime::ComputeRatesFunction computeRates = mRuntime->computeRates();
+
+    if (   odeSolver && !steadyStateSolver && sensitivityParametersCount
+        && mRuntime->computeSensitivityRates()) {
+        int augmentedStatesCount = statesCount*(sensitivityParametersCount+1);
+
+        states = new double[augmentedStatesCount];
+        rates  = new double[augmentedStatesCount];
+
+        memcpy(states, mSimulation->data()->states(), statesCount*SizeOfDouble);
+        memset(states+statesCount, 0, (augmentedStatesCount-statesCount)*SizeOfDouble);
+        memset(rates, 0, augmentedStatesCount*SizeOfDouble);
+
+        sensitivities = states+statesCount;
+
+        // Let computeSensitivityRates() know about the constants with respect
+        // to which we want to compute the sensitivity of our states, using
+        // the space that follows our constants (see
+        // CellmlFileRuntime::update())
+
+        double *constants = mSimulation->data()->constants();
+        int constantsCount = mRuntime->constantsCount();
+        int i = 0;
+
+        constants[constantsCount] = sensitivityParametersCount;
+
+        foreach (CellMLSupport::CellmlFileRuntimeModelParameter *sensitivityParameter,
+                 mSimulation->results()->sensitivityParameters())
+            constants[constantsCount+1+i++] = sensitivityParameter->index();
+
+        statesCount = augmentedStatesCount;
+        computeRates = mRuntime->computeSensitivityRates();
+    }
+
+    // Carry on from our checkpoint, if requested, by retrieving our model
+    // parameters, our states (and their sensitivities), our results so far and
+    // where we were
+    // Note: our checkpoint is identified by our simulation's cache key, i.e. it
+    //       can only be used with the very same model, starting values and
+    //       simulation settings (see SingleCellSimulationViewSimulation::computeCacheKey())...
+
+    QByteArray cacheKey = mSimulation->cacheKey();
+    QString checkpointFileName = cacheKey.isEmpty()?
+                                     QString():
+                                     SingleCellSimulationViewSimulationCheckpoint::fileName(cacheKey);
+    SingleCellSimulationViewSimulationCheckpoint checkpoint;
+    bool resuming = false;
+
+    if (mSimulation->isResuming() && !steadyStateSolver) {
+        bool checkpointLoaded =    !checkpointFileName.isEmpty()
+                                && checkpoint.load(checkpointFileName)
+                                && (checkpoint.key() == cacheKey)
+                                && (checkpoint.constants().count() == mRuntime->constantsCount())
+                                && (checkpoint.states().count() == statesCount)
+                                && (checkpoint.rates().count() == statesCount)
+                                && (checkpoint.algebraic().count() == mRuntime->algebraicCount())
+                                && !checkpoint.results().isEmpty();
+
+        // Our results were saved in several chunks (see
+        // SingleCellSimulationViewSimulationCheckpoint::addResults()), so
+        // deserialise and append them one after the other
+
+        QList<QByteArray> checkpointResults = checkpoint.results();
+
+        for (int i = 0, iMax = checkpointResults.count(); checkpointLoaded && (i < iMax); ++i) {
+            QDataStream resultsStream(&checkpointResults[i], QIODevice::ReadOnly);
+
+            resultsStream.setVersion(QDataStream::Qt_5_0);
+
+            checkpointLoaded = mSimulation->results()->deserialize(resultsStream, i != 0);
+        }
+
+        if (!checkpointLoaded) {
+            emitError(tr("the checkpoint could not be loaded"));
+        } else {
+            memcpy(mSimulation->data()->constants(), checkpoint.constants().constData(), mRuntime->constantsCount()*SizeOfDouble);
+            memcpy(states, checkpoint.states().constData(), statesCount*SizeOfDouble);
+            memcpy(rates, checkpoint.rates().constData(), statesCount*SizeOfDouble);
+            memcpy(mSimulation->data()->algebraic(), checkpoint.algebraic().constData(), mRuntime->algebraicCount()*SizeOfDouble);
+
+            if (sensitivities) {
+                memcpy(mSimulation->data()->states(), states, mRuntime->statesCount()*SizeOfDouble);
+                memcpy(mSimulation->data()->rates(), rates, mRuntime->statesCount()*SizeOfDouble);
+            }
+
+            currentPoint = checkpoint.point();
+            pointCounter = checkpoint.pointCounter();
+
+            mProgress = (currentPoint-startingPoint)*oneOverPointsRange;
+
+            resuming = true;
+        }
+    }
+
     // Initialise our ODE/DAE solver
 
     if (odeSolver) {
         odeSolver->setProperties(mSimulation->data()->odeSolverProperties());
 
-        odeSolver->initialize(currentPoint,
-                              mRuntime->statesCount(),
-                              mSimulation->data()->constants(),
-                              mSimulation->data()->states(),
-                              mSimulation->data()->rates(),
-                              mSimulation->data()->algebraic(),
-                              mRuntime->computeRates());
+        if (!sensitivities)
+            odeSolver->setComputeSteps(mRuntime->computeSteps(odeSolver->computeStepsFunctionName()));
+
+        odeSolver->initialize(currentPoint, statesCount,
+                              mSimulation->data()->constants(), states, rates,
+                              mSimulation->data()->algebraic(), computeRates);
     } else {
         daeSolver->setProperties(mSimulation->data()->daeSolverProperties());
 
@@ -217,6 +647,11 @@ void SingleCellSimulationViewSimulationWorker::started()
                               mRuntime->computeStateInformation());
     }
 
+    // Let our ODE/DAE solver carry on from where it was, if we are resuming
+
+    if (resuming)
+        voiSolver->setInternalState(checkpoint.solverState());
+
     // Initialise our NLA solver
 
     if (nlaSolver)
@@ -226,6 +661,9 @@ void SingleCellSimulationViewSimulationWorker::started()
     // so far
 
     int elapsedTime;
+    qint64 solverTime = 0;
+    CoreSolver::Statistics parallelInTimeStatistics = CoreSolver::Statistics();
+    qulonglong discardedPointsCount = 0;
 
     if (!mError) {
         // Start our timer
@@ -236,45 +674,193 @@ void SingleCellSimulationViewSimulationWorker::started()
 
         timer.start();
 
+        // Compute our steady state, if needed
+
+        if (   steadyStateSolver
+            && !computeSteadyState(steadyStateSolver, currentPoint)
+            && !mStopped)
+            emitError(tr("no steady state could be found"));
+
         // Add our first point after making sure that all the variables have
-        // been computed
+        // been computed, unless we are resuming, in which case our results
+        // already contain it
 
         mSimulation->data()->recomputeVariables(currentPoint, false);
 
-        mSimulation->results()->addPoint(currentPoint);
+        if (!resuming)
+            mSimulation->results()->addPoint(currentPoint, sensitivities);
+
+        // Keep track of our states at the beginning of our first cycle, if we
+        // want to check whether our model reaches a periodic steady state
+        // Note: our states are only compared at our output points, so our
+        //       period should ideally be a multiple of our point interval...
+
+        double period = steadyStateSolver?0.0:qAbs(mSimulation->data()->period());
+        double *cycleStates = 0;
+        QList<qulonglong> cycleStarts;
+        int cyclesCount = 0;
+
+        if (period) {
+            cycleStates = new double[mRuntime->statesCount()];
 
-        // Our main work loop
+            if (resuming && (checkpoint.cycleStates().count() == mRuntime->statesCount())) {
+                memcpy(cycleStates, checkpoint.cycleStates().constData(), mRuntime->statesCount()*SizeOfDouble);
+
+                cycleStarts = checkpoint.cycleStarts();
+                cyclesCount = checkpoint.cyclesCount();
+            } else {
+                memcpy(cycleStates, mSimulation->data()->states(), mRuntime->statesCount()*SizeOfDouble);
+
+                cycleStarts << 0;
+            }
+        }
+
+        bool periodicSteadyState = false;
+
+        // Compute our model in parallel in time, if requested and possible
+        // Note: our NLA solver, if any, is shared by all the instances of our
+        //       model, so we cannot compute our model in parallel if we need
+        //       one. The same holds for our sensitivities and periodic steady
+        //       state detection, which require our states to be computed in
+        //       order...
+
+        if (   mSimulation->data()->parallelInTime()
+            && odeSolver && !steadyStateSolver && !nlaSolver
+            && !sensitivities && !cycleStates && !resuming
+            && (QThread::idealThreadCount() > 1)) {
+            QElapsedTimer parallelInTimeTimer;
+
+            parallelInTimeTimer.start();
+
+            if (computeParallelInTime(odeSolverInterface, startingPoint,
+                                      endingPoint, pointInterval,
+                                      parallelInTimeStatistics))
+                currentPoint = endingPoint;
+
+            solverTime += parallelInTimeTimer.nsecsElapsed();
+        }
+
+        // Our main work loop, during which we save a checkpoint every so often
+        // (if possible and requested)
+
+        int checkpointInterval = checkpointFileName.isEmpty()?
+                                     0:
+                                     1000*SingleCellSimulationViewSimulationCheckpoint::interval();
+        QTime checkpointTimer;
+        qulonglong checkpointedResultsSize = resuming?mSimulation->results()->size():0;
+
+        checkpointTimer.start();
 
         QMutex pausedMutex;
 
         QMutex delayMutex;
         QWaitCondition delayCondition;
 
-        while ((currentPoint != endingPoint) && !mStopped && !mError) {
+        QElapsedTimer solverTimer;
+
+        while (   !steadyStateSolver && !periodicSteadyState
+               && (currentPoint != endingPoint) && !mStopped && !mError) {
             // Determine our next point and compute our model up to it
 
             ++pointCounter;
 
+            solverTimer.start();
+
             voiSolver->solve(currentPoint,
                              increasingPoints?
                                  qMin(endingPoint, startingPoint+pointCounter*pointInterval):
                                  qMax(endingPoint, startingPoint+pointCounter*pointInterval));
 
+            solverTime += solverTimer.nsecsElapsed();
+
             // Update our progress
 
             mProgress = (currentPoint-startingPoint)*oneOverPointsRange;
 
+            // Retrieve our states and rates from our augmented system, if
+            // needed
+
+            if (sensitivities) {
+                memcpy(mSimulation->data()->states(), states, mRuntime->statesCount()*SizeOfDouble);
+                memcpy(mSimulation->data()->rates(), rates, mRuntime->statesCount()*SizeOfDouble);
+            }
+
             // Add our new point after making sure that all the variables have
             // been computed
 
             mSimulation->data()->recomputeVariables(currentPoint, false);
 
-            mSimulation->results()->addPoint(currentPoint);
+            mSimulation->results()->addPoint(currentPoint, sensitivities);
+
+            // Check whether we have reached the end of a cycle and, if so,
+            // whether our states have changed (beat-to-beat) by less than our
+            // tolerance
+
+            if (   cycleStates
+                && (qAbs(currentPoint-startingPoint) >= (cyclesCount+1)*period)) {
+                double *currentStates = mSimulation->data()->states();
+                double periodTolerance = mSimulation->data()->periodTolerance();
+
+                periodicSteadyState = true;
+
+                for (int i = 0, iMax = mRuntime->statesCount(); i < iMax; ++i)
+                    if (qAbs(currentStates[i]-cycleStates[i]) > periodTolerance*(1.0+qAbs(currentStates[i]))) {
+                        periodicSteadyState = false;
+
+                        break;
+                    }
+
+                memcpy(cycleStates, currentStates, mRuntime->statesCount()*SizeOfDouble);
+
+                cycleStarts << mSimulation->results()->size()-1;
+
+                ++cyclesCount;
+            }
 
             // Check whether some or even all of our data has changed
 
             mSimulation->data()->checkForModifications();
 
+            // Save a checkpoint, if needed
+
+            if (   checkpointInterval && !mStopped && !mError
+                && (checkpointTimer.elapsed() >= checkpointInterval)) {
+                checkpoint.setKey(cacheKey);
+
+                checkpoint.setPoint(currentPoint);
+                checkpoint.setPointCounter(pointCounter);
+
+                checkpoint.setConstants(vector(mSimulation->data()->constants(), mRuntime->constantsCount()));
+                checkpoint.setStates(vector(states, statesCount));
+                checkpoint.setRates(vector(rates, statesCount));
+                checkpoint.setAlgebraic(vector(mSimulation->data()->algebraic(), mRuntime->algebraicCount()));
+
+                checkpoint.setCyclesCount(cyclesCount);
+                checkpoint.setCycleStates(cycleStates?vector(cycleStates, mRuntime->statesCount()):QVector<double>());
+                checkpoint.setCycleStarts(cycleStarts);
+
+                checkpoint.setSolverState(voiSolver->internalState());
+
+                // Only serialise the results that were recorded since our
+                // previous checkpoint, if any
+
+                QByteArray checkpointResults = QByteArray();
+                QDataStream resultsStream(&checkpointResults, QIODevice::WriteOnly);
+
+                resultsStream.setVersion(QDataStream::Qt_5_0);
+
+                if (mSimulation->results()->serialize(resultsStream, checkpointedResultsSize)) {
+                    checkpoint.addResults(checkpointResults);
+
+                    checkpointedResultsSize = mSimulation->results()->size();
+                }
+
+                if (!checkpoint.results().isEmpty())
+                    checkpoint.save(checkpointFileName);
+
+                checkpointTimer.restart();
+            }
+
             // Delay things a bit, if (really) needed
 
             if (mSimulation->data()->delay() && !mStopped && !mError) {
@@ -287,6 +873,26 @@ void SingleCellSimulationViewSimulationWorker::started()
                 timer.restart();
             }
 
+            // Give our slot to another simulation, if our scheduler wants us
+            // to (e.g. our time slice has expired or the simulation in the
+            // visible tab is waiting)
+
+            if (!mStopped && !mError && scheduler->shouldYield(mSimulation)) {
+                elapsedTime += timer.elapsed();
+
+                scheduler->release(mSimulation);
+
+                bool acquired = scheduler->acquire(mSimulation, mStopped);
+
+                timer.restart();
+
+                // Stop here if we got stopped while waiting for our slot back,
+                // since we don't have a slot anymore
+
+                if (!acquired)
+                    break;
+            }
+
             // Check whether we should be paused
 
             if (mPaused) {
@@ -298,16 +904,30 @@ void SingleCellSimulationViewSimulationWorker::started()
 
                 emit paused();
 
-                // Actually pause ourselves
+                // Actually pause ourselves, letting another simulation use our
+                // slot in the meantime
+
+                scheduler->release(mSimulation);
 
                 pausedMutex.lock();
                     mPausedCondition.wait(&pausedMutex);
                 pausedMutex.unlock();
 
+                bool acquired = scheduler->acquire(mSimulation, mStopped);
+
                 // We are not paused anymore
 
                 mPaused = false;
 
+                // Stop here if we got stopped while paused or while waiting
+                // for our slot back, since we don't have a slot anymore
+
+                if (!acquired) {
+                    timer.restart();
+
+                    break;
+                }
+
                 // Let people know that we are running again
 
                 emit running(true);
@@ -320,15 +940,16 @@ void SingleCellSimulationViewSimulationWorker::started()
             // Reinitialise our solver, if needed
 
             if (mReset) {
-                if (odeSolver)
-                    odeSolver->initialize(currentPoint,
-                                          mRuntime->statesCount(),
+                if (odeSolver) {
+                    if (sensitivities)
+                        memcpy(states, mSimulation->data()->states(), mRuntime->statesCount()*SizeOfDouble);
+
+                    odeSolver->initialize(currentPoint, statesCount,
                                           mSimulation->data()->constants(),
-                                          mSimulation->data()->states(),
-                                          mSimulation->data()->rates(),
+                                          states, rates,
                                           mSimulation->data()->algebraic(),
-                                          mRuntime->computeRates());
-                else
+                                          computeRates);
+                } else {
                     daeSolver->initialize(currentPoint, endingPoint,
                                           mRuntime->statesCount(),
                                           mRuntime->condVarCount(),
@@ -341,11 +962,38 @@ void SingleCellSimulationViewSimulationWorker::started()
                                           mRuntime->computeResiduals(),
                                           mRuntime->computeRootInformation(),
                                           mRuntime->computeStateInformation());
+                }
 
                 mReset = false;
             }
         }
 
+        // Record whatever points our recording policy has yet to record, so
+        // that our last point ends up in our results
+
+        mSimulation->results()->flushPoints();
+
+        // Keep track of the number of cycles that were needed to reach a
+        // periodic steady state, if any, and of the number of points that
+        // precede the last few cycles, if we only want to keep those
+        // Note: our points get discarded by our simulation once we are done
+        //       (see SingleCellSimulationViewSimulation::workerFinished()),
+        //       i.e. from the GUI thread, so that our results don't get moved
+        //       around while they are being plotted...
+
+        if (cycleStates) {
+            int keptCycles = mSimulation->data()->keptCycles();
+
+            if (periodicSteadyState) {
+                mSimulation->results()->setCyclesCount(cyclesCount);
+
+                if (!mError && (keptCycles > 0) && (cyclesCount > keptCycles))
+                    discardedPointsCount = cycleStarts.at(cyclesCount-keptCycles);
+            }
+
+            delete[] cycleStates;
+        }
+
         // Retrieve the total elapsed time, should no error have occurred
 
         if (mError)
@@ -362,9 +1010,57 @@ void SingleCellSimulationViewSimulationWorker::started()
         // Note: we use -1 as a way to indicate that something went wrong...
     }
 
+    // Stop streaming our results, if we were doing so
+
+    mSimulation->results()->stopStreaming();
+
+    // Remove our checkpoint, if any, should we have completed our simulation
+
+    if (!mStopped && !mError && !checkpointFileName.isEmpty())
+        QFile::remove(checkpointFileName);
+
+    // Let our scheduler know that we are done running
+
+    scheduler->release(mSimulation);
+
+    // Retrieve the statistics of our solver(s), to which we add the time spent
+    // in our ODE/DAE solver
+    // Note: our NLA solver, if any, is called from within our model code, so
+    //       the time it spends is part of our ODE/DAE solver's model time...
+
+    QVariantMap statistics = QVariantMap();
+
+    if (voiSolver) {
+        CoreSolver::Statistics voiSolverStatistics = voiSolver->statistics();
+
+        CoreSolver::CoreSolver::addStatistics(voiSolverStatistics,
+                                              parallelInTimeStatistics);
+
+        voiSolverStatistics.insert(CoreSolver::SolverTimeStatistic, 0.000001*solverTime);
+
+        statistics.insert(odeSolver?mSimulation->data()->odeSolverName():"IDA",
+                          voiSolverStatistics);
+    }
+
+    if (nlaSolver)
+        statistics.insert(mSimulation->data()->nlaSolverName(),
+                          nlaSolver->statistics());
+
+    if (steadyStateSolver)
+        statistics.insert(tr("KINSOL (steady state)"),
+                          steadyStateSolver->statistics());
+
     // Delete our solver(s)
 
     delete voiSolver;
+    delete steadyStateSolver;
+
+    // Delete our augmented system, if any
+
+    if (sensitivities) {
+        delete[] states;
+        delete[] rates;
+    }
 
     if (nlaSolver) {
         delete nlaSolver;
@@ -379,9 +1075,10 @@ void SingleCellSimulationViewSimulationWorker::started()
 
     *mSelf = 0;
 
-    // Let people know that we are done and give them the elapsed time
+    // Let people know that we are done and give them the elapsed time, the
+    // statistics of our solver(s) and the number of points to discard
 
-    emit finished(elapsedTime);
+    emit finished(elapsedTime, statistics, discardedPointsCount);
 }
 
 //==============================================================================
@@ -420,10 +1117,13 @@ void SingleCellSimulationViewSimulationWorker::stop()
         if (isPaused())
             mPausedCondition.wakeAll();
 
-        // Ask ourselves to stop
+        // Ask ourselves to stop, waking up our simulation scheduler in case we
+        // are waiting for it to let us run
 
         mStopped = true;
 
+        SingleCellSimulationViewSimulationScheduler::instance()->wakeUp();
+
         // Ask our thread to quit and wait for it to do so
 
         mThread->quit();
@@ -449,6 +1149,310 @@ void SingleCellSimulationViewSimulationWorker::reset()
 
 //==============================================================================
 
+double SingleCellSimulationViewSimulationWorker::ratesNorm(const double &pVoi) const
+{
+    // Compute our rates and return their maximum norm, or infinity if any of
+    // them is not finite
+
+    int statesCount = mRuntime->statesCount();
+    double *rates = mSimulation->data()->rates();
+
+    mRuntime->computeRates()(pVoi, mSimulation->data()->constants(), rates,
+                             mSimulation->data()->states(),
+                             mSimulation->data()->algebraic());
+
+    double res = 0.0;
+
+    for (int i = 0; i < statesCount; ++i)
+        if (!qIsFinite(rates[i]))
+            return qInf();
+        else
+            res = qMax(res, qAbs(rates[i]));
+
+    return res;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationWorker::computeSteadyState(CoreSolver::CoreNlaSolver *pNlaSolver,
+                                                                  const double &pVoi)
+{
+    // Compute the steady state of our model, i.e. the states for which all our
+    // rates are equal to zero
+    // Note #1: we first try to solve f(y)=0 directly using Newton's method.
+    //          This is the fastest option, but it may fail if our initial
+    //          states are too far away from the steady state, in which case we
+    //          fall back to pseudo-transient continuation, i.e. a series of
+    //          implicit Euler steps which size grows as our rates get smaller
+    //          (switched evolution relaxation)...
+    // Note #2: our tolerance is KINSOL's default tolerance on the maximum norm
+    //          of its system function...
+
+    static const double Tolerance = 1.0e-5;
+    static const double MaximumTimeStepGrowth = 10.0;
+    static const int MaximumNumberOfSteps = 500;
+    static const int SizeOfDouble = sizeof(double);
+
+    int statesCount = mRuntime->statesCount();
+    double *states = mSimulation->data()->states();
+    double *previousStates = new double[statesCount];
+
+    SteadyStateSystem system;
+
+    system.computeRates    = mRuntime->computeRates();
+    system.voi             = pVoi;
+    system.constants       = mSimulation->data()->constants();
+    system.algebraic       = mSimulation->data()->algebraic();
+    system.previousStates  = previousStates;
+    system.oneOverTimeStep = 0.0;
+    system.statesCount     = statesCount;
+
+    memcpy(previousStates, states, statesCount*SizeOfDouble);
+
+    // Try to solve f(y)=0 directly
+
+    pNlaSolver->initialize(steadyStateSystem, states, statesCount, &system);
+    pNlaSolver->solve();
+
+    double residual = ratesNorm(pVoi);
+
+    if (residual <= Tolerance) {
+        delete[] previousStates;
+
+        return true;
+    }
+
+    // Newton's method failed, so restart from our initial states and use
+    // pseudo-transient continuation
+
+    memcpy(states, previousStates, statesCount*SizeOfDouble);
+
+    double previousResidual = ratesNorm(pVoi);
+    double timeStep = qAbs(mSimulation->data()->pointInterval());
+    bool res = false;
+
+    for (int i = 0; (i < MaximumNumberOfSteps) && !mStopped; ++i) {
+        memcpy(previousStates, states, statesCount*SizeOfDouble);
+
+        system.oneOverTimeStep = 1.0/timeStep;
+
+        pNlaSolver->solve();
+
+        residual = ratesNorm(pVoi);
+
+        if (!qIsFinite(residual)) {
+            // Our step failed, so go back to our previous states and try again
+            // with a smaller time step
+
+            memcpy(states, previousStates, statesCount*SizeOfDouble);
+
+            timeStep *= 0.5;
+
+            continue;
+        } else if (residual <= Tolerance) {
+            res = true;
+
+            break;
+        }
+
+        // Update our time step based on how much our rates have decreased
+
+        timeStep *= qMin(previousResidual/residual, MaximumTimeStepGrowth);
+
+        previousResidual = residual;
+    }
+
+    delete[] previousStates;
+
+    return res;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewSimulationWorker::computeParallelInTime(SolverInterface *pOdeSolverInterface,
+                                                                     const double &pStartingPoint,
+                                                                     const double &pEndingPoint,
+                                                                     const double &pPointInterval,
+                                                                     CoreSolver::Statistics &pStatistics)
+{
+    // Compute our model using the Parareal algorithm, i.e. split our
+    // simulation into time slices, which we compute in parallel using our
+    // (fine) ODE solver, and use a (coarse) forward Euler method, with our
+    // point interval as a step, to propagate corrections from one time slice
+    // to the next. We iterate until the states at the boundaries of our time
+    // slices have converged
+    // Note: after k iterations, the first k time slices are exact, so we are
+    //       guaranteed to converge after as many iterations as there are time
+    //       slices, although we normally converge much faster than that...
+    // Note #2: we already hold one slot of our simulation scheduler, so we only
+    //          use as many additional threads as it can give us slots, and we
+    //          let our caller compute our model the normal way (by returning
+    //          false) if that means fewer than two time slices...
+
+    static const double Tolerance = 1.0e-6;
+    static const int SizeOfDouble = sizeof(double);
+
+    SingleCellSimulationViewSimulationScheduler *scheduler = SingleCellSimulationViewSimulationScheduler::instance();
+    int statesCount = mRuntime->statesCount();
+    double *constants = mSimulation->data()->constants();
+    qulonglong pointsCount = qulonglong(mSimulation->size())-1;
+    int slicesCount = int(qMin(qulonglong(1+scheduler->acquireAdditionalSlots(mSimulation, QThread::idealThreadCount()-1)),
+                               pointsCount));
+
+    if (slicesCount < 2) {
+        scheduler->releaseAdditionalSlots(mSimulation);
+
+        return false;
+    }
+
+    // Create our time slices, each of which has its own (fine) ODE solver
+
+    QList<ParallelInTimeSlice *> slices;
+
+    for (int i = 0; i < slicesCount; ++i) {
+        CoreSolver::CoreOdeSolver *solver = static_cast<CoreSolver::CoreOdeSolver *>(pOdeSolverInterface->instance());
+
+        solver->setProperties(mSimulation->data()->odeSolverProperties());
+        solver->setComputeSteps(mRuntime->computeSteps(solver->computeStepsFunctionName()));
+
+        connect(solver, SIGNAL(error(const QString &)),
+                this, SLOT(emitError(const QString &)),
+                Qt::DirectConnection);
+
+        slices << new ParallelInTimeSlice(solver, mRuntime, constants,
+                                          pStartingPoint, pEndingPoint,
+                                          pPointInterval,
+                                          i*pointsCount/slicesCount,
+                                          (i+1)*pointsCount/slicesCount);
+    }
+
+    // Initialise the states at the beginning of our time slices using our
+    // coarse propagator, keeping track of its results since we need them to
+    // correct our states after each iteration
+
+    double *coarseStates = new double[slicesCount*statesCount];
+    double *oldStates = new double[statesCount];
+    double *rates = new double[mRuntime->ratesCount()];
+    double *algebraic = new double[mRuntime->algebraicCount()];
+
+    bool coarseOk = true;
+
+    memcpy(slices.first()->initialStates(), mSimulation->data()->states(),
+           statesCount*SizeOfDouble);
+
+    for (int i = 0; (i < slicesCount) && coarseOk; ++i) {
+        ParallelInTimeSlice *slice = slices.at(i);
+        double *states = coarseStates+i*statesCount;
+
+        memcpy(states, slice->initialStates(), statesCount*SizeOfDouble);
+
+        coarseOk = slice->propagateCoarsely(states, rates, algebraic);
+
+        if (coarseOk && (i < slicesCount-1))
+            memcpy(slices.at(i+1)->initialStates(), states,
+                   statesCount*SizeOfDouble);
+    }
+
+    // Iterate until convergence
+
+    QThreadPool threadPool;
+
+    threadPool.setMaxThreadCount(slicesCount);
+
+    for (int i = 0; (i < slicesCount) && coarseOk && !mStopped && !mError; ++i) {
+        // Compute the time slices which are not yet known to be exact using our
+        // fine propagator
+
+        for (int j = i; j < slicesCount; ++j)
+            threadPool.start(slices.at(j));
+
+        threadPool.waitForDone();
+
+        mProgress = double(i+1)/slicesCount;
+
+        // Propagate our corrections, i.e. U[j+1] = G(U[j])+F(U_old[j])-G(U_old[j])
+
+        double maximumChange = 0.0;
+
+        for (int j = i; j < slicesCount-1; ++j) {
+            ParallelInTimeSlice *slice = slices.at(j);
+            double *states = coarseStates+j*statesCount;
+
+            memcpy(oldStates, states, statesCount*SizeOfDouble);
+            memcpy(states, slice->initialStates(), statesCount*SizeOfDouble);
+
+            coarseOk = slice->propagateCoarsely(states, rates, algebraic);
+
+            if (!coarseOk)
+                break;
+
+            double *nextInitialStates = slices.at(j+1)->initialStates();
+
+            for (int k = 0; k < statesCount; ++k) {
+                double newState = states[k]+slice->finalStates()[k]-oldStates[k];
+
+                maximumChange = qMax(maximumChange,
+                                     qAbs(newState-nextInitialStates[k])/(1.0+qAbs(newState)));
+
+                nextInitialStates[k] = newState;
+            }
+        }
+
+        if (coarseOk && (maximumChange <= Tolerance))
+            break;
+    }
+
+    // Let people know if our coarse propagator failed us
+
+    if (!coarseOk && !mStopped && !mError)
+        emitError(tr("the coarse propagator of the parallel-in-time computation produced non-finite values (the model may be too stiff for it)"));
+
+    // Add our results, unless we were stopped or an error occurred
+
+    if (!mStopped && !mError)
+        foreach (ParallelInTimeSlice *slice, slices)
+            for (qulonglong i = slice->firstPoint()+1; i <= slice->lastPoint(); ++i) {
+                double voi = slice->point(i);
+
+                memcpy(mSimulation->data()->states(),
+                       slice->trajectory()+(i-slice->firstPoint()-1)*statesCount,
+                       statesCount*SizeOfDouble);
+
+                mRuntime->computeRates()(voi, constants,
+                                         mSimulation->data()->rates(),
+                                         mSimulation->data()->states(),
+                                         mSimulation->data()->algebraic());
+
+                mSimulation->data()->recomputeVariables(voi, false);
+
+                mSimulation->results()->addPoint(voi);
+            }
+
+    // Keep track of the statistics of our (fine) ODE solvers
+
+    foreach (ParallelInTimeSlice *slice, slices)
+        CoreSolver::CoreSolver::addStatistics(pStatistics,
+                                              slice->solver()->statistics());
+
+    // Delete some internal objects
+
+    delete[] coarseStates;
+    delete[] oldStates;
+    delete[] rates;
+    delete[] algebraic;
+
+    foreach (ParallelInTimeSlice *slice, slices)
+        delete slice;
+
+    // Give back the additional slots we were given by our scheduler
+
+    scheduler->releaseAdditionalSlots(mSimulation);
+
+    return true;
+}
+
+//==============================================================================
+
 void SingleCellSimulationViewSimulationWorker::emitError(const QString &pMessage)
 {
     // A solver error occurred, so keep track of it and let people know about it
@@ -7,11 +7,13 @@
 
 //==============================================================================
 
+#include "coresolver.h"
 #include "solverinterface.h"
 
 //==============================================================================
 
 #include <QObject>
+#include <QVariant>
 #include <QWaitCondition>
 
 //==============================================================================
@@ -26,6 +28,12 @@ namespace CellMLSupport {
 
 //==============================================================================
 
+namespace CoreSolver {
+    class CoreNlaSolver;
+}   // namespace CoreSolver
+
+//==============================================================================
+
 namespace SingleCellSimulationView {
 
 //==============================================================================
@@ -78,11 +86,22 @@ private:
 
     SingleCellSimulationViewSimulationWorker **mSelf;
 
+    double ratesNorm(const double &pVoi) const;
+    bool computeSteadyState(CoreSolver::CoreNlaSolver *pNlaSolver,
+                            const double &pVoi);
+
+    bool computeParallelInTime(SolverInterface *pOdeSolverInterface,
+                               const double &pStartingPoint,
+                               const double &pEndingPoint,
+                               const double &pPointInterval,
+                               CoreSolver::Statistics &pStatistics);
+
 Q_SIGNALS:
     void running(const bool &pIsResuming);
     void paused();
 
-    void finished(const int &pElapsedTime);
+    void finished(const int &pElapsedTime, const QVariantMap &pStatistics,
+                  const qulonglong &pDiscardedPointsCount);
 
     void error(const QString &pMessage);
 
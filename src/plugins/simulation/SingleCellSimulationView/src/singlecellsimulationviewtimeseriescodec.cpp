@@ -0,0 +1,558 @@
+//==============================================================================
+// Single cell simulation view time series codec
+//==============================================================================
+
+#include "singlecellsimulationviewtimeseriescodec.h"
+
+//==============================================================================
+
+#include <cstring>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+class SingleCellSimulationViewTimeSeriesBitWriter
+{
+public:
+    explicit SingleCellSimulationViewTimeSeriesBitWriter(const qulonglong &pExpectedSize);
+
+    void write(const quint64 &pValue, const int &pBitsCount);
+
+    QByteArray data();
+
+private:
+    QByteArray mData;
+
+    quint64 mBuffer;
+    int mBufferBitsCount;
+};
+
+//==============================================================================
+
+SingleCellSimulationViewTimeSeriesBitWriter::SingleCellSimulationViewTimeSeriesBitWriter(const qulonglong &pExpectedSize) :
+    mData(QByteArray()),
+    mBuffer(0),
+    mBufferBitsCount(0)
+{
+    // Reserve some space for our data, based on the expected number of values
+    // and a (pessimistic) compression ratio of 2:1
+
+    mData.reserve(pExpectedSize*sizeof(double)/2);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewTimeSeriesBitWriter::write(const quint64 &pValue,
+                                                        const int &pBitsCount)
+{
+    // Write the given number of (least significant) bits of the given value,
+    // most significant bit first, flushing our buffer whenever it is full
+
+    quint64 value = (pBitsCount < 64)?pValue & ((quint64(1) << pBitsCount)-1):pValue;
+    int freeBitsCount = 64-mBufferBitsCount;
+
+    if (pBitsCount < freeBitsCount) {
+        mBuffer = (mBuffer << pBitsCount) | value;
+
+        mBufferBitsCount += pBitsCount;
+    } else {
+        int remainingBitsCount = pBitsCount-freeBitsCount;
+
+        mBuffer = (freeBitsCount == 64)?
+                      value >> remainingBitsCount:
+                      (mBuffer << freeBitsCount) | (value >> remainingBitsCount);
+
+        for (int i = 56; i >= 0; i -= 8)
+            mData.append(char(mBuffer >> i));
+
+        mBuffer = remainingBitsCount?value & ((quint64(1) << remainingBitsCount)-1):0;
+        mBufferBitsCount = remainingBitsCount;
+    }
+}
+
+//==============================================================================
+
+QByteArray SingleCellSimulationViewTimeSeriesBitWriter::data()
+{
+    // Flush our remaining bits, if any, and return our data
+
+    if (mBufferBitsCount) {
+        quint64 buffer = mBuffer << (64-mBufferBitsCount);
+
+        for (int i = 0, iMax = (mBufferBitsCount+7)/8; i < iMax; ++i)
+            mData.append(char(buffer >> (56-8*i)));
+
+        mBuffer = 0;
+        mBufferBitsCount = 0;
+    }
+
+    mData.squeeze();
+
+    return mData;
+}
+
+//==============================================================================
+
+class SingleCellSimulationViewTimeSeriesBitReader
+{
+public:
+    explicit SingleCellSimulationViewTimeSeriesBitReader(const QByteArray &pData);
+
+    quint64 read(const int &pBitsCount);
+
+    bool hasError() const;
+
+private:
+    const uchar *mData;
+    const uchar *mDataEnd;
+
+    int mBitPosition;
+
+    bool mError;
+};
+
+//==============================================================================
+
+SingleCellSimulationViewTimeSeriesBitReader::SingleCellSimulationViewTimeSeriesBitReader(const QByteArray &pData) :
+    mData(reinterpret_cast<const uchar *>(pData.constData())+1),
+    mDataEnd(reinterpret_cast<const uchar *>(pData.constData())+pData.size()),
+    mBitPosition(0),
+    mError(false)
+{
+}
+
+//==============================================================================
+
+quint64 SingleCellSimulationViewTimeSeriesBitReader::read(const int &pBitsCount)
+{
+    // Read the given number of bits, most significant bit first, a byte (or
+    // what is left of it) at a time, unless we would read past the end of our
+    // data, in which case we keep track of the error
+
+    quint64 res = 0;
+
+    for (int bitsCount = pBitsCount; bitsCount;) {
+        if (mData == mDataEnd) {
+            mError = true;
+
+            return 0;
+        }
+
+        int byteBitsCount = 8-mBitPosition;
+        int readBitsCount = qMin(bitsCount, byteBitsCount);
+
+        res = (res << readBitsCount) | ((*mData >> (byteBitsCount-readBitsCount)) & ((1 << readBitsCount)-1));
+
+        mBitPosition += readBitsCount;
+        bitsCount -= readBitsCount;
+
+        if (mBitPosition == 8) {
+            ++mData;
+
+            mBitPosition = 0;
+        }
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewTimeSeriesBitReader::hasError() const
+{
+    // Return whether we tried to read past the end of our data
+
+    return mError;
+}
+
+//==============================================================================
+
+static quint64 bits(const double &pValue)
+{
+    // Return the bits of the given value
+
+    quint64 res;
+
+    memcpy(&res, &pValue, sizeof(double));
+
+    return res;
+}
+
+//==============================================================================
+
+static double value(const quint64 &pBits)
+{
+    // Return the value corresponding to the given bits
+
+    double res;
+
+    memcpy(&res, &pBits, sizeof(double));
+
+    return res;
+}
+
+//==============================================================================
+
+static int leadingZeros(const quint64 &pValue)
+{
+    // Return the number of leading zero bits of the given (non-zero) value
+
+    int res = 0;
+
+    for (quint64 mask = quint64(1) << 63; !(pValue & mask); mask >>= 1)
+        ++res;
+
+    return res;
+}
+
+//==============================================================================
+
+static int trailingZeros(const quint64 &pValue)
+{
+    // Return the number of trailing zero bits of the given (non-zero) value
+
+    int res = 0;
+
+    for (quint64 mask = 1; !(pValue & mask); mask <<= 1)
+        ++res;
+
+    return res;
+}
+
+//==============================================================================
+
+enum {
+    Raw,
+    Coded,
+    Invalid
+};
+
+//==============================================================================
+
+static QByteArray compressedData(SingleCellSimulationViewTimeSeriesBitWriter &pWriter,
+                                 const double *pData, const qulonglong &pSize)
+{
+    // Return our coded data or, if coding didn't help (e.g. noisy values), our
+    // raw data, preceded by a byte that tells which is which
+
+    QByteArray res = pWriter.data();
+    qulonglong rawSize = pSize*sizeof(double);
+
+    if (qulonglong(res.size()) < rawSize)
+        return QByteArray(1, char(Coded))+res;
+    else
+        return QByteArray(1, char(Raw))+QByteArray(reinterpret_cast<const char *>(pData), rawSize);
+}
+
+//==============================================================================
+
+static int dataType(const QByteArray &pCompressedData,
+                    const qulonglong &pSize)
+{
+    // Return whether we have raw or coded data, making sure that raw data has
+    // exactly the expected size
+
+    if (pCompressedData.isEmpty())
+        return Invalid;
+    else if (pCompressedData[0] == char(Raw))
+        return (qulonglong(pCompressedData.size()) == 1+pSize*sizeof(double))?Raw:Invalid;
+    else if (pCompressedData[0] == char(Coded))
+        return Coded;
+    else
+        return Invalid;
+}
+
+//==============================================================================
+
+static bool rawData(const QByteArray &pCompressedData, double *pData,
+                    const qulonglong &pSize, bool &pValid)
+{
+    // Retrieve our raw data, if that's what we have, and let our caller know
+    // whether our data is valid at all
+
+    int type = dataType(pCompressedData, pSize);
+
+    pValid = type != Invalid;
+
+    if (type != Raw)
+        return false;
+
+    memcpy(pData, pCompressedData.constData()+1, pSize*sizeof(double));
+
+    return true;
+}
+
+//==============================================================================
+
+QByteArray SingleCellSimulationViewTimeSeriesCodec::compressPoints(const double *pData,
+                                                                   const qulonglong &pSize)
+{
+    // Compress the given points, which we expect to be (mostly) equally
+    // spaced, by keeping track of our first point and first delta, followed by
+    // the delta of deltas using a variable number of bits
+    // Note: we work on the bits of our points since integer arithmetic is
+    //       exact (and therefore lossless), and points within a binade have
+    //       bits that are equally spaced too...
+
+    SingleCellSimulationViewTimeSeriesBitWriter writer(pSize);
+
+    quint64 previousBits = 0;
+    quint64 previousDelta = 0;
+
+    for (qulonglong i = 0; i < pSize; ++i) {
+        quint64 currentBits = bits(pData[i]);
+
+        if (!i) {
+            writer.write(currentBits, 64);
+        } else {
+            quint64 delta = currentBits-previousBits;
+
+            if (i == 1) {
+                writer.write(delta, 64);
+            } else {
+                // Zigzag encode our delta of deltas, so that small negative
+                // values are small too
+
+                qint64 deltaOfDeltas = qint64(delta-previousDelta);
+                quint64 zigzag = (quint64(deltaOfDeltas) << 1) ^ quint64(deltaOfDeltas >> 63);
+
+                if (!zigzag) {
+                    writer.write(0, 1);
+                } else if (zigzag < (quint64(1) << 7)) {
+                    writer.write(2, 2);
+                    writer.write(zigzag, 7);
+                } else if (zigzag < (quint64(1) << 12)) {
+                    writer.write(6, 3);
+                    writer.write(zigzag, 12);
+                } else if (zigzag < (quint64(1) << 20)) {
+                    writer.write(14, 4);
+                    writer.write(zigzag, 20);
+                } else {
+                    writer.write(15, 4);
+                    writer.write(zigzag, 64);
+                }
+            }
+
+            previousDelta = delta;
+        }
+
+        previousBits = currentBits;
+    }
+
+    return compressedData(writer, pData, pSize);
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewTimeSeriesCodec::uncompressPoints(const QByteArray &pCompressedData,
+                                                               double *pData,
+                                                               const qulonglong &pSize)
+{
+    // Uncompress the given points (see compressPoints()), returning false if
+    // they are not consistent with the given number of points
+
+    bool valid;
+
+    if (rawData(pCompressedData, pData, pSize, valid))
+        return true;
+    else if (!valid)
+        return false;
+
+    SingleCellSimulationViewTimeSeriesBitReader reader(pCompressedData);
+
+    quint64 previousBits = 0;
+    quint64 previousDelta = 0;
+
+    for (qulonglong i = 0; i < pSize; ++i) {
+        quint64 currentBits;
+
+        if (!i) {
+            currentBits = reader.read(64);
+        } else {
+            quint64 delta;
+
+            if (i == 1) {
+                delta = reader.read(64);
+            } else {
+                quint64 zigzag;
+
+                if (!reader.read(1))
+                    zigzag = 0;
+                else if (!reader.read(1))
+                    zigzag = reader.read(7);
+                else if (!reader.read(1))
+                    zigzag = reader.read(12);
+                else if (!reader.read(1))
+                    zigzag = reader.read(20);
+                else
+                    zigzag = reader.read(64);
+
+                qint64 deltaOfDeltas = qint64(zigzag >> 1) ^ -qint64(zigzag & 1);
+
+                delta = previousDelta+quint64(deltaOfDeltas);
+            }
+
+            currentBits = previousBits+delta;
+
+            previousDelta = delta;
+        }
+
+        if (reader.hasError())
+            return false;
+
+        pData[i] = value(currentBits);
+
+        previousBits = currentBits;
+    }
+
+    return true;
+}
+
+//==============================================================================
+
+QByteArray SingleCellSimulationViewTimeSeriesCodec::compressValues(const double *pData,
+                                                                   const qulonglong &pSize)
+{
+    // Compress the given values by XOR'ing each value with the previous one and
+    // only keeping track of the meaningful bits of the result, reusing the
+    // previous window of meaningful bits whenever possible
+
+    SingleCellSimulationViewTimeSeriesBitWriter writer(pSize);
+
+    quint64 previousBits = 0;
+    int previousLeadingZeros = -1;
+    int previousTrailingZeros = 0;
+
+    for (qulonglong i = 0; i < pSize; ++i) {
+        quint64 currentBits = bits(pData[i]);
+
+        if (!i) {
+            writer.write(currentBits, 64);
+        } else {
+            quint64 xorBits = currentBits ^ previousBits;
+
+            if (!xorBits) {
+                // Same value as before
+
+                writer.write(0, 1);
+            } else {
+                int currentLeadingZeros = qMin(leadingZeros(xorBits), 31);
+                int currentTrailingZeros = trailingZeros(xorBits);
+
+                if (   (previousLeadingZeros != -1)
+                    && (currentLeadingZeros >= previousLeadingZeros)
+                    && (currentTrailingZeros >= previousTrailingZeros)) {
+                    // Our meaningful bits fit within the previous window
+
+                    writer.write(2, 2);
+                    writer.write(xorBits >> previousTrailingZeros,
+                                 64-previousLeadingZeros-previousTrailingZeros);
+                } else {
+                    // New window of meaningful bits
+
+                    int meaningfulBitsCount = 64-currentLeadingZeros-currentTrailingZeros;
+
+                    writer.write(3, 2);
+                    writer.write(currentLeadingZeros, 5);
+                    writer.write(meaningfulBitsCount-1, 6);
+                    writer.write(xorBits >> currentTrailingZeros, meaningfulBitsCount);
+
+                    previousLeadingZeros = currentLeadingZeros;
+                    previousTrailingZeros = currentTrailingZeros;
+                }
+            }
+        }
+
+        previousBits = currentBits;
+    }
+
+    return compressedData(writer, pData, pSize);
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewTimeSeriesCodec::uncompressValues(const QByteArray &pCompressedData,
+                                                               double *pData,
+                                                               const qulonglong &pSize)
+{
+    // Uncompress the given values (see compressValues()), returning false if
+    // they are not consistent with the given number of values
+
+    bool valid;
+
+    if (rawData(pCompressedData, pData, pSize, valid))
+        return true;
+    else if (!valid)
+        return false;
+
+    SingleCellSimulationViewTimeSeriesBitReader reader(pCompressedData);
+
+    quint64 previousBits = 0;
+    int previousLeadingZeros = 0;
+    int previousTrailingZeros = 0;
+
+    for (qulonglong i = 0; i < pSize; ++i) {
+        quint64 currentBits;
+
+        if (!i) {
+            currentBits = reader.read(64);
+        } else if (!reader.read(1)) {
+            currentBits = previousBits;
+        } else {
+            if (reader.read(1)) {
+                previousLeadingZeros = reader.read(5);
+                previousTrailingZeros = 64-previousLeadingZeros-int(reader.read(6))-1;
+
+                if (previousTrailingZeros < 0)
+                    return false;
+            }
+
+            currentBits = previousBits ^ (reader.read(64-previousLeadingZeros-previousTrailingZeros) << previousTrailingZeros);
+        }
+
+        if (reader.hasError())
+            return false;
+
+        pData[i] = value(currentBits);
+
+        previousBits = currentBits;
+    }
+
+    return true;
+}
+
+//==============================================================================
+
+bool SingleCellSimulationViewTimeSeriesCodec::isValidSize(const QByteArray &pCompressedData,
+                                                          const qulonglong &pSize)
+{
+    // Return whether the given compressed data could hold the given number of
+    // points or values, i.e. raw data of exactly the right size or coded data
+    // that is smaller than raw data would be (see compressedData()), yet big
+    // enough for a full first value and at least one bit per other value
+
+    int type = dataType(pCompressedData, pSize);
+
+    if (type == Raw)
+        return true;
+    else if (type == Invalid)
+        return false;
+
+    qulonglong codedSize = pCompressedData.size()-1;
+
+    return    pSize && (codedSize < pSize*sizeof(double))
+           && (8*codedSize >= 64+pSize-1);
+}
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,51 @@
+//==============================================================================
+// Single cell simulation view time series codec
+//==============================================================================
+
+#ifndef SINGLECELLSIMULATIONVIEWTIMESERIESCODEC_H
+#define SINGLECELLSIMULATIONVIEWTIMESERIESCODEC_H
+
+//==============================================================================
+
+#include "singlecellsimulationviewglobal.h"
+
+//==============================================================================
+
+#include <QByteArray>
+
+//==============================================================================
+
+namespace OpenCOR {
+namespace SingleCellSimulationView {
+
+//==============================================================================
+
+class SINGLECELLSIMULATIONVIEW_EXPORT SingleCellSimulationViewTimeSeriesCodec
+{
+public:
+    static QByteArray compressPoints(const double *pData,
+                                     const qulonglong &pSize);
+    static bool uncompressPoints(const QByteArray &pCompressedData,
+                                 double *pData, const qulonglong &pSize);
+
+    static QByteArray compressValues(const double *pData,
+                                     const qulonglong &pSize);
+    static bool uncompressValues(const QByteArray &pCompressedData,
+                                 double *pData, const qulonglong &pSize);
+
+    static bool isValidSize(const QByteArray &pCompressedData,
+                            const qulonglong &pSize);
+};
+
+//==============================================================================
+
+}   // namespace SingleCellSimulationView
+}   // namespace OpenCOR
+
+//==============================================================================
+
+#endif
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -4,6 +4,7 @@
 
 #include "cellmlfilemanager.h"
 #include "cellmlfileruntime.h"
+#include "coresolver.h"
 #include "coreutils.h"
 #include "progressbarwidget.h"
 #include "propertyeditorwidget.h"
@@ -17,6 +18,9 @@
 #include "singlecellsimulationviewinformationwidget.h"
 #include "singlecellsimulationviewplugin.h"
 #include "singlecellsimulationviewsimulation.h"
+#include "singlecellsimulationviewsimulationcheckpoint.h"
+#include "singlecellsimulationviewsimulationresultscache.h"
+#include "singlecellsimulationviewsimulationscheduler.h"
 #include "singlecellsimulationviewwidget.h"
 #include "toolbarwidget.h"
 #include "usermessagewidget.h"
@@ -31,6 +35,7 @@
 #include <QDesktopWidget>
 #include <QDir>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QFrame>
 #include <QImage>
 #include <QLabel>
@@ -40,6 +45,7 @@
 #include <QSettings>
 #include <QSplitter>
 #include <QTextEdit>
+#include <QThread>
 #include <QTimer>
 #include <QVariant>
 
@@ -71,10 +77,12 @@ static const QString OutputBrLn = "<br/>\n";
 SingleCellSimulationViewWidgetCurveData::SingleCellSimulationViewWidgetCurveData(const QString &pFileName,
                                                                                  SingleCellSimulationViewSimulation *pSimulation,
                                                                                  CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter,
-                                                                                 SingleCellSimulationViewGraphPanelPlotCurve *pCurve) :
+                                                                                 SingleCellSimulationViewGraphPanelPlotCurve *pCurve,
+                                                                                 CellMLSupport::CellmlFileRuntimeModelParameter *pSensitivityParameter) :
     mFileName(pFileName),
     mSimulation(pSimulation),
     mModelParameter(pModelParameter),
+    mSensitivityParameter(pSensitivityParameter),
     mCurve(pCurve),
     mAttached(true)
 {
@@ -100,6 +108,16 @@ CellMLSupport::CellmlFileRuntimeModelParameter * SingleCellSimulationViewWidgetC
 
 //==============================================================================
 
+CellMLSupport::CellmlFileRuntimeModelParameter * SingleCellSimulationViewWidgetCurveData::sensitivityParameter() const
+{
+    // Return our sensitivity parameter, i.e. the constant with respect to which
+    // we plot the sensitivity of our model parameter, if any
+
+    return mSensitivityParameter;
+}
+
+//==============================================================================
+
 SingleCellSimulationViewGraphPanelPlotCurve * SingleCellSimulationViewWidgetCurveData::curve() const
 {
     // Return our curve
@@ -113,8 +131,10 @@ double * SingleCellSimulationViewWidgetCurveData::yData() const
 {
     // Return our Y data array
 
-    if (   (mModelParameter->type() == CellMLSupport::CellmlFileRuntimeModelParameter::Constant)
-        || (mModelParameter->type() == CellMLSupport::CellmlFileRuntimeModelParameter::ComputedConstant))
+    if (mSensitivityParameter)
+        return mSimulation->results()->sensitivities(mModelParameter, mSensitivityParameter);
+    else if (   (mModelParameter->type() == CellMLSupport::CellmlFileRuntimeModelParameter::Constant)
+             || (mModelParameter->type() == CellMLSupport::CellmlFileRuntimeModelParameter::ComputedConstant))
         return mSimulation->results()->constants()?mSimulation->results()->constants()[mModelParameter->index()]:0;
     else if (mModelParameter->type() == CellMLSupport::CellmlFileRuntimeModelParameter::State)
         return mSimulation->results()->states()?mSimulation->results()->states()[mModelParameter->index()]:0;
@@ -254,6 +274,11 @@ SingleCellSimulationViewWidget::SingleCellSimulationViewWidget(SingleCellSimulat
     connect(mContentsWidget->informationWidget()->parametersWidget(), SIGNAL(showModelParameter(const QString &, CellMLSupport::CellmlFileRuntimeModelParameter *, const bool &)),
             this, SLOT(showModelParameter(const QString &, CellMLSupport::CellmlFileRuntimeModelParameter *, const bool &)));
 
+    // Keep track of which sensitivities to show/hide
+
+    connect(mContentsWidget->informationWidget()->parametersWidget(), SIGNAL(showSensitivity(const QString &, CellMLSupport::CellmlFileRuntimeModelParameter *, CellMLSupport::CellmlFileRuntimeModelParameter *, const bool &)),
+            this, SLOT(showSensitivity(const QString &, CellMLSupport::CellmlFileRuntimeModelParameter *, CellMLSupport::CellmlFileRuntimeModelParameter *, const bool &)));
+
     // Create and add our invalid simulation message widget
 
     mInvalidModelMessageWidget = new Core::UserMessageWidget(":/oxygen/actions/help-about.png",
@@ -361,8 +386,13 @@ void SingleCellSimulationViewWidget::retranslateUi()
 
 //==============================================================================
 
-static const QString SettingsSizesCount = "SizesCount";
-static const QString SettingsSize       = "Size%1";
+static const QString SettingsSizesCount                     = "SizesCount";
+static const QString SettingsSize                           = "Size%1";
+static const QString SettingsMaximumRunningSimulationsCount = "MaximumRunningSimulationsCount";
+static const QString SettingsResultsCacheSize               = "ResultsCacheSize";
+static const QString SettingsCheckpointInterval             = "CheckpointInterval";
+static const QString SettingsCheckpointsSize                = "CheckpointsSize";
+static const QString SettingsModelTiming                    = "ModelTiming";
 
 //==============================================================================
 
@@ -381,6 +411,32 @@ void SingleCellSimulationViewWidget::loadSettings(QSettings *pSettings)
         mSplitterWidget->setSizes(mSplitterWidgetSizes);
     }
 
+    // Retrieve the maximum number of simulations that can run at the same time
+    // (by default, as many as we have cores)
+
+    SingleCellSimulationViewSimulationScheduler::instance()->setMaximumRunningSimulationsCount(pSettings->value(SettingsMaximumRunningSimulationsCount,
+                                                                                                                QThread::idealThreadCount()).toInt());
+
+    // Retrieve the maximum size of our simulation results cache (by default,
+    // 256 MB)
+
+    SingleCellSimulationViewSimulationResultsCache::instance()->setMaximumSize(1024*1024*pSettings->value(SettingsResultsCacheSize, 256).toLongLong());
+
+    // Retrieve the interval at which simulations save a checkpoint (by
+    // default, every 5 minutes)
+
+    SingleCellSimulationViewSimulationCheckpoint::setInterval(pSettings->value(SettingsCheckpointInterval, 300).toInt());
+
+    // Retrieve the maximum size of all our checkpoints together (by default,
+    // 256 MB)
+
+    SingleCellSimulationViewSimulationCheckpoint::setMaximumSize(1024*1024*pSettings->value(SettingsCheckpointsSize, 256).toLongLong());
+
+    // Retrieve whether our solvers are to time the evaluations of our models
+    // (by default, they are not)
+
+    CoreSolver::CoreSolver::setModelTiming(pSettings->value(SettingsModelTiming, false).toBool());
+
     // Retrieve the settings of our contents widget
 
     pSettings->beginGroup(mContentsWidget->objectName());
@@ -407,6 +463,33 @@ void SingleCellSimulationViewWidget::saveSettings(QSettings *pSettings) const
     for (int i = 0, iMax = mSplitterWidgetSizes.count(); i < iMax; ++i)
         pSettings->setValue(SettingsSize.arg(i), mSplitterWidgetSizes[i]);
 
+    // Keep track of the maximum number of simulations that can run at the same
+    // time
+
+    pSettings->setValue(SettingsMaximumRunningSimulationsCount,
+                        SingleCellSimulationViewSimulationScheduler::instance()->maximumRunningSimulationsCount());
+
+    // Keep track of the maximum size of our simulation results cache
+
+    pSettings->setValue(SettingsResultsCacheSize,
+                        SingleCellSimulationViewSimulationResultsCache::instance()->maximumSize()/(1024*1024));
+
+    // Keep track of the interval at which simulations save a checkpoint
+
+    pSettings->setValue(SettingsCheckpointInterval,
+                        SingleCellSimulationViewSimulationCheckpoint::interval());
+
+    // Keep track of the maximum size of all our checkpoints together
+
+    pSettings->setValue(SettingsCheckpointsSize,
+                        SingleCellSimulationViewSimulationCheckpoint::maximumSize()/(1024*1024));
+
+    // Keep track of whether our solvers are to time the evaluations of our
+    // models
+
+    pSettings->setValue(SettingsModelTiming,
+                        CoreSolver::CoreSolver::modelTiming());
+
     // Keep track of the settings of our contents widget
 
     pSettings->beginGroup(mContentsWidget->objectName());
@@ -450,6 +533,55 @@ void SingleCellSimulationViewWidget::output(const QString &pMessage)
 
 //==============================================================================
 
+QString SingleCellSimulationViewWidget::statisticsInformation(const QVariantMap &pStatistics) const
+{
+    // Return a human readable version of the given solver statistics, which
+    // distinguishes the time spent in our model code from the time spent in
+    // our solver itself, if known
+
+    QStringList res = QStringList();
+
+    if (pStatistics.contains(CoreSolver::StepsStatistic))
+        res << tr("%1 step(s)").arg(pStatistics.value(CoreSolver::StepsStatistic).toULongLong());
+
+    if (pStatistics.contains(CoreSolver::FunctionEvaluationsStatistic))
+        res << tr("%1 function evaluation(s)").arg(pStatistics.value(CoreSolver::FunctionEvaluationsStatistic).toULongLong());
+
+    if (pStatistics.contains(CoreSolver::JacobianEvaluationsStatistic))
+        res << tr("%1 Jacobian evaluation(s)").arg(pStatistics.value(CoreSolver::JacobianEvaluationsStatistic).toULongLong());
+
+    if (pStatistics.contains(CoreSolver::LinearSolvesStatistic))
+        res << tr("%1 linear solve(s)").arg(pStatistics.value(CoreSolver::LinearSolvesStatistic).toULongLong());
+
+    if (pStatistics.contains(CoreSolver::ErrorTestFailuresStatistic))
+        res << tr("%1 error test failure(s)").arg(pStatistics.value(CoreSolver::ErrorTestFailuresStatistic).toULongLong());
+
+    if (pStatistics.contains(CoreSolver::ConvergenceFailuresStatistic))
+        res << tr("%1 convergence failure(s)").arg(pStatistics.value(CoreSolver::ConvergenceFailuresStatistic).toULongLong());
+
+    // Note: the time spent in our model is only known if model timing is
+    //       enabled (see CoreSolver::CoreSolver::setModelTiming()), otherwise
+    //       it is part of the time spent in our solver...
+
+    double modelTime = pStatistics.value(CoreSolver::ModelTimeStatistic).toDouble();
+
+    if (pStatistics.contains(CoreSolver::ModelTimeStatistic))
+        res << tr("%1 s in the model").arg(QString::number(0.001*modelTime, 'g', 3));
+
+    if (pStatistics.contains(CoreSolver::SolverTimeStatistic)) {
+        double solverTime = pStatistics.value(CoreSolver::SolverTimeStatistic).toDouble();
+
+        if (pStatistics.contains(CoreSolver::ModelTimeStatistic))
+            res << tr("%1 s in the solver").arg(QString::number(0.001*qMax(0.0, solverTime-modelTime), 'g', 3));
+        else
+            res << tr("%1 s in the solver and the model").arg(QString::number(0.001*solverTime, 'g', 3));
+    }
+
+    return res.join(", ");
+}
+
+//==============================================================================
+
 void SingleCellSimulationViewWidget::updateSimulationMode()
 {
     bool simulationModeEnabled = mSimulation->isRunning() || mSimulation->isPaused();
@@ -467,10 +599,13 @@ void SingleCellSimulationViewWidget::updateSimulationMode()
     mContentsWidget->informationWidget()->simulationWidget()->setEnabled(!simulationModeEnabled);
     mContentsWidget->informationWidget()->solversWidget()->setEnabled(!simulationModeEnabled);
 
-    // Enable/disable our export to CSV
+    // Enable/disable our export
+    // Note: while running, our results can only be exported (and streamed) to
+    //       a binary file (see on_actionCsvExport_triggered()), which we allow
+    //       even if we don't yet have any results since they will get
+    //       streamed to it as they are computed...
 
-    mGui->actionCsvExport->setEnabled(    mSimulation->results()->size()
-                                      && !simulationModeEnabled);
+    mGui->actionCsvExport->setEnabled(simulationModeEnabled || mSimulation->results()->size());
 
     // Give the focus to our focus proxy, in case we leave our simulation mode
     // (so that the user can modify simulation data, etc.)
@@ -622,6 +757,19 @@ void SingleCellSimulationViewWidget::initialize(const QString &pFileName)
         mSimulations.insert(pFileName, mSimulation);
     }
 
+    // Make sure that our simulation's results are uncompressed since we are
+    // going to plot them, and forget about them if they can't be
+    // Note: those of our previous simulation get compressed once its curves
+    //       have been detached (see below)...
+
+    if (!mSimulation->results()->uncompress())
+        mSimulation->results()->reset(false);
+
+    // Give priority to our simulation object since it's the one in the visible
+    // tab
+
+    SingleCellSimulationViewSimulationScheduler::instance()->setPrioritySimulation(mSimulation);
+
     // Retrieve the status of the reset action and the value of the delay widget
 
     mGui->actionReset->setEnabled(mResets.value(pFileName, false));
@@ -837,6 +985,16 @@ void SingleCellSimulationViewWidget::initialize(const QString &pFileName)
             mActiveGraphPanel->plot()->detach(curveData->curve());
         }
 
+    // Compress the results of our previous simulation, if it is done running
+    // (see simulationStopped())
+    // Note: this must be done after its curves have been detached, since they
+    //       reference its results' arrays and detaching them also ensures that
+    //       none of them is still being rasterised...
+
+    if (   previousSimulation && (previousSimulation != mSimulation)
+        && !previousSimulation->isRunning() && !previousSimulation->isPaused())
+        previousSimulation->results()->compress();
+
     // Retrieve our graph panel's plot's axes settings and replot our graph
     // panel's plot, if available
 
@@ -862,6 +1020,13 @@ void SingleCellSimulationViewWidget::initialize(const QString &pFileName)
         simulationPropertyChanged(simulationWidget->startingPointProperty());
         simulationPropertyChanged(simulationWidget->endingPointProperty());
         simulationPropertyChanged(simulationWidget->pointIntervalProperty());
+        simulationPropertyChanged(simulationWidget->modeProperty());
+        simulationPropertyChanged(simulationWidget->periodProperty());
+        simulationPropertyChanged(simulationWidget->periodToleranceProperty());
+        simulationPropertyChanged(simulationWidget->keptCyclesProperty());
+        simulationPropertyChanged(simulationWidget->recordingProperty());
+        simulationPropertyChanged(simulationWidget->recordingIntervalProperty());
+        simulationPropertyChanged(simulationWidget->recordingThresholdProperty());
 
         // Now, initialise our graph panel's plot's X axis settings
 
@@ -910,30 +1075,28 @@ void SingleCellSimulationViewWidget::finalize(const QString &pFileName)
         // Reset our memory of the current simulation object, but only if it's
         // the same as our simulation object
 
-        if (simulation == mSimulation)
+        if (simulation == mSimulation) {
             mSimulation = 0;
+
+            SingleCellSimulationViewSimulationScheduler::instance()->setPrioritySimulation(0);
+        }
     }
 
     // Remove our curves' data associated with the given file name, if any
 
-    QList<QString> fileNames = QList<QString>();
-    QList<CellMLSupport::CellmlFileRuntimeModelParameter *> modelParameters = QList<CellMLSupport::CellmlFileRuntimeModelParameter *>();
-
-    foreach (SingleCellSimulationViewWidgetCurveData *curveData, mCurvesData)
-        if (!curveData->fileName().compare(pFileName)) {
-            // Keep track of the file name and model parameter of the curve data
-
-            fileNames << curveData->fileName();
-            modelParameters << curveData->modelParameter();
+    QMap<QString, SingleCellSimulationViewWidgetCurveData *>::iterator curveDataIter = mCurvesData.begin();
 
+    while (curveDataIter != mCurvesData.end())
+        if (!curveDataIter.value()->fileName().compare(pFileName)) {
             // Delete the curve and the curve data themselves
 
-            delete curveData->curve();
-            delete curveData;
-        }
+            delete curveDataIter.value()->curve();
+            delete curveDataIter.value();
 
-    for (int i = 0, iMax = fileNames.count(); i < iMax; ++i)
-        mCurvesData.remove(modelParameterKey(fileNames[i], modelParameters[i]));
+            curveDataIter = mCurvesData.erase(curveDataIter);
+        } else {
+            ++curveDataIter;
+        }
 
     // Remove various information associated with the given file name
 
@@ -1064,6 +1227,17 @@ void SingleCellSimulationViewWidget::on_actionRunPauseResume_triggered()
                 runSimulation = false;
             }
 
+            // Check whether our simulation could be resumed from a checkpoint
+            // (e.g. OpenCOR crashed while running it) and, if so, whether our
+            // user wants to do that
+
+            bool resumeSimulation = false;
+
+            if (runSimulation && mSimulation->hasCheckpoint())
+                resumeSimulation = QMessageBox::question(qApp->activeWindow(), tr("Run the simulation"),
+                                                         tr("A checkpoint of this simulation was saved during a previous run. Do you want to resume the simulation from it?"),
+                                                         QMessageBox::Yes|QMessageBox::No, QMessageBox::Yes) == QMessageBox::Yes;
+
             // Run our simulation, if possible/wanted
 
             if (runSimulation) {
@@ -1085,7 +1259,7 @@ void SingleCellSimulationViewWidget::on_actionRunPauseResume_triggered()
                 if (runSimulation)
                     // Now, we really run our simulation
 
-                    mSimulation->run();
+                    mSimulation->run(resumeSimulation);
                 else
                     QMessageBox::warning(qApp->activeWindow(), tr("Run the simulation"),
                                          tr("Sorry, but we could not allocate all the memory required for the simulation."));
@@ -1155,13 +1329,26 @@ void SingleCellSimulationViewWidget::on_actionRemove_triggered()
 
 void SingleCellSimulationViewWidget::on_actionCsvExport_triggered()
 {
-    // Export our simulation data results to a CSV file
+    // Export our simulation data results to either a CSV file or a binary file
+    // Note: if we are running, then we can only export our results to a binary
+    //       file, to which our new results get streamed until we are done...
+
+    static const QString BinaryFileExtension = "ocbr";
 
-    QString fileName = Core::getSaveFileName(tr("Export to a CSV file"),
+    bool running = mSimulation->isRunning() || mSimulation->isPaused();
+    QString binaryFilter = tr("OpenCOR Binary Results File")+" (*."+BinaryFileExtension+")";
+    QString fileName = Core::getSaveFileName(tr("Export to a CSV or binary file"),
                                              QString(),
-                                             tr("CSV File")+" (*.csv)");
+                                             running?
+                                                 binaryFilter:
+                                                 tr("CSV File")+" (*.csv);;"+binaryFilter);
+
+    if (fileName.isEmpty())
+        return;
 
-    if (!fileName.isEmpty())
+    if (running || !QFileInfo(fileName).suffix().compare(BinaryFileExtension))
+        mSimulation->results()->exportToBinary(fileName, running);
+    else
         mSimulation->results()->exportToCsv(fileName);
 }
 
@@ -1262,10 +1449,29 @@ void SingleCellSimulationViewWidget::simulationStopped(const int &pElapsedTime)
                 solversInformation += "+"+simulationData->nlaSolverName();
 
             output(QString(OutputTab+"<strong>"+tr("Simulation time:")+"</strong> <span"+OutputInfo+">"+tr("%1 s using %2").arg(QString::number(0.001*pElapsedTime, 'g', 3), solversInformation)+"</span>."+OutputBrLn));
+
+            // Output the statistics of our solver(s), if any
+
+            QVariantMap statistics = mSimulation->statistics();
+
+            foreach (const QString &solverName, statistics.keys())
+                output(QString(OutputTab+"<strong>"+tr("%1 statistics:").arg(solverName)+"</strong> <span"+OutputInfo+">"+statisticsInformation(statistics.value(solverName).toMap())+"</span>."+OutputBrLn));
+
+            // Output the number of cycles that were needed to reach a periodic
+            // steady state, if any
+
+            if (mSimulation->results()->cyclesCount())
+                output(QString(OutputTab+"<strong>"+tr("Periodic steady state:")+"</strong> <span"+OutputInfo+">"+tr("reached after %1 cycle(s)").arg(mSimulation->results()->cyclesCount())+"</span>."+OutputBrLn));
         }
 
         QTimer::singleShot(ResetDelay, this, SLOT(resetProgressBar()));
 
+        // Check our results one last time, since some of them may have been
+        // discarded once our simulation was done (see
+        // SingleCellSimulationViewSimulation::workerFinished())
+
+        checkResults(mSimulation);
+
         // Update our parameters and simulation mode
 
         mContentsWidget->informationWidget()->parametersWidget()->updateParameters();
@@ -1293,6 +1499,11 @@ void SingleCellSimulationViewWidget::simulationStopped(const int &pElapsedTime)
         //       the same time...
 
         if (simulation != mSimulation) {
+            // Our simulation is not the active one, so compress its results
+            // since they won't be needed until it becomes active again
+
+            simulation->results()->compress();
+
             mStoppedSimulations << simulation;
 
             QTimer::singleShot(ResetDelay, this, SLOT(resetFileTabIcon()));
@@ -1413,6 +1624,35 @@ void SingleCellSimulationViewWidget::simulationPropertyChanged(Core::Property *p
     } else if (pProperty == mContentsWidget->informationWidget()->simulationWidget()->pointIntervalProperty()) {
         mSimulation->data()->setPointInterval(Core::PropertyEditorWidget::doublePropertyItem(pProperty->value()));
 
+        needUpdating = false;
+    } else if (pProperty == mContentsWidget->informationWidget()->simulationWidget()->modeProperty()) {
+        mSimulation->data()->setSteadyState(mContentsWidget->informationWidget()->simulationWidget()->steadyState());
+        mSimulation->data()->setParallelInTime(mContentsWidget->informationWidget()->simulationWidget()->parallelInTime());
+
+        needUpdating = false;
+    } else if (pProperty == mContentsWidget->informationWidget()->simulationWidget()->periodProperty()) {
+        mSimulation->data()->setPeriod(Core::PropertyEditorWidget::doublePropertyItem(pProperty->value()));
+
+        needUpdating = false;
+    } else if (pProperty == mContentsWidget->informationWidget()->simulationWidget()->periodToleranceProperty()) {
+        mSimulation->data()->setPeriodTolerance(Core::PropertyEditorWidget::doublePropertyItem(pProperty->value()));
+
+        needUpdating = false;
+    } else if (pProperty == mContentsWidget->informationWidget()->simulationWidget()->keptCyclesProperty()) {
+        mSimulation->data()->setKeptCycles(Core::PropertyEditorWidget::integerPropertyItem(pProperty->value()));
+
+        needUpdating = false;
+    } else if (pProperty == mContentsWidget->informationWidget()->simulationWidget()->recordingProperty()) {
+        mSimulation->data()->setRecordingPolicy(SingleCellSimulationViewSimulationData::RecordingPolicy(mContentsWidget->informationWidget()->simulationWidget()->recordingPolicy()));
+
+        needUpdating = false;
+    } else if (pProperty == mContentsWidget->informationWidget()->simulationWidget()->recordingIntervalProperty()) {
+        mSimulation->data()->setRecordingInterval(Core::PropertyEditorWidget::integerPropertyItem(pProperty->value()));
+
+        needUpdating = false;
+    } else if (pProperty == mContentsWidget->informationWidget()->simulationWidget()->recordingThresholdProperty()) {
+        mSimulation->data()->setRecordingThreshold(Core::PropertyEditorWidget::doublePropertyItem(pProperty->value()));
+
         needUpdating = false;
     }
 
@@ -1467,11 +1707,18 @@ void SingleCellSimulationViewWidget::solversPropertyChanged(Core::Property *pPro
 //==============================================================================
 
 QString SingleCellSimulationViewWidget::modelParameterKey(const QString pFileName,
-                                                          CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter)
+                                                          CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter,
+                                                          CellMLSupport::CellmlFileRuntimeModelParameter *pSensitivityParameter)
 {
-    // Return the for the given model parameter
+    // Return the key for the given model parameter and, if any, sensitivity
+    // parameter
+
+    QString res = pFileName+"|"+QString::number(pModelParameter->type())+"|"+QString::number(pModelParameter->index());
+
+    if (pSensitivityParameter)
+        res += "|"+pSensitivityParameter->component()+"|"+pSensitivityParameter->name();
 
-    return pFileName+"|"+QString::number(pModelParameter->type())+"|"+QString::number(pModelParameter->index());
+    return res;
 }
 
 //==============================================================================
@@ -1479,10 +1726,35 @@ QString SingleCellSimulationViewWidget::modelParameterKey(const QString pFileNam
 void SingleCellSimulationViewWidget::showModelParameter(const QString &pFileName,
                                                         CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter,
                                                         const bool &pShow)
+{
+    // Show/hide the curve for the given model parameter
+
+    showCurve(pFileName, pModelParameter, 0, pShow);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewWidget::showSensitivity(const QString &pFileName,
+                                                     CellMLSupport::CellmlFileRuntimeModelParameter *pState,
+                                                     CellMLSupport::CellmlFileRuntimeModelParameter *pConstant,
+                                                     const bool &pShow)
+{
+    // Show/hide the curve for the sensitivity of the given state with respect
+    // to the given constant
+
+    showCurve(pFileName, pState, pConstant, pShow);
+}
+
+//==============================================================================
+
+void SingleCellSimulationViewWidget::showCurve(const QString &pFileName,
+                                               CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter,
+                                               CellMLSupport::CellmlFileRuntimeModelParameter *pSensitivityParameter,
+                                               const bool &pShow)
 {
     // Determine the key for the given parameter
 
-    QString key = modelParameterKey(pFileName, pModelParameter);
+    QString key = modelParameterKey(pFileName, pModelParameter, pSensitivityParameter);
 
     // Retrieve the curve data associated with the key, if any
 
@@ -1508,7 +1780,7 @@ void SingleCellSimulationViewWidget::showModelParameter(const QString &pFileName
         // data for it
 
         SingleCellSimulationViewGraphPanelPlotCurve *curve = new SingleCellSimulationViewGraphPanelPlotCurve();
-        SingleCellSimulationViewWidgetCurveData *curveData = new SingleCellSimulationViewWidgetCurveData(pFileName, mSimulation, pModelParameter, curve);
+        SingleCellSimulationViewWidgetCurveData *curveData = new SingleCellSimulationViewWidgetCurveData(pFileName, mSimulation, pModelParameter, curve, pSensitivityParameter);
 
         // Set some data for our curve
 
@@ -1548,9 +1820,13 @@ void SingleCellSimulationViewWidget::updateResults(SingleCellSimulationViewSimul
 
     if (simulation == mSimulation) {
         // We are dealing with the active simulation, so update our curves and
-        // progress bar, and enable/disable the export to CSV
+        // progress bar
 
         // Update our curves, if any
+        // Note: our results may have shrunk (e.g. after some cycles were
+        //       discarded), in which case we need to replot everything...
+
+        bool replot = pReplot || (pSize <= 1);
 
         foreach (SingleCellSimulationViewWidgetCurveData *curveData, mCurvesData)
             // Update the curve, should it be attached
@@ -1569,13 +1845,15 @@ void SingleCellSimulationViewWidget::updateResults(SingleCellSimulationViewSimul
                 // Draw the curve's new segment, but only if there is some data to
                 // plot and that we don't want to replot everything
 
-                if (!pReplot && (pSize > 1))
+                if (pSize < oldDataSize)
+                    replot = true;
+                else if (!replot)
                     mActiveGraphPanel->plot()->drawCurveSegment(curveData->curve(), oldDataSize?oldDataSize-1:0, pSize-1);
             }
 
         // Replot our active graph panel, if needed
 
-        if (pReplot || (pSize <= 1))
+        if (replot)
             // We want to initialise the plot and/or there is no data to plot,
             // so replot our active graph panel
 
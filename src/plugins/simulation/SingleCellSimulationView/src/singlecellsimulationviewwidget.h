@@ -69,11 +69,13 @@ public:
     explicit SingleCellSimulationViewWidgetCurveData(const QString &pFileName,
                                                      SingleCellSimulationViewSimulation *pSimulation,
                                                      CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter,
-                                                     SingleCellSimulationViewGraphPanelPlotCurve *pCurve);
+                                                     SingleCellSimulationViewGraphPanelPlotCurve *pCurve,
+                                                     CellMLSupport::CellmlFileRuntimeModelParameter *pSensitivityParameter = 0);
 
     QString fileName() const;
 
     CellMLSupport::CellmlFileRuntimeModelParameter * modelParameter() const;
+    CellMLSupport::CellmlFileRuntimeModelParameter * sensitivityParameter() const;
 
     SingleCellSimulationViewGraphPanelPlotCurve * curve() const;
 
@@ -88,6 +90,7 @@ private:
     SingleCellSimulationViewSimulation *mSimulation;
 
     CellMLSupport::CellmlFileRuntimeModelParameter *mModelParameter;
+    CellMLSupport::CellmlFileRuntimeModelParameter *mSensitivityParameter;
 
     SingleCellSimulationViewGraphPanelPlotCurve *mCurve;
 
@@ -194,6 +197,8 @@ private:
 
     void output(const QString &pMessage);
 
+    QString statisticsInformation(const QVariantMap &pStatistics) const;
+
     void updateSimulationMode();
 
     int tabBarIconSize() const;
@@ -208,7 +213,13 @@ private:
     void checkResults(SingleCellSimulationViewSimulation *pSimulation);
 
     QString modelParameterKey(const QString pFileName,
-                              CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter);
+                              CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter,
+                              CellMLSupport::CellmlFileRuntimeModelParameter *pSensitivityParameter = 0);
+
+    void showCurve(const QString &pFileName,
+                   CellMLSupport::CellmlFileRuntimeModelParameter *pModelParameter,
+                   CellMLSupport::CellmlFileRuntimeModelParameter *pSensitivityParameter,
+                   const bool &pShow);
 
 private Q_SLOTS:
     void on_actionRunPauseResume_triggered();
@@ -245,6 +256,10 @@ private Q_SLOTS:
     void showModelParameter(const QString &pFileName,
                             CellMLSupport::CellmlFileRuntimeModelParameter *pParameter,
                             const bool &pShow);
+    void showSensitivity(const QString &pFileName,
+                         CellMLSupport::CellmlFileRuntimeModelParameter *pState,
+                         CellMLSupport::CellmlFileRuntimeModelParameter *pConstant,
+                         const bool &pShow);
 
     void callCheckResults();
 };
@@ -0,0 +1,426 @@
+//==============================================================================
+// Single cell simulation view benchmark
+//==============================================================================
+
+#include "benchmark.h"
+#include "cellmlfile.h"
+#include "cellmlfileruntime.h"
+#include "plugin.h"
+#include "singlecellsimulationviewsimulation.h"
+#include "singlecellsimulationviewsimulationcheckpoint.h"
+#include "singlecellsimulationviewsimulationresultscache.h"
+
+//==============================================================================
+
+#include "../../../../../test/cellmlmodelgenerator.h"
+#include "../../../../../test/testutils.h"
+
+//==============================================================================
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPluginLoader>
+#include <QSignalSpy>
+#include <QTimer>
+
+//==============================================================================
+
+#if defined(Q_OS_WIN)
+    #include <windows.h>
+    #include <psapi.h>
+
+    #pragma comment(lib, "psapi.lib")
+#elif defined(Q_OS_MAC)
+    #include <mach/mach.h>
+#else
+    #include <unistd.h>
+#endif
+
+//==============================================================================
+
+static const QString ReportFileName = "benchmarks.json";
+
+//==============================================================================
+
+static qulonglong currentMemory()
+{
+    // Retrieve and return in bytes the amount of physical memory that is
+    // currently used by our process
+
+    qulonglong res = 0;
+
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS processMemoryCounters;
+
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &processMemoryCounters,
+                             sizeof(processMemoryCounters)))
+        res = qulonglong(processMemoryCounters.WorkingSetSize);
+#elif defined(Q_OS_MAC)
+    mach_task_basic_info_data_t taskInfo;
+    mach_msg_type_number_t taskInfoCount = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  task_info_t(&taskInfo), &taskInfoCount) == KERN_SUCCESS)
+        res = qulonglong(taskInfo.resident_size);
+#else
+    // On Linux, the second field of /proc/self/statm is our resident set size,
+    // in pages
+
+    QFile statmFile("/proc/self/statm");
+
+    if (statmFile.open(QIODevice::ReadOnly)) {
+        QList<QByteArray> fields = statmFile.readAll().split(' ');
+
+        if (fields.count() > 1)
+            res = fields[1].toULongLong()*qulonglong(sysconf(_SC_PAGESIZE));
+    }
+#endif
+
+    return res;
+}
+
+//==============================================================================
+
+static void simulationSettings(const QString &pFileName, double &pEndingPoint,
+                               double &pPointInterval, double &pStep)
+{
+    // Retrieve the settings to use to simulate the given model
+    // Note: the step is only used by our fixed-step ODE solvers, so it must be
+    //       small enough for them to remain stable...
+
+    QString modelName = QFileInfo(pFileName).baseName();
+
+    if (!modelName.compare("hodgkin_huxley_squid_axon_model_1952")) {
+        pEndingPoint   = 1000.0;
+        pPointInterval = 0.1;
+        pStep          = 0.01;
+    } else if (!modelName.compare("van_der_pol_model_1928")) {
+        pEndingPoint   = 1000.0;
+        pPointInterval = 0.1;
+        pStep          = 0.001;
+    } else {
+        pEndingPoint   = 100.0;
+        pPointInterval = 0.1;
+        pStep          = 0.01;
+    }
+}
+
+//==============================================================================
+
+void Benchmark::sampleMemory()
+{
+    // Keep track of the peak amount of memory we have used so far
+
+    mPeakMemory = qMax(mPeakMemory, currentMemory());
+}
+
+//==============================================================================
+
+void Benchmark::initTestCase()
+{
+    // Load our solver plugins and keep track of their solver interface
+
+    static const QStringList SolverPlugins = QStringList() << "CVODESolver"
+                                                           << "ForwardEulerSolver"
+                                                           << "FourthOrderRungeKuttaSolver"
+                                                           << "HeunSolver"
+                                                           << "IDASolver"
+                                                           << "KINSOLSolver"
+                                                           << "MidpointSolver"
+                                                           << "SecondOrderRungeKuttaSolver";
+
+    foreach (const QString &solverPlugin, SolverPlugins) {
+        OpenCOR::loadPlugin(solverPlugin);
+
+        QPluginLoader pluginLoader(OpenCOR::PluginPrefix+solverPlugin+OpenCOR::PluginExtension);
+        OpenCOR::SolverInterface *solverInterface = qobject_cast<OpenCOR::SolverInterface *>(pluginLoader.instance());
+
+        QVERIFY2(solverInterface,
+                 qPrintable(QString("the %1 plugin doesn't provide a solver").arg(solverPlugin)));
+
+        mSolverInterfaces << solverInterface;
+    }
+
+    // Make sure that we always run our simulations, i.e. that their results
+    // don't get retrieved from our cache, and that we don't spend time saving
+    // checkpoints
+    // Note: our cache is specific to the application, i.e. to us, so disabling
+    //       it doesn't affect OpenCOR's cache...
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsCache::instance()->setMaximumSize(0);
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationCheckpoint::setInterval(0);
+
+    // Our bundled models (relative to our build directory, from which we are
+    // to be run; see runbenchmarks[.bat])
+
+    mFileNames << "../models/hodgkin_huxley_squid_axon_model_1952.cellml"
+               << "../models/van_der_pol_model_1928.cellml"
+               << "../models/test/dae_model.cellml";
+
+    // Our synthetic models, i.e. two chains of states of different sizes, and
+    // a model whose states are spread over several components and involve
+    // some algebraic loops, piecewise expressions and imports
+
+    QVERIFY(mSyntheticModelsDir.isValid());
+
+    OpenCOR::CellmlModelGenerator generator;
+
+    foreach (const int &statesCount, QList<int>() << 100 << 1000) {
+        QString fileName = mSyntheticModelsDir.path()+QString("/synthetic_model_%1.cellml").arg(statesCount);
+
+        generator.setStatesCount(statesCount);
+
+        QVERIFY2(generator.generate(fileName),
+                 qPrintable(generator.errorMessage()));
+
+        mFileNames << fileName;
+    }
+
+    QString featuresFileName = mSyntheticModelsDir.path()+"/synthetic_model_100_features.cellml";
+
+    generator.setCellmlVersion(OpenCOR::CellmlModelGenerator::Cellml_1_1);
+    generator.setComponentsCount(10);
+    generator.setStatesCount(100);
+    generator.setAlgebraicLoopsCount(10);
+    generator.setPiecewiseExpressionsCount(10);
+    generator.setImportsCount(5);
+    generator.setCouplingDensity(0.05);
+
+    QVERIFY2(generator.generate(featuresFileName),
+             qPrintable(generator.errorMessage()));
+
+    mFileNames << featuresFileName;
+
+    // Load and compile our models, keeping track of how long it takes to
+    // generate and compile their code
+
+    foreach (const QString &fileName, mFileNames) {
+        OpenCOR::CellMLSupport::CellmlFile *cellmlFile = new OpenCOR::CellMLSupport::CellmlFile(fileName);
+        QElapsedTimer timer;
+
+        timer.start();
+
+        OpenCOR::CellMLSupport::CellmlFileRuntime *runtime = cellmlFile->runtime();
+
+        mCompileTimes.insert(fileName, 0.000001*timer.nsecsElapsed());
+        mCellmlFiles.insert(fileName, cellmlFile);
+
+        QVERIFY2(runtime && runtime->isValid(),
+                 qPrintable(QString("%1 could not be compiled").arg(fileName)));
+    }
+}
+
+//==============================================================================
+
+void Benchmark::cleanupTestCase()
+{
+    // Save our report
+
+    QJsonObject report = QJsonObject();
+
+    report.insert("date", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    report.insert("results", mResults);
+
+    QFile file(ReportFileName);
+
+    QVERIFY(file.open(QIODevice::WriteOnly));
+
+    file.write(QJsonDocument(report).toJson());
+    file.close();
+
+    // Delete our models
+
+    qDeleteAll(mCellmlFiles);
+}
+
+//==============================================================================
+
+void Benchmark::simulationBenchmarks_data()
+{
+    // Benchmark each of our models against each of the solvers that can solve
+    // it
+
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QString>("solverName");
+
+    foreach (const QString &fileName, mFileNames) {
+        OpenCOR::CellMLSupport::CellmlFileRuntime *runtime = mCellmlFiles.value(fileName)->runtime();
+        OpenCOR::Solver::Type solverType = runtime->needOdeSolver()?OpenCOR::Solver::Ode:OpenCOR::Solver::Dae;
+
+        foreach (OpenCOR::SolverInterface *solverInterface, mSolverInterfaces)
+            if (solverInterface->type() == solverType)
+                QTest::newRow(qPrintable(QFileInfo(fileName).baseName()+"/"+solverInterface->name()))
+                        << fileName << solverInterface->name();
+    }
+}
+
+//==============================================================================
+
+void Benchmark::runSimulation(const QString &pFileName,
+                              const QString &pSolverName,
+                              const bool &pModelTiming, int &pElapsedTime,
+                              OpenCOR::CoreSolver::Statistics &pStatistics)
+{
+    // Run our simulation, with or without having our solvers time the
+    // evaluations of our model
+    // Note: our solvers check whether they should time our model when they get
+    //       created, i.e. when our simulation is run...
+
+    enum {
+        MaximumDuration = 600000,
+        MemorySamplingInterval = 10
+    };
+
+    OpenCOR::CoreSolver::CoreSolver::setModelTiming(pModelTiming);
+
+    // Keep track of the memory we use before creating our simulation and
+    // sample it while our simulation runs, so that we can report the peak
+    // amount of memory used by our simulation itself
+    // Note: our process's high-water mark cannot be used for this, since it
+    //       would be that of the most memory-hungry simulation run so far...
+
+    mBaselineMemory = mPeakMemory = currentMemory();
+
+    QTimer memoryTimer;
+
+    connect(&memoryTimer, SIGNAL(timeout()),
+            this, SLOT(sampleMemory()));
+
+    memoryTimer.start(MemorySamplingInterval);
+
+    OpenCOR::CellMLSupport::CellmlFileRuntime *runtime = mCellmlFiles.value(pFileName)->runtime();
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulation simulation(pFileName, runtime, mSolverInterfaces);
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationData *simulationData = simulation.data();
+
+    double endingPoint;
+    double pointInterval;
+    double step;
+
+    simulationSettings(pFileName, endingPoint, pointInterval, step);
+
+    simulationData->setStartingPoint(0.0, false);
+    simulationData->setEndingPoint(endingPoint);
+    simulationData->setPointInterval(pointInterval);
+
+    // Set our solvers, using their default properties, except for the step of
+    // our fixed-step ODE solvers
+
+    foreach (OpenCOR::SolverInterface *solverInterface, mSolverInterfaces) {
+        if (!solverInterface->name().compare(pSolverName)) {
+            if (solverInterface->type() == OpenCOR::Solver::Ode)
+                simulationData->setOdeSolverName(pSolverName);
+            else
+                simulationData->setDaeSolverName(pSolverName);
+
+            foreach (const OpenCOR::Solver::Property &property, solverInterface->properties()) {
+                QVariant value = property.name().compare("Step")?property.defaultValue():step;
+
+                if (solverInterface->type() == OpenCOR::Solver::Ode)
+                    simulationData->addOdeSolverProperty(property.name(), value);
+                else
+                    simulationData->addDaeSolverProperty(property.name(), value);
+            }
+        } else if (   runtime->needNlaSolver()
+                   && (solverInterface->type() == OpenCOR::Solver::Nla)) {
+            simulationData->setNlaSolverName(solverInterface->name(), false);
+
+            foreach (const OpenCOR::Solver::Property &property, solverInterface->properties())
+                simulationData->addNlaSolverProperty(property.name(), property.defaultValue(), false);
+        }
+    }
+
+    simulationData->reset();
+
+    QVERIFY(simulation.results()->reset());
+
+    QSignalSpy stoppedSpy(&simulation, SIGNAL(stopped(const int &)));
+    QSignalSpy errorSpy(&simulation, SIGNAL(error(const QString &)));
+
+    simulation.run();
+
+    QVERIFY2(stoppedSpy.count() || stoppedSpy.wait(MaximumDuration),
+             "the simulation didn't complete in time");
+    QVERIFY2(errorSpy.isEmpty(),
+             qPrintable(errorSpy.isEmpty()?QString():errorSpy.first().first().toString()));
+
+    memoryTimer.stop();
+
+    sampleMemory();
+
+    pElapsedTime = stoppedSpy.first().first().toInt();
+    pStatistics = simulation.statistics().value(pSolverName).toMap();
+
+    QVERIFY(pElapsedTime != -1);
+}
+
+//==============================================================================
+
+void Benchmark::simulationBenchmarks()
+{
+    // Run our simulation a first time without timing the evaluations of our
+    // model, since timing them would slow down our solver and therefore skew
+    // our rates
+
+    QFETCH(QString, fileName);
+    QFETCH(QString, solverName);
+
+    int elapsedTime;
+    OpenCOR::CoreSolver::Statistics statistics;
+
+    runSimulation(fileName, solverName, false, elapsedTime, statistics);
+
+    if (QTest::currentTestFailed())
+        return;
+
+    qulonglong peakMemory = mPeakMemory-mBaselineMemory;
+
+    // Run our simulation a second time, this time timing the evaluations of
+    // our model, so that we can report the time spent in it
+
+    int timedElapsedTime;
+    OpenCOR::CoreSolver::Statistics timedStatistics;
+
+    runSimulation(fileName, solverName, true, timedElapsedTime, timedStatistics);
+
+    if (QTest::currentTestFailed())
+        return;
+
+    // Report on our simulation
+    // Note: our rates are relative to the time spent in our solver, so that
+    //       they don't depend on how quickly our results can be stored...
+
+    qulonglong steps = statistics.value(OpenCOR::CoreSolver::StepsStatistic).toULongLong();
+    qulonglong functionEvaluations = statistics.value(OpenCOR::CoreSolver::FunctionEvaluationsStatistic).toULongLong();
+    double solverTime = statistics.value(OpenCOR::CoreSolver::SolverTimeStatistic).toDouble();
+    double modelTime = timedStatistics.value(OpenCOR::CoreSolver::ModelTimeStatistic).toDouble();
+    double oneOverSolverTime = solverTime?1000.0/solverTime:0.0;
+
+    QJsonObject result = QJsonObject();
+
+    result.insert("model", QFileInfo(fileName).baseName());
+    result.insert("solver", solverName);
+    result.insert("statesCount", mCellmlFiles.value(fileName)->runtime()->statesCount());
+    result.insert("compileTime", mCompileTimes.value(fileName));
+    result.insert("elapsedTime", elapsedTime);
+    result.insert("solverTime", solverTime);
+    result.insert("modelTime", modelTime);
+    result.insert("steps", double(steps));
+    result.insert("functionEvaluations", double(functionEvaluations));
+    result.insert("stepsPerSecond", oneOverSolverTime*steps);
+    result.insert("functionEvaluationsPerSecond", oneOverSolverTime*functionEvaluations);
+    result.insert("peakMemory", double(peakMemory));
+
+    mResults.append(result);
+}
+
+//==============================================================================
+
+QTEST_GUILESS_MAIN(Benchmark)
+
+//==============================================================================
+// End of file
+//==============================================================================
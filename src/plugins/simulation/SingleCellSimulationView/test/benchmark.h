@@ -0,0 +1,77 @@
+//==============================================================================
+// Single cell simulation view benchmark
+//==============================================================================
+
+#include "coresolver.h"
+#include "solverinterface.h"
+
+//==============================================================================
+
+#ifdef Q_OS_MAC
+    #pragma GCC diagnostic ignored "-Wunused-private-field"
+#endif
+
+#include <QtTest/QtTest>
+
+#ifdef Q_OS_MAC
+    #pragma GCC diagnostic warning "-Wunused-private-field"
+#endif
+
+//==============================================================================
+
+#include <QJsonArray>
+#include <QMap>
+#include <QTemporaryDir>
+
+//==============================================================================
+
+namespace OpenCOR {
+
+//==============================================================================
+
+namespace CellMLSupport {
+    class CellmlFile;
+}   // namespace CellMLSupport
+
+//==============================================================================
+
+}   // namespace OpenCOR
+
+//==============================================================================
+
+class Benchmark : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir mSyntheticModelsDir;
+
+    QStringList mFileNames;
+    QMap<QString, OpenCOR::CellMLSupport::CellmlFile *> mCellmlFiles;
+    QMap<QString, double> mCompileTimes;
+
+    OpenCOR::SolverInterfaces mSolverInterfaces;
+
+    QJsonArray mResults;
+
+    qulonglong mBaselineMemory;
+    qulonglong mPeakMemory;
+
+    void runSimulation(const QString &pFileName, const QString &pSolverName,
+                       const bool &pModelTiming, int &pElapsedTime,
+                       OpenCOR::CoreSolver::Statistics &pStatistics);
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void simulationBenchmarks_data();
+    void simulationBenchmarks();
+
+protected Q_SLOTS:
+    void sampleMemory();
+};
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,701 @@
+//==============================================================================
+// Single cell simulation view test
+//==============================================================================
+
+#include "cellmlfile.h"
+#include "cellmlfileruntime.h"
+#include "plugin.h"
+#include "singlecellsimulationviewcsvexporter.h"
+#include "singlecellsimulationviewsimulation.h"
+#include "singlecellsimulationviewsimulationcheckpoint.h"
+#include "singlecellsimulationviewsimulationresultscache.h"
+#include "singlecellsimulationviewsimulationresultsfile.h"
+#include "singlecellsimulationviewtimeseriescodec.h"
+#include "test.h"
+
+//==============================================================================
+
+#include "../../../../../test/cellmlmodelgenerator.h"
+#include "../../../../../test/testutils.h"
+
+//==============================================================================
+
+#include <QBuffer>
+#include <QFile>
+#include <QPluginLoader>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QTextStream>
+
+//==============================================================================
+
+#include <qmath.h>
+#include <qnumeric.h>
+
+//==============================================================================
+
+void Test::initTestCase()
+{
+    // Load our CVODE solver plugin and keep track of its solver interface
+
+    OpenCOR::loadPlugin("CVODESolver");
+
+    QPluginLoader pluginLoader(OpenCOR::PluginPrefix+"CVODESolver"+OpenCOR::PluginExtension);
+    OpenCOR::SolverInterface *solverInterface = qobject_cast<OpenCOR::SolverInterface *>(pluginLoader.instance());
+
+    QVERIFY(solverInterface);
+
+    mSolverInterfaces << solverInterface;
+
+    // Make sure that we always run our simulations, i.e. that their results
+    // don't get retrieved from our cache, and that we don't save checkpoints
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsCache::instance()->setMaximumSize(0);
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationCheckpoint::setInterval(0);
+}
+
+//==============================================================================
+
+static QVector<double> values()
+{
+    // Return a set of values that covers special values, values around the
+    // boundaries of the 'g' notation, values that need rounding, as well as
+    // (reproducible) random values over a wide range of magnitudes
+
+    QVector<double> res = QVector<double>();
+
+    res << 0.0 << -0.0 << 1.0 << -1.0 << 0.5 << 0.1 << 0.2 << 0.3
+        << 123456.0 << 1234567.0 << 999999.0 << 999999.5 << 9999995.0
+        << 0.0001 << 0.00001 << 0.000123456789 << 1.0e-300 << 1.0e300
+        << 9.9999995e-5 << 3.14159265358979 << -2.718281828459045
+        << qInf() << -qInf() << qQNaN()
+        << 4.9406564584124654e-324 << 2.2250738585072014e-308
+        << 1.7976931348623157e308;
+
+    for (int i = -320; i <= 308; ++i)
+        res << qPow(10.0, i) << -qPow(10.0, i) << 1.5*qPow(10.0, i);
+
+    qsrand(20131019);
+
+    for (int i = 0; i < 100000; ++i) {
+        double mantissa = double(qrand())/RAND_MAX;
+
+        res << ((qrand() % 2)?-1.0:1.0)*mantissa*qPow(10.0, (qrand() % 40)-20);
+    }
+
+    return res;
+}
+
+//==============================================================================
+
+void Test::csvValueFormattingTests()
+{
+    // Check that our CSV value formatter gives the same result as QTextStream
+
+    char buffer[OpenCOR::SingleCellSimulationView::SingleCellSimulationViewCsvExporter::MaximumValueSize];
+
+    foreach (const double &value, values()) {
+        QString expected = QString();
+        QTextStream out(&expected);
+
+        out << value;
+        out.flush();
+
+        int size = OpenCOR::SingleCellSimulationView::SingleCellSimulationViewCsvExporter::formatValue(value, buffer);
+
+        QCOMPARE(QString::fromLatin1(buffer, size), expected);
+    }
+}
+
+//==============================================================================
+
+void Test::csvExportTests()
+{
+    // Check that our CSV exporter gives exactly the same output as our
+    // original QTextStream-based exporter, using more rows than can be
+    // formatted by all of our threads in one go
+
+    static const int ColumnsCount = 7;
+    static const qulonglong Size = 12345*qMax(1, QThread::idealThreadCount());
+
+    QVector<double> data = values();
+    QVector<QVector<double> > columnsData = QVector<QVector<double> >(ColumnsCount);
+    QVector<const double *> columns = QVector<const double *>();
+
+    for (int i = 0; i < ColumnsCount; ++i) {
+        columnsData[i].resize(Size);
+
+        for (qulonglong j = 0; j < Size; ++j)
+            columnsData[i][j] = data[(i*Size+j) % data.count()];
+
+        columns << columnsData[i].constData();
+    }
+
+    QString header = "environment | time (ms),membrane | V (mV),membrane | V' (mV/ms)";
+
+    // Export our data using QTextStream
+
+    QByteArray expected = QByteArray();
+    QBuffer expectedBuffer(&expected);
+
+    expectedBuffer.open(QIODevice::WriteOnly);
+
+    QTextStream out(&expectedBuffer);
+
+    out << header << "\n";
+
+    for (qulonglong j = 0; j < Size; ++j) {
+        out << columns[0][j];
+
+        for (int i = 1; i < ColumnsCount; ++i)
+            out << "," << columns[i][j];
+
+        out << "\n";
+    }
+
+    out.flush();
+
+    expectedBuffer.close();
+
+    // Export our data using our CSV exporter
+
+    QByteArray actual = QByteArray();
+    QBuffer actualBuffer(&actual);
+
+    actualBuffer.open(QIODevice::WriteOnly);
+
+    QVERIFY(OpenCOR::SingleCellSimulationView::SingleCellSimulationViewCsvExporter(header, columns, Size).exportTo(&actualBuffer));
+
+    actualBuffer.close();
+
+    QCOMPARE(actual, expected);
+}
+
+//==============================================================================
+
+void Test::timeSeriesCodecTests()
+{
+    // Check that our time series codec is lossless, be it for equally spaced
+    // points, smooth values, constant values or noisy values (which should
+    // then be stored as is)
+
+    static const qulonglong Size = 100000;
+
+    QVector<double> points = QVector<double>(Size);
+    QVector<double> smoothValues = QVector<double>(Size);
+    QVector<double> constantValues = QVector<double>(Size, -83.853);
+    QVector<double> noisyValues = values();
+
+    for (qulonglong i = 0; i < Size; ++i) {
+        points[i] = 0.01*i;
+        smoothValues[i] = -80.0+40.0*qSin(0.001*i)*qExp(-1.0e-5*i);
+    }
+
+    QVector<double> uncompressedPoints = QVector<double>(Size);
+
+    QVERIFY(OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::uncompressPoints(OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::compressPoints(points.constData(), Size),
+                                                                                                         uncompressedPoints.data(), Size));
+    QVERIFY(!memcmp(uncompressedPoints.constData(), points.constData(), Size*sizeof(double)));
+
+    foreach (const QVector<double> &data,
+             QList<QVector<double> >() << points << smoothValues << constantValues << noisyValues) {
+        QVector<double> uncompressedData = QVector<double>(data.count());
+        QByteArray compressedData = OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::compressValues(data.constData(), data.count());
+
+        QVERIFY(qulonglong(compressedData.size()) <= data.count()*sizeof(double)+1);
+
+        QVERIFY(OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::uncompressValues(compressedData, uncompressedData.data(), data.count()));
+        QVERIFY(!memcmp(uncompressedData.constData(), data.constData(), data.count()*sizeof(double)));
+
+        // Make sure that truncated data or data for fewer values than we
+        // expect get rejected
+
+        QVERIFY(!OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::uncompressValues(compressedData.left(compressedData.size()/2), uncompressedData.data(), data.count()));
+        QVERIFY(!OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::uncompressValues(OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::compressValues(data.constData(), data.count()/2), uncompressedData.data(), data.count()));
+    }
+
+    QVERIFY(!OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::uncompressValues(QByteArray(), uncompressedPoints.data(), Size));
+}
+
+//==============================================================================
+
+void Test::resultsFileTests()
+{
+    // Check that a results file can be read back, i.e. its header, the
+    // metadata of its columns and its data, using more points than fit in one
+    // chunk and adding them both in bulk and one at a time
+
+    static const int ColumnsCount = 3;
+    static const qulonglong BulkSize = 10000;
+    static const qulonglong Size = BulkSize+7;
+
+    QVector<QVector<double> > columnsData = QVector<QVector<double> >(ColumnsCount);
+    QVector<double *> columns = QVector<double *>();
+
+    for (int i = 0; i < ColumnsCount; ++i) {
+        columnsData[i].resize(Size);
+
+        for (qulonglong j = 0; j < Size; ++j)
+            columnsData[i][j] = (i+1)*qSin(0.001*j)+j;
+
+        columns << columnsData[i].data();
+    }
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsFileColumns fileColumns = OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsFileColumns();
+
+    fileColumns << OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsFileColumn(0, 0, 0, "environment", "time", "millisecond")
+                << OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsFileColumn(1, 3, 1, "membrane", "V", "millivolt")
+                << OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsFileColumn(OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsFileColumn::Sensitivity, -1, 2, QString::fromUtf8("m\xc3\xa9mbrane"), "dV/dg_Na", "");
+
+    QTemporaryDir temporaryDir;
+    QString fileName = temporaryDir.path()+"/results.ocbr";
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsFile file(fileName);
+
+    QVERIFY(file.open(fileColumns));
+
+    file.addPoints(columns.data(), 0, BulkSize);
+
+    for (qulonglong j = BulkSize; j < Size; ++j) {
+        double point[ColumnsCount];
+
+        for (int i = 0; i < ColumnsCount; ++i)
+            point[i] = columnsData[i][j];
+
+        file.addPoint(point);
+    }
+
+    QVERIFY(file.close());
+
+    // Read our results file back
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsFileReader reader(fileName);
+
+    QVERIFY(reader.open());
+    QCOMPARE(reader.columns().count(), ColumnsCount);
+    QCOMPARE(reader.pointsCount(), Size);
+
+    for (int i = 0; i < ColumnsCount; ++i) {
+        OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResultsFileColumn column = reader.columns()[i];
+        QVector<double> values = QVector<double>();
+
+        QCOMPARE(column.type, fileColumns[i].type);
+        QCOMPARE(column.index, fileColumns[i].index);
+        QCOMPARE(column.degree, fileColumns[i].degree);
+        QCOMPARE(column.component, fileColumns[i].component);
+        QCOMPARE(column.name, fileColumns[i].name);
+        QCOMPARE(column.unit, fileColumns[i].unit);
+
+        QVERIFY(reader.values(i, values));
+        QCOMPARE(values, columnsData[i]);
+    }
+
+    QVERIFY(!reader.values(ColumnsCount, columnsData[0]));
+
+    reader.close();
+
+    // Make sure that a truncated results file gets rejected
+
+    QFile truncatedFile(fileName);
+
+    QVERIFY(truncatedFile.open(QIODevice::ReadWrite));
+    QVERIFY(truncatedFile.resize(truncatedFile.size()-1));
+
+    truncatedFile.close();
+
+    QVERIFY(!reader.open());
+}
+
+//==============================================================================
+
+static void checkSyntheticModel(const QString &pFileName,
+                                OpenCOR::CellmlModelGenerator &pGenerator)
+{
+    // Generate a synthetic model using the given generator and check that it
+    // is a valid model, which runtime has the expected number of states and
+    // needs an NLA solver only if the model involves some algebraic loops
+
+    QVERIFY2(pGenerator.generate(pFileName),
+             qPrintable(pGenerator.errorMessage()));
+
+    OpenCOR::CellMLSupport::CellmlFile cellmlFile(pFileName);
+
+    QVERIFY(cellmlFile.isValid());
+
+    OpenCOR::CellMLSupport::CellmlFileRuntime *runtime = cellmlFile.runtime();
+
+    QVERIFY(runtime && runtime->isValid());
+    QCOMPARE(runtime->modelType(), OpenCOR::CellMLSupport::CellmlFileRuntime::Ode);
+    QCOMPARE(runtime->statesCount(), pGenerator.statesCount());
+    QCOMPARE(runtime->needNlaSolver(), pGenerator.algebraicLoopsCount() != 0);
+}
+
+//==============================================================================
+
+void Test::syntheticModelTests()
+{
+    // Check that our synthetic model generator rejects settings that don't
+    // make sense
+
+    QTemporaryDir dir;
+
+    QVERIFY(dir.isValid());
+
+    OpenCOR::CellmlModelGenerator generator;
+
+    generator.setComponentsCount(101);
+
+    QVERIFY(!generator.generate(dir.path()+"/invalid.cellml"));
+    QVERIFY(!generator.errorMessage().isEmpty());
+
+    generator.setComponentsCount(1);
+    generator.setImportsCount(1);
+
+    QVERIFY(!generator.generate(dir.path()+"/invalid.cellml"));
+    QVERIFY(!QFile::exists(dir.path()+"/invalid.cellml"));
+
+    // Check that our generator generates valid models, be it for a single
+    // state, a chain of states, or states that are spread over several
+    // components and that involve algebraic loops, piecewise expressions,
+    // imports and/or some dense coupling
+
+    generator.setImportsCount(0);
+    generator.setStatesCount(1);
+
+    checkSyntheticModel(dir.path()+"/single_state.cellml", generator);
+
+    generator.setStatesCount(100);
+
+    checkSyntheticModel(dir.path()+"/chain.cellml", generator);
+
+    generator.setComponentsCount(5);
+    generator.setPiecewiseExpressionsCount(50);
+    generator.setCouplingDensity(0.2);
+
+    checkSyntheticModel(dir.path()+"/piecewise.cellml", generator);
+
+    generator.setPiecewiseExpressionsCount(0);
+    generator.setAlgebraicLoopsCount(10);
+
+    checkSyntheticModel(dir.path()+"/loops.cellml", generator);
+
+    generator.setCellmlVersion(OpenCOR::CellmlModelGenerator::Cellml_1_1);
+    generator.setComponentsCount(10);
+    generator.setStatesCount(10);
+    generator.setAlgebraicLoopsCount(10);
+    generator.setPiecewiseExpressionsCount(10);
+    generator.setImportsCount(10);
+    generator.setCouplingDensity(1.0);
+
+    checkSyntheticModel(dir.path()+"/everything.cellml", generator);
+
+    // Check that a given seed always results in the same model, and that
+    // different seeds result in different models
+
+    generator.setCellmlVersion(OpenCOR::CellmlModelGenerator::Cellml_1_0);
+    generator.setComponentsCount(1);
+    generator.setStatesCount(100);
+    generator.setAlgebraicLoopsCount(0);
+    generator.setPiecewiseExpressionsCount(0);
+    generator.setImportsCount(0);
+    generator.setCouplingDensity(0.1);
+
+    QString fileName = dir.path()+"/seed.cellml";
+    QList<QByteArray> contents = QList<QByteArray>();
+
+    foreach (const quint64 &seed, QList<quint64>() << 1 << 1 << 2) {
+        generator.setSeed(seed);
+
+        QVERIFY(generator.generate(fileName));
+
+        QFile file(fileName);
+
+        QVERIFY(file.open(QIODevice::ReadOnly));
+
+        contents << file.readAll();
+
+        file.close();
+    }
+
+    QVERIFY(contents[0] == contents[1]);
+    QVERIFY(contents[0] != contents[2]);
+}
+
+//==============================================================================
+
+static void runSimulation(OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulation &pSimulation,
+                          OpenCOR::CellMLSupport::CellmlFileRuntimeModelParameter *pConstant,
+                          const double &pValue)
+{
+    // Run the given simulation from 0 to 5 seconds using CVODE, with tight
+    // tolerances and the given value for the given constant
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationData *simulationData = pSimulation.data();
+
+    simulationData->setStartingPoint(0.0, false);
+    simulationData->setEndingPoint(5.0);
+    simulationData->setPointInterval(0.1);
+    simulationData->setOdeSolverName("CVODE");
+    simulationData->addOdeSolverProperty("Relative tolerance", 1.0e-10);
+    simulationData->addOdeSolverProperty("Absolute tolerance", 1.0e-10);
+
+    simulationData->reset();
+
+    simulationData->constants()[pConstant->index()] = pValue;
+
+    simulationData->recomputeComputedConstantsAndVariables();
+
+    QVERIFY(pSimulation.results()->reset());
+
+    QSignalSpy stoppedSpy(&pSimulation, SIGNAL(stopped(const int &)));
+    QSignalSpy errorSpy(&pSimulation, SIGNAL(error(const QString &)));
+
+    pSimulation.run();
+
+    QVERIFY(stoppedSpy.count() || stoppedSpy.wait(60000));
+    QVERIFY2(errorSpy.isEmpty(),
+             qPrintable(errorSpy.isEmpty()?QString():errorSpy.first().first().toString()));
+    QVERIFY(pSimulation.results()->size());
+}
+
+//==============================================================================
+
+void Test::sensitivityTests()
+{
+    // Compute the sensitivity of the states of the van der Pol model with
+    // respect to epsilon and compare them, at the end of the simulation, with
+    // those we get using central finite differences
+
+    static const double Epsilon = 1.0;
+    static const double Delta = 1.0e-4;
+
+    OpenCOR::CellMLSupport::CellmlFile cellmlFile("../models/van_der_pol_model_1928.cellml");
+    OpenCOR::CellMLSupport::CellmlFileRuntime *runtime = cellmlFile.runtime();
+
+    QVERIFY(runtime && runtime->isValid());
+
+    OpenCOR::CellMLSupport::CellmlFileRuntimeModelParameter *epsilon = runtime->modelParameter("main", "epsilon");
+    OpenCOR::CellMLSupport::CellmlFileRuntimeModelParameter *x = runtime->modelParameter("main", "x");
+    OpenCOR::CellMLSupport::CellmlFileRuntimeModelParameter *y = runtime->modelParameter("main", "y");
+
+    QVERIFY(epsilon && x && y);
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulation simulation(cellmlFile.fileName(), runtime, mSolverInterfaces);
+
+    QVERIFY(simulation.data()->canComputeSensitivities());
+
+    simulation.data()->setSensitivityParameter(epsilon, true);
+
+    runSimulation(simulation, epsilon, Epsilon);
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResults *results = simulation.results();
+    qulonglong last = results->size()-1;
+
+    QVERIFY(results->sensitivities(x, epsilon) && results->sensitivities(y, epsilon));
+
+    double xSensitivity = results->sensitivities(x, epsilon)[last];
+    double ySensitivity = results->sensitivities(y, epsilon)[last];
+
+    // Our finite differences
+
+    simulation.data()->setSensitivityParameter(epsilon, false);
+
+    runSimulation(simulation, epsilon, Epsilon+Delta);
+
+    double xPlus = results->states()[x->index()][last];
+    double yPlus = results->states()[y->index()][last];
+
+    runSimulation(simulation, epsilon, Epsilon-Delta);
+
+    double xMinus = results->states()[x->index()][last];
+    double yMinus = results->states()[y->index()][last];
+
+    QVERIFY(!results->sensitivities());
+
+    double xFiniteDifference = (xPlus-xMinus)/(2.0*Delta);
+    double yFiniteDifference = (yPlus-yMinus)/(2.0*Delta);
+
+    QVERIFY(qAbs(xSensitivity-xFiniteDifference) <= 1.0e-3*qMax(1.0, qAbs(xFiniteDifference)));
+    QVERIFY(qAbs(ySensitivity-yFiniteDifference) <= 1.0e-3*qMax(1.0, qAbs(yFiniteDifference)));
+}
+
+//==============================================================================
+
+static void runHodgkinHuxleySimulation(OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulation &pSimulation)
+{
+    // Run the given Hodgkin-Huxley simulation from 0 to 50 milliseconds using
+    // CVODE, i.e. for a bit more than two action potentials
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationData *simulationData = pSimulation.data();
+
+    simulationData->setStartingPoint(0.0, false);
+    simulationData->setEndingPoint(50.0);
+    simulationData->setPointInterval(0.01);
+    simulationData->setOdeSolverName("CVODE");
+
+    simulationData->reset();
+
+    QVERIFY(pSimulation.results()->reset());
+
+    QSignalSpy stoppedSpy(&pSimulation, SIGNAL(stopped(const int &)));
+
+    pSimulation.run();
+
+    QVERIFY(stoppedSpy.count() || stoppedSpy.wait(60000));
+    QVERIFY(pSimulation.results()->size() > 1);
+}
+
+//==============================================================================
+
+void Test::csvModelExportTests()
+{
+    // Simulate the Hodgkin-Huxley model and check that its results get
+    // exported to a CSV file the way our original QTextStream-based exporter
+    // would have done it
+
+    OpenCOR::CellMLSupport::CellmlFile cellmlFile("../models/hodgkin_huxley_squid_axon_model_1952.cellml");
+    OpenCOR::CellMLSupport::CellmlFileRuntime *runtime = cellmlFile.runtime();
+
+    QVERIFY(runtime && runtime->isValid());
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulation simulation(cellmlFile.fileName(), runtime, mSolverInterfaces);
+
+    runHodgkinHuxleySimulation(simulation);
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResults *results = simulation.results();
+
+    // Export our results and generate what we would expect to get
+
+    QTemporaryDir dir;
+    QString fileName = dir.path()+"/hodgkin_huxley_squid_axon_model_1952.csv";
+
+    QVERIFY(results->exportToCsv(fileName));
+
+    QVector<const double *> columns = QVector<const double *>();
+
+    columns << results->points();
+
+    foreach (OpenCOR::CellMLSupport::CellmlFileRuntimeModelParameter *modelParameter, runtime->modelParameters()) {
+        switch (modelParameter->type()) {
+        case OpenCOR::CellMLSupport::CellmlFileRuntimeModelParameter::Constant:
+        case OpenCOR::CellMLSupport::CellmlFileRuntimeModelParameter::ComputedConstant:
+            columns << results->constants()[modelParameter->index()];
+
+            break;
+        case OpenCOR::CellMLSupport::CellmlFileRuntimeModelParameter::State:
+            columns << results->states()[modelParameter->index()];
+
+            break;
+        case OpenCOR::CellMLSupport::CellmlFileRuntimeModelParameter::Rate:
+            columns << results->rates()[modelParameter->index()];
+
+            break;
+        case OpenCOR::CellMLSupport::CellmlFileRuntimeModelParameter::Algebraic:
+            columns << results->algebraic()[modelParameter->index()];
+
+            break;
+        default:
+            // Either Voi or Undefined, so...
+
+            ;
+        }
+    }
+
+    QByteArray expected = QByteArray();
+    QBuffer expectedBuffer(&expected);
+
+    expectedBuffer.open(QIODevice::WriteOnly | QIODevice::Text);
+
+    QTextStream out(&expectedBuffer);
+
+    for (qulonglong j = 0, jMax = results->size(); j < jMax; ++j) {
+        out << columns[0][j];
+
+        for (int i = 1, iMax = columns.count(); i < iMax; ++i)
+            out << "," << columns[i][j];
+
+        out << "\n";
+    }
+
+    out.flush();
+
+    expectedBuffer.close();
+
+    // Compare our exported data with what we expected, after having checked
+    // that our header has as many fields as we have columns
+
+    QFile file(fileName);
+
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+
+    QByteArray header = file.readLine();
+
+    QCOMPARE(header.count(',')+1, columns.count());
+    QCOMPARE(file.readAll(), expected);
+
+    file.close();
+}
+
+//==============================================================================
+
+void Test::timeSeriesCodecRatioTests()
+{
+    // Simulate the Hodgkin-Huxley model and check that its results get
+    // compressed losslessly and well, be it overall (by a third at least) or
+    // for its points (which are equally spaced) and constants (which should
+    // need about one bit per value)
+
+    OpenCOR::CellMLSupport::CellmlFile cellmlFile("../models/hodgkin_huxley_squid_axon_model_1952.cellml");
+    OpenCOR::CellMLSupport::CellmlFileRuntime *runtime = cellmlFile.runtime();
+
+    QVERIFY(runtime && runtime->isValid());
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulation simulation(cellmlFile.fileName(), runtime, mSolverInterfaces);
+
+    runHodgkinHuxleySimulation(simulation);
+
+    OpenCOR::SingleCellSimulationView::SingleCellSimulationViewSimulationResults *results = simulation.results();
+    qulonglong size = results->size();
+    qulonglong rawSize = size*sizeof(double);
+
+    QByteArray compressedPoints = OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::compressPoints(results->points(), size);
+
+    QVERIFY(4*qulonglong(compressedPoints.size()) < rawSize);
+
+    qulonglong totalRawSize = rawSize;
+    qulonglong totalCompressedSize = compressedPoints.size();
+
+    QList<QPair<double **, int> > arrays = QList<QPair<double **, int> >();
+
+    arrays << qMakePair(results->constants(), runtime->constantsCount())
+           << qMakePair(results->states(), runtime->statesCount())
+           << qMakePair(results->rates(), runtime->ratesCount())
+           << qMakePair(results->algebraic(), runtime->algebraicCount());
+
+    for (int i = 0, iMax = arrays.count(); i < iMax; ++i)
+        for (int j = 0; j < arrays[i].second; ++j) {
+            QByteArray compressedValues = OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::compressValues(arrays[i].first[j], size);
+            QVector<double> uncompressedValues = QVector<double>(size);
+
+            QVERIFY(OpenCOR::SingleCellSimulationView::SingleCellSimulationViewTimeSeriesCodec::uncompressValues(compressedValues, uncompressedValues.data(), size));
+            QVERIFY(!memcmp(uncompressedValues.constData(), arrays[i].first[j], rawSize));
+
+            if (!i)
+                QVERIFY(32*qulonglong(compressedValues.size()) < rawSize);
+
+            totalRawSize += rawSize;
+            totalCompressedSize += compressedValues.size();
+        }
+
+    QVERIFY2(3*totalCompressedSize < 2*totalRawSize,
+             qPrintable(QString("compression ratio of %1").arg(double(totalRawSize)/totalCompressedSize)));
+}
+
+//==============================================================================
+
+QTEST_MAIN(Test)
+
+//==============================================================================
+// End of file
+//==============================================================================
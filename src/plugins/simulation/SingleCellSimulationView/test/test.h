@@ -0,0 +1,51 @@
+//==============================================================================
+// Single cell simulation view test
+//==============================================================================
+
+#include "solverinterface.h"
+
+//==============================================================================
+
+#include <QtGlobal>
+
+//==============================================================================
+
+#ifdef Q_OS_MAC
+    #pragma GCC diagnostic ignored "-Wunused-private-field"
+#endif
+
+#include <QtTest/QtTest>
+
+#ifdef Q_OS_MAC
+    #pragma GCC diagnostic warning "-Wunused-private-field"
+#endif
+
+//==============================================================================
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    OpenCOR::SolverInterfaces mSolverInterfaces;
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void csvValueFormattingTests();
+    void csvExportTests();
+    void csvModelExportTests();
+
+    void timeSeriesCodecTests();
+    void timeSeriesCodecRatioTests();
+
+    void resultsFileTests();
+
+    void syntheticModelTests();
+
+    void sensitivityTests();
+};
+
+//==============================================================================
+// End of file
+//==============================================================================
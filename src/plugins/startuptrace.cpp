@@ -0,0 +1,275 @@
+//==============================================================================
+// Startup trace
+//==============================================================================
+
+#include "startuptrace.h"
+
+//==============================================================================
+
+#include <iostream>
+
+//==============================================================================
+
+#include <QFile>
+#include <QTextStream>
+
+//==============================================================================
+
+namespace OpenCOR {
+
+//==============================================================================
+
+StartupTraceSpan::StartupTraceSpan(const QString &pName,
+                                   const QString &pCategory,
+                                   const qint64 &pStart, const int &pDepth) :
+    mName(pName),
+    mCategory(pCategory),
+    mStart(pStart),
+    mDuration(0),
+    mDepth(pDepth)
+{
+}
+
+//==============================================================================
+
+QString StartupTraceSpan::name() const
+{
+    // Return our name
+
+    return mName;
+}
+
+//==============================================================================
+
+QString StartupTraceSpan::category() const
+{
+    // Return our category
+
+    return mCategory;
+}
+
+//==============================================================================
+
+qint64 StartupTraceSpan::start() const
+{
+    // Return our start, in microseconds
+
+    return mStart;
+}
+
+//==============================================================================
+
+qint64 StartupTraceSpan::duration() const
+{
+    // Return our duration, in microseconds
+
+    return mDuration;
+}
+
+//==============================================================================
+
+void StartupTraceSpan::setDuration(const qint64 &pDuration)
+{
+    // Set our duration
+
+    mDuration = pDuration;
+}
+
+//==============================================================================
+
+int StartupTraceSpan::depth() const
+{
+    // Return our depth, i.e. the number of spans within which we are nested
+
+    return mDepth;
+}
+
+//==============================================================================
+
+StartupTrace::StartupTrace() :
+    mEnabled(false),
+    mFileName(QString()),
+    mSpans(QList<StartupTraceSpan>()),
+    mOpenSpans(QList<int>())
+{
+}
+
+//==============================================================================
+
+StartupTrace * StartupTrace::instance()
+{
+    // Return the 'global' instance of our startup trace class
+
+    static StartupTrace instance;
+
+    return &instance;
+}
+
+//==============================================================================
+
+QStringList StartupTrace::enable(const QStringList &pArguments)
+{
+    // Enable ourselves, if the startup trace option is amongst the given
+    // arguments, and return the arguments without it
+    // Note: the option may come with the name of a file to which the trace is
+    //       to be exported as a Chrome trace (i.e. --startup-trace=<file>), in
+    //       which case it is also printed to the console...
+
+    static const QString Option = "--"+StartupTraceOption;
+
+    QStringList res = QStringList();
+
+    foreach (const QString &argument, pArguments)
+        if (!argument.compare(Option)) {
+            mEnabled = true;
+        } else if (argument.startsWith(Option+"=")) {
+            mEnabled = true;
+            mFileName = argument.mid(Option.length()+1);
+        } else {
+            res << argument;
+        }
+
+    if (mEnabled)
+        mTimer.start();
+
+    return res;
+}
+
+//==============================================================================
+
+bool StartupTrace::isEnabled() const
+{
+    // Return whether we are enabled
+
+    return mEnabled;
+}
+
+//==============================================================================
+
+qint64 StartupTrace::elapsed() const
+{
+    // Return the time elapsed since we were enabled, in microseconds
+
+    return mTimer.nsecsElapsed()/1000;
+}
+
+//==============================================================================
+
+void StartupTrace::begin(const QString &pName, const QString &pCategory)
+{
+    // Start a new span, nested within the currently open one, if any
+
+    if (!mEnabled)
+        return;
+
+    mOpenSpans << mSpans.count();
+    mSpans << StartupTraceSpan(pName, pCategory, elapsed(), mOpenSpans.count()-1);
+}
+
+//==============================================================================
+
+void StartupTrace::end()
+{
+    // End our currently open span, if any
+
+    if (!mEnabled || mOpenSpans.isEmpty())
+        return;
+
+    StartupTraceSpan &span = mSpans[mOpenSpans.takeLast()];
+
+    span.setDuration(elapsed()-span.start());
+}
+
+//==============================================================================
+
+void StartupTrace::finish()
+{
+    // End any span that is still open, print our trace to the console and
+    // export it, if needed, and disable ourselves
+
+    if (!mEnabled)
+        return;
+
+    while (!mOpenSpans.isEmpty())
+        end();
+
+    print();
+
+    if (!mFileName.isEmpty() && !exportToChromeTrace())
+        std::cout << "Error: the startup trace could not be exported to '"
+                  << qPrintable(mFileName) << "'." << std::endl;
+
+    mEnabled = false;
+}
+
+//==============================================================================
+
+void StartupTrace::print() const
+{
+    // Print our spans, indented according to their depth, with their start
+    // and duration in milliseconds
+
+    std::cout << "Startup trace (start and duration in ms):" << std::endl;
+
+    foreach (const StartupTraceSpan &span, mSpans)
+        std::cout << qPrintable(QString("%1 %2  %3%4").arg(QString::number(0.001*span.start(), 'f', 3), 10)
+                                                      .arg(QString::number(0.001*span.duration(), 'f', 3), 10)
+                                                      .arg(QString(2*span.depth(), ' '),
+                                                           span.name()))
+                  << std::endl;
+}
+
+//==============================================================================
+
+static QString jsonString(const QString &pString)
+{
+    // Return the given string as a JSON string
+
+    QString res = pString;
+
+    res.replace("\\", "\\\\").replace("\"", "\\\"");
+
+    return "\""+res+"\"";
+}
+
+//==============================================================================
+
+bool StartupTrace::exportToChromeTrace() const
+{
+    // Export our spans as complete events of a Chrome trace, which can then be
+    // viewed using chrome://tracing or compared against a previous trace
+
+    QFile file(mFileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+        return false;
+
+    QTextStream out(&file);
+
+    out << "{\"traceEvents\":[";
+
+    for (int i = 0, iMax = mSpans.count(); i < iMax; ++i) {
+        const StartupTraceSpan &span = mSpans[i];
+
+        out << (i?",":"") << "\n"
+            << "{\"name\":" << jsonString(span.name())
+            << ",\"cat\":" << jsonString(span.category().isEmpty()?"OpenCOR":span.category())
+            << ",\"ph\":\"X\",\"ts\":" << span.start()
+            << ",\"dur\":" << span.duration()
+            << ",\"pid\":1,\"tid\":1}";
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    file.close();
+
+    return true;
+}
+
+//==============================================================================
+
+}   // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
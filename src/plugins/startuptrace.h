@@ -0,0 +1,94 @@
+//==============================================================================
+// Startup trace
+//==============================================================================
+
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+//==============================================================================
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+//==============================================================================
+
+namespace OpenCOR {
+
+//==============================================================================
+
+static const QString StartupTraceOption = "startup-trace";
+
+//==============================================================================
+
+class StartupTraceSpan
+{
+public:
+    explicit StartupTraceSpan(const QString &pName, const QString &pCategory,
+                              const qint64 &pStart, const int &pDepth);
+
+    QString name() const;
+    QString category() const;
+
+    qint64 start() const;
+
+    qint64 duration() const;
+    void setDuration(const qint64 &pDuration);
+
+    int depth() const;
+
+private:
+    QString mName;
+    QString mCategory;
+
+    qint64 mStart;
+    qint64 mDuration;
+
+    int mDepth;
+};
+
+//==============================================================================
+
+class StartupTrace
+{
+public:
+    explicit StartupTrace();
+
+    static StartupTrace * instance();
+
+    QStringList enable(const QStringList &pArguments);
+
+    bool isEnabled() const;
+
+    void begin(const QString &pName, const QString &pCategory = QString());
+    void end();
+
+    void finish();
+
+private:
+    bool mEnabled;
+    QString mFileName;
+
+    QElapsedTimer mTimer;
+
+    QList<StartupTraceSpan> mSpans;
+    QList<int> mOpenSpans;
+
+    qint64 elapsed() const;
+
+    void print() const;
+    bool exportToChromeTrace() const;
+};
+
+//==============================================================================
+
+}   // namespace OpenCOR
+
+//==============================================================================
+
+#endif
+
+//==============================================================================
+// End of file
+//==============================================================================
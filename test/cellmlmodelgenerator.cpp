@@ -0,0 +1,720 @@
+//==============================================================================
+// Synthetic CellML model generator
+//==============================================================================
+
+#include "cellmlmodelgenerator.h"
+
+//==============================================================================
+
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QPair>
+#include <QRegExp>
+#include <QSet>
+#include <QtAlgorithms>
+#include <QTextStream>
+
+//==============================================================================
+
+namespace OpenCOR {
+
+//==============================================================================
+
+static const QString MathmlNamespace = "http://www.w3.org/1998/Math/MathML";
+static const QString XlinkNamespace = "http://www.w3.org/1999/xlink";
+
+//==============================================================================
+
+CellmlModelGenerator::CellmlModelGenerator() :
+    mCellmlVersion(Cellml_1_0),
+    mComponentsCount(1),
+    mStatesCount(100),
+    mAlgebraicLoopsCount(0),
+    mPiecewiseExpressionsCount(0),
+    mImportsCount(0),
+    mCouplingDensity(0.0),
+    mSeed(1),
+    mRandomState(1),
+    mErrorMessage(QString()),
+    mNeighbours(QVector<QList<int> >()),
+    mAlgebraicLoops(QVector<bool>()),
+    mPiecewiseExpressions(QVector<bool>()),
+    mImports(QVector<int>())
+{
+}
+
+//==============================================================================
+
+CellmlModelGenerator::CellmlVersion CellmlModelGenerator::cellmlVersion() const
+{
+    // Return the version of CellML to be used
+
+    return mCellmlVersion;
+}
+
+//==============================================================================
+
+void CellmlModelGenerator::setCellmlVersion(const CellmlVersion &pCellmlVersion)
+{
+    // Set the version of CellML to be used
+
+    mCellmlVersion = pCellmlVersion;
+}
+
+//==============================================================================
+
+int CellmlModelGenerator::componentsCount() const
+{
+    // Return the number of components over which our states are to be spread
+
+    return mComponentsCount;
+}
+
+//==============================================================================
+
+void CellmlModelGenerator::setComponentsCount(const int &pComponentsCount)
+{
+    // Set the number of components over which our states are to be spread
+
+    mComponentsCount = pComponentsCount;
+}
+
+//==============================================================================
+
+int CellmlModelGenerator::statesCount() const
+{
+    // Return the number of states
+
+    return mStatesCount;
+}
+
+//==============================================================================
+
+void CellmlModelGenerator::setStatesCount(const int &pStatesCount)
+{
+    // Set the number of states
+
+    mStatesCount = pStatesCount;
+}
+
+//==============================================================================
+
+int CellmlModelGenerator::algebraicLoopsCount() const
+{
+    // Return the number of algebraic loops
+
+    return mAlgebraicLoopsCount;
+}
+
+//==============================================================================
+
+void CellmlModelGenerator::setAlgebraicLoopsCount(const int &pAlgebraicLoopsCount)
+{
+    // Set the number of algebraic loops
+
+    mAlgebraicLoopsCount = pAlgebraicLoopsCount;
+}
+
+//==============================================================================
+
+int CellmlModelGenerator::piecewiseExpressionsCount() const
+{
+    // Return the number of piecewise expressions
+
+    return mPiecewiseExpressionsCount;
+}
+
+//==============================================================================
+
+void CellmlModelGenerator::setPiecewiseExpressionsCount(const int &pPiecewiseExpressionsCount)
+{
+    // Set the number of piecewise expressions
+
+    mPiecewiseExpressionsCount = pPiecewiseExpressionsCount;
+}
+
+//==============================================================================
+
+int CellmlModelGenerator::importsCount() const
+{
+    // Return the number of imports
+
+    return mImportsCount;
+}
+
+//==============================================================================
+
+void CellmlModelGenerator::setImportsCount(const int &pImportsCount)
+{
+    // Set the number of imports
+
+    mImportsCount = pImportsCount;
+}
+
+//==============================================================================
+
+double CellmlModelGenerator::couplingDensity() const
+{
+    // Return the density of the coupling between our states
+
+    return mCouplingDensity;
+}
+
+//==============================================================================
+
+void CellmlModelGenerator::setCouplingDensity(const double &pCouplingDensity)
+{
+    // Set the density of the coupling between our states, i.e. the probability
+    // for two states that are not next to one another to be coupled
+
+    mCouplingDensity = pCouplingDensity;
+}
+
+//==============================================================================
+
+quint64 CellmlModelGenerator::seed() const
+{
+    // Return the seed used to generate the coupling between our states
+
+    return mSeed;
+}
+
+//==============================================================================
+
+void CellmlModelGenerator::setSeed(const quint64 &pSeed)
+{
+    // Set the seed used to generate the coupling between our states
+
+    mSeed = pSeed;
+}
+
+//==============================================================================
+
+QString CellmlModelGenerator::errorMessage() const
+{
+    // Return the reason why our last generation failed, if any
+
+    return mErrorMessage;
+}
+
+//==============================================================================
+
+bool CellmlModelGenerator::settingsOk()
+{
+    // Check that our settings make sense
+
+    if (mStatesCount < 1)
+        mErrorMessage = "there must be at least one state";
+    else if ((mComponentsCount < 1) || (mComponentsCount > mStatesCount))
+        mErrorMessage = "there must be between one component and as many components as there are states";
+    else if ((mAlgebraicLoopsCount < 0) || (mAlgebraicLoopsCount > mStatesCount))
+        mErrorMessage = "there cannot be more algebraic loops than there are states";
+    else if ((mPiecewiseExpressionsCount < 0) || (mPiecewiseExpressionsCount > mStatesCount))
+        mErrorMessage = "there cannot be more piecewise expressions than there are states";
+    else if ((mImportsCount < 0) || (mImportsCount > mStatesCount))
+        mErrorMessage = "there cannot be more imports than there are states";
+    else if (mImportsCount && (mCellmlVersion == Cellml_1_0))
+        mErrorMessage = "imports require CellML 1.1";
+    else if ((mCouplingDensity < 0.0) || (mCouplingDensity > 1.0))
+        mErrorMessage = "the coupling density must be between 0 and 1";
+    else
+        mErrorMessage = QString();
+
+    return mErrorMessage.isEmpty();
+}
+
+//==============================================================================
+
+double CellmlModelGenerator::random()
+{
+    // Return a pseudo-random number in [0; 1)
+    // Note: we use our own linear congruential generator (rather than qrand())
+    //       so that a given seed results in the same model on all our
+    //       supported platforms...
+
+    mRandomState = 6364136223846793005ULL*mRandomState+1442695040888963407ULL;
+
+    return double(mRandomState >> 11)/double(1ULL << 53);
+}
+
+//==============================================================================
+
+static QVector<int> spreadStates(const int &pStatesCount, const int &pCount)
+{
+    // Return pCount states that are evenly spread over our pStatesCount states
+
+    QVector<int> res = QVector<int>();
+
+    for (int i = 0; i < pCount; ++i)
+        res << int(qint64(i)*pStatesCount/pCount);
+
+    return res;
+}
+
+//==============================================================================
+
+void CellmlModelGenerator::initialize()
+{
+    // Couple each state with its neighbours in the chain and, depending on our
+    // coupling density, with some other states
+    // Note: the coupling is symmetric and, since the diffusion term of a state
+    //       uses the mean of the states to which it is coupled, the model
+    //       remains stable whatever the coupling density...
+
+    mRandomState = mSeed;
+
+    mNeighbours = QVector<QList<int> >(mStatesCount);
+
+    for (int i = 0; i < mStatesCount; ++i) {
+        if (i)
+            mNeighbours[i] << i-1;
+
+        if (i < mStatesCount-1)
+            mNeighbours[i] << i+1;
+    }
+
+    if (mCouplingDensity > 0.0)
+        for (int i = 0; i < mStatesCount; ++i)
+            for (int j = i+2; j < mStatesCount; ++j)
+                if (random() < mCouplingDensity) {
+                    mNeighbours[i] << j;
+                    mNeighbours[j] << i;
+                }
+
+    // Determine the states whose growth involves an algebraic loop, a
+    // piecewise expression and/or an imported component
+
+    mAlgebraicLoops = QVector<bool>(mStatesCount, false);
+    mPiecewiseExpressions = QVector<bool>(mStatesCount, false);
+    mImports = QVector<int>(mStatesCount, -1);
+
+    foreach (const int &state, spreadStates(mStatesCount, mAlgebraicLoopsCount))
+        mAlgebraicLoops[state] = true;
+
+    foreach (const int &state, spreadStates(mStatesCount, mPiecewiseExpressionsCount))
+        mPiecewiseExpressions[state] = true;
+
+    QVector<int> importStates = spreadStates(mStatesCount, mImportsCount);
+
+    for (int i = 0, iMax = importStates.count(); i < iMax; ++i)
+        mImports[importStates[i]] = i;
+}
+
+//==============================================================================
+
+int CellmlModelGenerator::owner(const int &pState) const
+{
+    // Return the component that owns the given state, i.e. our states are
+    // spread over our components in contiguous blocks
+
+    return int(qint64(pState)*mComponentsCount/mStatesCount);
+}
+
+//==============================================================================
+
+QString CellmlModelGenerator::cellmlNamespace() const
+{
+    // Return the namespace of the version of CellML to be used
+
+    return (mCellmlVersion == Cellml_1_0)?
+               "http://www.cellml.org/cellml/1.0#":
+               "http://www.cellml.org/cellml/1.1#";
+}
+
+//==============================================================================
+
+static QString growthExpression(const QString &pVariable,
+                                const bool &pPiecewise, const QString &pIndent)
+{
+    // Return the logistic growth of the given variable, i.e. r*x*(1-x), either
+    // as is or as a piecewise expression that is zero past the carrying
+    // capacity (and therefore continuous)
+
+    QString res = QString();
+    QTextStream out(&res);
+    QString indent = pIndent;
+
+    if (pPiecewise) {
+        out << indent << "<piecewise>\n"
+            << indent << "    <piece>\n";
+
+        indent += "        ";
+    }
+
+    out << indent << "<apply><times/>\n"
+        << indent << "    <ci>r</ci>\n"
+        << indent << "    <ci>" << pVariable << "</ci>\n"
+        << indent << "    <apply><minus/><cn cellml:units=\"dimensionless\">1</cn><ci>" << pVariable << "</ci></apply>\n"
+        << indent << "</apply>\n";
+
+    if (pPiecewise)
+        out << indent << "<apply><lt/><ci>" << pVariable << "</ci><cn cellml:units=\"dimensionless\">1</cn></apply>\n"
+            << pIndent << "    </piece>\n"
+            << pIndent << "    <otherwise><cn cellml:units=\"dimensionless\">0</cn></otherwise>\n"
+            << pIndent << "</piecewise>\n";
+
+    out.flush();
+
+    return res;
+}
+
+//==============================================================================
+
+QString CellmlModelGenerator::growth(const int &pState,
+                                     const QString &pIndent) const
+{
+    // Return the growth of the given state, which is either computed locally
+    // or by the component that we import for it
+
+    if (mImports[pState] != -1)
+        return pIndent+QString("<ci>g_%1</ci>\n").arg(pState);
+    else
+        return growthExpression(QString("x_%1").arg(pState),
+                                mPiecewiseExpressions[pState], pIndent);
+}
+
+//==============================================================================
+
+QString CellmlModelGenerator::rate(const int &pState,
+                                   const QString &pIndent) const
+{
+    // Return the equations for the given state, i.e.
+    //     d(x_i)/dt = D*(mean(x_j)-x_i)+growth(x_i)
+    // where the x_j's are the states to which x_i is coupled
+    // Note: if the growth of x_i involves an algebraic loop, then it is
+    //       computed through
+    //           a_i+b_i = x_i
+    //           a_i-b_i = growth(x_i)
+    //       i.e. growth(x_i) = 2*a_i-x_i, which our code generator cannot
+    //       rearrange and which therefore requires an NLA solver...
+
+    QString res = QString();
+    QTextStream out(&res);
+    QString state = QString("x_%1").arg(pState);
+    QList<int> neighbours = mNeighbours[pState];
+
+    if (mAlgebraicLoops[pState])
+        out << pIndent << "<apply><eq/>\n"
+            << pIndent << "    <apply><plus/><ci>a_" << pState << "</ci><ci>b_" << pState << "</ci></apply>\n"
+            << pIndent << "    <ci>" << state << "</ci>\n"
+            << pIndent << "</apply>\n"
+            << pIndent << "<apply><eq/>\n"
+            << pIndent << "    <apply><minus/><ci>a_" << pState << "</ci><ci>b_" << pState << "</ci></apply>\n"
+            << growth(pState, pIndent+"    ")
+            << pIndent << "</apply>\n";
+
+    out << pIndent << "<apply><eq/>\n"
+        << pIndent << "    <apply><diff/><bvar><ci>time</ci></bvar><ci>" << state << "</ci></apply>\n";
+
+    QString indent = pIndent+"    ";
+
+    if (!neighbours.isEmpty()) {
+        out << indent << "<apply><plus/>\n"
+            << indent << "    <apply><times/>\n"
+            << indent << "        <ci>D</ci>\n"
+            << indent << "        <apply><minus/>\n"
+            << indent << "            <apply><divide/>\n";
+
+        if (neighbours.count() == 1) {
+            out << indent << "                <ci>x_" << neighbours.first() << "</ci>\n";
+        } else {
+            out << indent << "                <apply><plus/>";
+
+            foreach (const int &neighbour, neighbours)
+                out << "<ci>x_" << neighbour << "</ci>";
+
+            out << "</apply>\n";
+        }
+
+        out << indent << "                <cn cellml:units=\"dimensionless\">" << neighbours.count() << "</cn>\n"
+            << indent << "            </apply>\n"
+            << indent << "            <ci>" << state << "</ci>\n"
+            << indent << "        </apply>\n"
+            << indent << "    </apply>\n";
+
+        indent += "    ";
+    }
+
+    if (mAlgebraicLoops[pState])
+        out << indent << "<apply><minus/>\n"
+            << indent << "    <apply><times/><cn cellml:units=\"dimensionless\">2</cn><ci>a_" << pState << "</ci></apply>\n"
+            << indent << "    <ci>" << state << "</ci>\n"
+            << indent << "</apply>\n";
+    else
+        out << growth(pState, indent);
+
+    if (!neighbours.isEmpty())
+        out << pIndent << "    </apply>\n";
+
+    out << pIndent << "</apply>\n";
+
+    out.flush();
+
+    return res;
+}
+
+//==============================================================================
+
+static void addMapping(QMap<QPair<QString, QString>, QStringList> &pConnections,
+                       const QString &pComponent1, const QString &pVariable1,
+                       const QString &pComponent2, const QString &pVariable2)
+{
+    // Add a mapping between two variables to the connection between their
+    // components
+    // Note: CellML only allows one connection between two given components,
+    //       hence we group all the mappings between two components...
+
+    if (pComponent1 < pComponent2)
+        pConnections[qMakePair(pComponent1, pComponent2)] << QString("<map_variables variable_1=\"%1\" variable_2=\"%2\"/>").arg(pVariable1, pVariable2);
+    else
+        pConnections[qMakePair(pComponent2, pComponent1)] << QString("<map_variables variable_1=\"%1\" variable_2=\"%2\"/>").arg(pVariable2, pVariable1);
+}
+
+//==============================================================================
+
+QString CellmlModelGenerator::mainModel(const QString &pModelName,
+                                        const QStringList &pImportFileNames) const
+{
+    // Return our main model, which consists of an environment component, which
+    // holds the variable of integration and our parameters, and of our
+    // components, each of which owns a contiguous block of states
+
+    QString res = QString();
+    QTextStream out(&res);
+    QString cellmlNamespace = this->cellmlNamespace();
+
+    out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        << "<model name=\"" << pModelName << "\" xmlns=\"" << cellmlNamespace << "\" xmlns:cellml=\"" << cellmlNamespace << "\"";
+
+    if (mImportsCount)
+        out << " xmlns:xlink=\"" << XlinkNamespace << "\"";
+
+    out << ">\n";
+
+    // Our imports, each of which computes the growth of a given state
+
+    for (int i = 0; i < mImportsCount; ++i)
+        out << "    <import xlink:href=\"" << pImportFileNames[i] << "\">\n"
+            << "        <component name=\"growth_" << i << "\" component_ref=\"growth\"/>\n"
+            << "    </import>\n";
+
+    // Our environment component
+
+    out << "    <component name=\"environment\">\n"
+        << "        <variable name=\"time\" units=\"dimensionless\" public_interface=\"out\"/>\n"
+        << "        <variable name=\"D\" units=\"dimensionless\" initial_value=\"1\" public_interface=\"out\"/>\n"
+        << "        <variable name=\"r\" units=\"dimensionless\" initial_value=\"1\" public_interface=\"out\"/>\n"
+        << "    </component>\n";
+
+    // Determine the states that each component owns as well as those that it
+    // needs from other components, and the resulting connections
+
+    QVector<QList<int> > ownedStates(mComponentsCount);
+    QVector<QSet<int> > foreignStates(mComponentsCount);
+    QMap<QPair<QString, QString>, QStringList> connections = QMap<QPair<QString, QString>, QStringList>();
+
+    for (int i = 0; i < mStatesCount; ++i) {
+        int component = owner(i);
+
+        ownedStates[component] << i;
+
+        foreach (const int &neighbour, mNeighbours[i])
+            if (owner(neighbour) != component)
+                foreignStates[component] << neighbour;
+    }
+
+    for (int i = 0; i < mComponentsCount; ++i) {
+        QString component = QString("component_%1").arg(i);
+
+        addMapping(connections, "environment", "time", component, "time");
+        addMapping(connections, "environment", "D", component, "D");
+        addMapping(connections, "environment", "r", component, "r");
+
+        QList<int> states = foreignStates[i].toList();
+
+        qSort(states);
+
+        foreach (const int &state, states)
+            addMapping(connections, QString("component_%1").arg(owner(state)), QString("x_%1").arg(state),
+                       component, QString("x_%1").arg(state));
+    }
+
+    for (int i = 0; i < mStatesCount; ++i)
+        if (mImports[i] != -1) {
+            QString import = QString("growth_%1").arg(mImports[i]);
+            QString component = QString("component_%1").arg(owner(i));
+
+            addMapping(connections, "environment", "r", import, "r");
+            addMapping(connections, component, QString("x_%1").arg(i), import, "x");
+            addMapping(connections, component, QString("g_%1").arg(i), import, "g");
+        }
+
+    // Our components
+
+    for (int i = 0; i < mComponentsCount; ++i) {
+        out << "    <component name=\"component_" << i << "\">\n"
+            << "        <variable name=\"time\" units=\"dimensionless\" public_interface=\"in\"/>\n"
+            << "        <variable name=\"D\" units=\"dimensionless\" public_interface=\"in\"/>\n"
+            << "        <variable name=\"r\" units=\"dimensionless\" public_interface=\"in\"/>\n";
+
+        foreach (const int &state, ownedStates[i]) {
+            out << "        <variable name=\"x_" << state << "\" units=\"dimensionless\" initial_value=\"" << (state?0:1) << "\" public_interface=\"out\"/>\n";
+
+            if (mImports[state] != -1)
+                out << "        <variable name=\"g_" << state << "\" units=\"dimensionless\" public_interface=\"in\"/>\n";
+
+            if (mAlgebraicLoops[state])
+                out << "        <variable name=\"a_" << state << "\" units=\"dimensionless\"/>\n"
+                    << "        <variable name=\"b_" << state << "\" units=\"dimensionless\"/>\n";
+        }
+
+        QList<int> states = foreignStates[i].toList();
+
+        qSort(states);
+
+        foreach (const int &state, states)
+            out << "        <variable name=\"x_" << state << "\" units=\"dimensionless\" public_interface=\"in\"/>\n";
+
+        out << "        <math xmlns=\"" << MathmlNamespace << "\">\n";
+
+        foreach (const int &state, ownedStates[i])
+            out << rate(state, "            ");
+
+        out << "        </math>\n"
+            << "    </component>\n";
+    }
+
+    // Our connections
+
+    QMap<QPair<QString, QString>, QStringList>::const_iterator iter = connections.constBegin();
+
+    while (iter != connections.constEnd()) {
+        out << "    <connection>\n"
+            << "        <map_components component_1=\"" << iter.key().first << "\" component_2=\"" << iter.key().second << "\"/>\n";
+
+        foreach (const QString &mapping, iter.value())
+            out << "        " << mapping << "\n";
+
+        out << "    </connection>\n";
+
+        ++iter;
+    }
+
+    out << "</model>\n";
+
+    out.flush();
+
+    return res;
+}
+
+//==============================================================================
+
+QString CellmlModelGenerator::importedModel(const QString &pModelName,
+                                            const int &pState) const
+{
+    // Return a model which component computes the growth of the given state
+
+    QString res = QString();
+    QTextStream out(&res);
+    QString cellmlNamespace = this->cellmlNamespace();
+
+    out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        << "<model name=\"" << pModelName << "\" xmlns=\"" << cellmlNamespace << "\" xmlns:cellml=\"" << cellmlNamespace << "\">\n"
+        << "    <component name=\"growth\">\n"
+        << "        <variable name=\"x\" units=\"dimensionless\" public_interface=\"in\"/>\n"
+        << "        <variable name=\"r\" units=\"dimensionless\" public_interface=\"in\"/>\n"
+        << "        <variable name=\"g\" units=\"dimensionless\" public_interface=\"out\"/>\n"
+        << "        <math xmlns=\"" << MathmlNamespace << "\">\n"
+        << "            <apply><eq/>\n"
+        << "                <ci>g</ci>\n"
+        << growthExpression("x", mPiecewiseExpressions[pState], "                ")
+        << "            </apply>\n"
+        << "        </math>\n"
+        << "    </component>\n"
+        << "</model>\n";
+
+    out.flush();
+
+    return res;
+}
+
+//==============================================================================
+
+bool CellmlModelGenerator::writeFile(const QString &pFileName,
+                                     const QString &pContents)
+{
+    // Write the given contents to the given file
+
+    QFile file(pFileName);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        mErrorMessage = QString("%1 could not be created").arg(pFileName);
+
+        return false;
+    }
+
+    bool res = file.write(pContents.toUtf8()) != -1;
+
+    file.close();
+
+    if (!res)
+        mErrorMessage = QString("%1 could not be written").arg(pFileName);
+
+    return res;
+}
+
+//==============================================================================
+
+static QString cellmlIdentifier(const QString &pName)
+{
+    // Return a valid CellML identifier based on the given name
+
+    QString res = pName;
+
+    res.replace(QRegExp("[^A-Za-z0-9_]"), "_");
+
+    if (res.isEmpty() || res[0].isDigit())
+        res.prepend("_");
+
+    return res;
+}
+
+//==============================================================================
+
+bool CellmlModelGenerator::generate(const QString &pFileName)
+{
+    // Generate a model, as well as the models it imports (next to it), using
+    // our current settings
+
+    if (!settingsOk())
+        return false;
+
+    initialize();
+
+    QFileInfo fileInfo(pFileName);
+    QString modelName = cellmlIdentifier(fileInfo.completeBaseName());
+    QStringList importFileNames = QStringList();
+
+    for (int i = 0; i < mImportsCount; ++i)
+        importFileNames << QString("%1_growth_%2.cellml").arg(fileInfo.completeBaseName()).arg(i);
+
+    for (int i = 0; i < mStatesCount; ++i)
+        if (mImports[i] != -1) {
+            int import = mImports[i];
+
+            if (!writeFile(fileInfo.absolutePath()+"/"+importFileNames[import],
+                           importedModel(QString("%1_growth_%2").arg(modelName).arg(import), i)))
+                return false;
+        }
+
+    return writeFile(pFileName, mainModel(modelName, importFileNames));
+}
+
+//==============================================================================
+
+}   // namespace OpenCOR
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -0,0 +1,111 @@
+//==============================================================================
+// Synthetic CellML model generator
+//==============================================================================
+
+#ifndef CELLMLMODELGENERATOR_H
+#define CELLMLMODELGENERATOR_H
+
+//==============================================================================
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+//==============================================================================
+
+namespace OpenCOR {
+
+//==============================================================================
+
+class CellmlModelGenerator
+{
+public:
+    enum CellmlVersion {
+        Cellml_1_0,
+        Cellml_1_1
+    };
+
+    explicit CellmlModelGenerator();
+
+    CellmlVersion cellmlVersion() const;
+    void setCellmlVersion(const CellmlVersion &pCellmlVersion);
+
+    int componentsCount() const;
+    void setComponentsCount(const int &pComponentsCount);
+
+    int statesCount() const;
+    void setStatesCount(const int &pStatesCount);
+
+    int algebraicLoopsCount() const;
+    void setAlgebraicLoopsCount(const int &pAlgebraicLoopsCount);
+
+    int piecewiseExpressionsCount() const;
+    void setPiecewiseExpressionsCount(const int &pPiecewiseExpressionsCount);
+
+    int importsCount() const;
+    void setImportsCount(const int &pImportsCount);
+
+    double couplingDensity() const;
+    void setCouplingDensity(const double &pCouplingDensity);
+
+    quint64 seed() const;
+    void setSeed(const quint64 &pSeed);
+
+    QString errorMessage() const;
+
+    bool generate(const QString &pFileName);
+
+private:
+    CellmlVersion mCellmlVersion;
+
+    int mComponentsCount;
+    int mStatesCount;
+    int mAlgebraicLoopsCount;
+    int mPiecewiseExpressionsCount;
+    int mImportsCount;
+
+    double mCouplingDensity;
+
+    quint64 mSeed;
+    quint64 mRandomState;
+
+    QString mErrorMessage;
+
+    QVector<QList<int> > mNeighbours;
+
+    QVector<bool> mAlgebraicLoops;
+    QVector<bool> mPiecewiseExpressions;
+    QVector<int> mImports;
+
+    bool settingsOk();
+
+    double random();
+
+    void initialize();
+
+    int owner(const int &pState) const;
+
+    QString cellmlNamespace() const;
+
+    QString growth(const int &pState, const QString &pIndent) const;
+    QString rate(const int &pState, const QString &pIndent) const;
+
+    QString mainModel(const QString &pModelName,
+                      const QStringList &pImportFileNames) const;
+    QString importedModel(const QString &pModelName, const int &pState) const;
+
+    bool writeFile(const QString &pFileName, const QString &pContents);
+};
+
+//==============================================================================
+
+}   // namespace OpenCOR
+
+//==============================================================================
+
+#endif
+
+//==============================================================================
+// End of file
+//==============================================================================
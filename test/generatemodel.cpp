@@ -0,0 +1,117 @@
+//==============================================================================
+// Synthetic CellML model generator tool
+//==============================================================================
+
+#include "cellmlmodelgenerator.h"
+
+//==============================================================================
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+
+//==============================================================================
+
+#include <iostream>
+
+//==============================================================================
+
+static void usage(const QString &pAppName)
+{
+    // Output the usage of our tool
+
+    std::cout << "Usage: " << qPrintable(pAppName) << " [OPTION]... FILE" << std::endl;
+    std::cout << "Generate a synthetic CellML model (and the models it imports, if any) in FILE." << std::endl;
+    std::cout << std::endl;
+    std::cout << " --cellml=VERSION       version of CellML to use (1.0 or 1.1; default: 1.0)" << std::endl;
+    std::cout << " --components=N         number of components (default: 1)" << std::endl;
+    std::cout << " --states=N             number of states (default: 100)" << std::endl;
+    std::cout << " --loops=N              number of algebraic loops (default: 0)" << std::endl;
+    std::cout << " --piecewise=N          number of piecewise expressions (default: 0)" << std::endl;
+    std::cout << " --imports=N            number of imports, which require CellML 1.1 (default: 0)" << std::endl;
+    std::cout << " --density=D            probability for two non-adjacent states to be coupled (default: 0)" << std::endl;
+    std::cout << " --seed=S               seed used to generate the coupling (default: 1)" << std::endl;
+}
+
+//==============================================================================
+
+int main(int pArgc, char *pArgv[])
+{
+    // Retrieve the different arguments that were passed
+
+    QCoreApplication app(pArgc, pArgv);
+
+    QString appName = QFileInfo(app.applicationFilePath()).fileName();
+    QStringList args = app.arguments();
+    OpenCOR::CellmlModelGenerator generator;
+    QString fileName = QString();
+
+    args.removeFirst();
+
+    foreach (const QString &arg, args) {
+        if (arg.startsWith("--")) {
+            int separatorPos = arg.indexOf('=');
+            QString option = arg.mid(2, separatorPos-2);
+            QString value = (separatorPos == -1)?QString():arg.mid(separatorPos+1);
+            bool ok = separatorPos != -1;
+
+            if (!option.compare("cellml")) {
+                if (!value.compare("1.0"))
+                    generator.setCellmlVersion(OpenCOR::CellmlModelGenerator::Cellml_1_0);
+                else if (!value.compare("1.1"))
+                    generator.setCellmlVersion(OpenCOR::CellmlModelGenerator::Cellml_1_1);
+                else
+                    ok = false;
+            } else if (!option.compare("components")) {
+                generator.setComponentsCount(value.toInt(&ok));
+            } else if (!option.compare("states")) {
+                generator.setStatesCount(value.toInt(&ok));
+            } else if (!option.compare("loops")) {
+                generator.setAlgebraicLoopsCount(value.toInt(&ok));
+            } else if (!option.compare("piecewise")) {
+                generator.setPiecewiseExpressionsCount(value.toInt(&ok));
+            } else if (!option.compare("imports")) {
+                generator.setImportsCount(value.toInt(&ok));
+            } else if (!option.compare("density")) {
+                generator.setCouplingDensity(value.toDouble(&ok));
+            } else if (!option.compare("seed")) {
+                generator.setSeed(value.toULongLong(&ok));
+            } else {
+                ok = false;
+            }
+
+            if (!ok) {
+                usage(appName);
+
+                return 1;
+            }
+        } else if (fileName.isEmpty()) {
+            fileName = arg;
+        } else {
+            usage(appName);
+
+            return 1;
+        }
+    }
+
+    if (fileName.isEmpty()) {
+        usage(appName);
+
+        return 1;
+    }
+
+    // Generate our model
+
+    if (!generator.generate(fileName)) {
+        std::cout << qPrintable(appName) << ": " << qPrintable(generator.errorMessage()) << "." << std::endl;
+
+        return 1;
+    }
+
+    return 0;
+}
+
+//==============================================================================
+// End of file
+//==============================================================================
@@ -32,6 +32,7 @@ int main(int pArgc, char *pArgv[])
     Tests tests;
 
     tests["Compiler"] = QStringList() << "test";
+    tests["SingleCellSimulationView"] = QStringList() << "test";
 
     // Run the different tests
 